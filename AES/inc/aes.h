@@ -1,6 +1,9 @@
 #ifndef AES_H
 #define AES_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -11,6 +14,71 @@ extern "C"
 #define AES_KEY_SIZE 16    /* bytes of AES algoithm double key */
 #define AES_EXPANDED_KEY_SIZE 176 /* bytes of expanded AES key for 128-bit key */
 #define AES_EXPANDED_KEY_BLOCK 11 /* blocks of expanded AES key for 128-bit key */
+#define AES_ROUNDS 10 /* rounds of AES algoithm for 128-bit key */
+#define AES_192_KEY_SIZE 24 /* bytes of AES-192 key */
+#define AES_256_KEY_SIZE 32 /* bytes of AES-256 key */
+#define AES_MAX_ROUNDS 14 /* rounds of AES algoithm for 256-bit key */
+
+    /**
+     * @brief AES key schedule for 128/192/256-bit keys, round keys packed as native 32-bit column words
+     * rk[4 * r + c] is column c of round key r, byte 0 of the column in the
+     * most significant bits (the layout the T-tables index)
+     */
+    typedef struct {
+        uint32_t rk[4 * (AES_MAX_ROUNDS + 1)];
+        unsigned char rkb[AES_MAX_ROUNDS + 1][AES_BLOCK_SIZE]; /* the same round keys in byte order, for AES-NI */
+        int rounds; /* 10, 12 or 14 */
+    } aes_key_schedule;
+
+    /**
+     * @brief Block cipher implementation behind aes_encrypt_block / aes_decrypt_block
+     */
+    typedef enum {
+        AES_IMPL_AUTO,      /* AES-NI when the CPU supports it, otherwise T-table */
+        AES_IMPL_TABLE,     /* T-table C code */
+        AES_IMPL_AESNI,     /* AES-NI instructions */
+        AES_IMPL_BITSLICE,  /* bitsliced C code, constant time, select explicitly */
+        AES_IMPL_REFERENCE, /* byte-oriented FIPS-197 steps, for cross-checking */
+        AES_IMPL_COUNT      /* number of entries, not an implementation */
+    } aes_impl;
+
+    /**
+     * @brief Check the CPU for AES-NI (CPUID)
+     * @return 1 supported
+     * @return 0 not supported
+     */
+    int aes_has_aesni(void);
+
+    /**
+     * @brief Select the implementation used by all AES entry points
+     * Without a call, AES_IMPL_AUTO is selected on first use, which is safe from several threads.
+     * Switching implementations while other threads use AES is not supported, call this first
+     * @param[in] impl implementation, AES_IMPL_AUTO picks the fastest supported one
+     * @return 0 OK
+     * @return 1 Failed (not supported by this CPU)
+     */
+    int aes_set_impl(aes_impl impl);
+
+    /**
+     * @brief Check whether an implementation is built in and supported by this CPU
+     * @param[in] impl implementation
+     * @return 1 supported
+     * @return 0 not supported
+     */
+    int aes_impl_supported(aes_impl impl);
+
+    /**
+     * @brief Name of an implementation, e.g. for benchmark output
+     * @param[in] impl implementation
+     * @return name
+     */
+    const char *aes_impl_name(aes_impl impl);
+
+    /**
+     * @brief Get the implementation in use (never AES_IMPL_AUTO)
+     * @return implementation
+     */
+    aes_impl aes_get_impl(void);
 
     /**
      * @brief Generate encryption subkeys
@@ -46,215 +114,125 @@ extern "C"
      */
     void aes_decrypt_block(const unsigned char *input, unsigned char subKeys[11][16], unsigned char *output);
 
-#ifdef __cplusplus
-}
-#endif
-
-#endif // AES_H
-
-#include <stdint.h>
-#include <string.h>
-#include "table.h"
-
-// 定义一个联合体，用于按不同的方式访问数据
-typedef union {
-    uint64_t d;    // 按 64 位访问数据
-    uint8_t b[8];  // 按字节访问数据
-} uni;
-
-
-// 轮常量
-static const uint8_t RCON[11] = {
-    0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
-};
-
-// 列混淆矩阵
-static const uint8_t MIX_COLUMNS[4][4] = {
-    {0x02, 0x03, 0x01, 0x01},
-    {0x01, 0x02, 0x03, 0x01},
-    {0x01, 0x01, 0x02, 0x03},
-    {0x03, 0x01, 0x01, 0x02}
-};
-
-// 逆列混淆矩阵
-static const uint8_t INV_MIX_COLUMNS[4][4] = {
-    {0x0e, 0x0b, 0x0d, 0x09},
-    {0x09, 0x0e, 0x0b, 0x0d},
-    {0x0d, 0x09, 0x0e, 0x0b},
-    {0x0b, 0x0d, 0x09, 0x0e}
-};
-
-// 将列表示形式的 state 转换回行表示形式
-static void convert_to_row_representation(unsigned int state[4], unsigned char output[4][4]) {
-    int i, j;
-
-    for (i = 0; i < 4; i++) {
-        output[0][i] = (state[i] >> 24) & 0xFF;
-        output[1][i] = (state[i] >> 16) & 0xFF;
-        output[2][i] = (state[i] >> 8) & 0xFF;  
-        output[3][i] = state[i] & 0xFF;         
-    }
-}
-static void convert_to_column_representation(unsigned char input[4][4], unsigned int state[4]) {
-    int i, j;
-
-    for (i = 0; i < 4; i++) {
-        state[i] = ((unsigned int)input[0][i] << 24) | 
-                   ((unsigned int)input[1][i] << 16) |
-                   ((unsigned int)input[2][i] << 8)  | 
-                   ((unsigned int)input[3][i]);  
-    }
-}
-
-
-static void add_round_key(uint64_t *state, const uint64_t *roundKey)
-{
-    state[0] ^= roundKey[0];
-    state[1] ^= roundKey[1];
-}
+    /**
+     * @brief Generate encryption key schedule
+     * @param[in] key original key, [length = key_len]
+     * @param[in] key_len AES_KEY_SIZE, AES_192_KEY_SIZE or AES_256_KEY_SIZE
+     * @param[out] ks generated key schedule
+     * @return 0 OK
+     * @return 1 Failed (unsupported key length)
+     */
+    int aes_make_enc_key_schedule(const unsigned char *key, size_t key_len, aes_key_schedule *ks);
 
-static void sub_bytes(unsigned char state[4][4]) {
-    int i, j;
-    for (i = 0; i < 4; i++) {
-        for (j = 0; j < 4; j++) {
-            state[i][j] = S_BOX[state[i][j]];
-        }
-    }
-}
+    /**
+     * @brief Generate decryption key schedule (InvMixColumns applied to the inner round keys)
+     * @param[in] key original key, [length = key_len]
+     * @param[in] key_len AES_KEY_SIZE, AES_192_KEY_SIZE or AES_256_KEY_SIZE
+     * @param[out] ks generated key schedule
+     * @return 0 OK
+     * @return 1 Failed (unsupported key length)
+     */
+    int aes_make_dec_key_schedule(const unsigned char *key, size_t key_len, aes_key_schedule *ks);
 
-static void inv_sub_bytes(unsigned char state[4][4]) {
-    int i, j;
-    for (i = 0; i < 4; i++) {
-        for (j = 0; j < 4; j++) {
-            state[i][j] = INV_S_BOX[state[i][j]];
-        }
-    }
-}
+    /**
+     * @brief Derive the decryption key schedule from an encryption key schedule, no second key expansion
+     * @param[in] enc encryption key schedule
+     * @param[out] dec decryption key schedule, may equal enc
+     * @return 0 OK
+     * @return 1 Failed (enc is not a valid key schedule)
+     */
+    int aes_make_dec_key_schedule_from_enc(const aes_key_schedule *enc, aes_key_schedule *dec);
 
-static void shift_rows(unsigned char state[4][4]) {
-    // 移位方法1
-    unsigned char temp[4];
+    /**
+     * @brief Cached key schedules of one key, e.g. one per flow when every flow has its own key
+     * The encryption schedule is expanded once; the decryption schedule is derived from it
+     * on first use. aes_key_handle_rekey only expands when the key actually changes.
+     */
+    typedef struct {
+        aes_key_schedule enc;
+        aes_key_schedule dec;
+        unsigned char key[AES_256_KEY_SIZE];
+        size_t key_len;
+        int has_dec; /* dec is valid */
+    } aes_key_handle;
 
-    for(int i = 0; i < 4; ++i) {
-        temp[0] = state[0][i];
-        temp[1] = state[1][i];
-        temp[2] = state[2][i];
-        temp[3] = state[3][i];
-        state[0][i] = temp[(i+0) % 4];
-        state[1][i] = temp[(i+1) % 4];
-        state[2][i] = temp[(i+2) % 4];
-        state[3][i] = temp[(i+3) % 4];
-    }
+    /**
+     * @brief Expand a key into a handle
+     * @param[out] h handle
+     * @param[in] key original key, [length = key_len]
+     * @param[in] key_len AES_KEY_SIZE, AES_192_KEY_SIZE or AES_256_KEY_SIZE
+     * @return 0 OK
+     * @return 1 Failed (unsupported key length, the handle is cleared)
+     */
+    int aes_key_handle_init(aes_key_handle *h, const unsigned char *key, size_t key_len);
 
-}
-// 逆行移位函数
-static void inv_shift_rows(unsigned char state[4][4]) {
-    // 逆移位方法1
-    unsigned char temp[4];
+    /**
+     * @brief Switch a handle to a key, free when it already holds that key
+     * @param[in,out] h handle from aes_key_handle_init
+     * @param[in] key original key, [length = key_len]
+     * @param[in] key_len AES_KEY_SIZE, AES_192_KEY_SIZE or AES_256_KEY_SIZE
+     * @return 0 OK
+     * @return 1 Failed (unsupported key length, the handle is cleared)
+     */
+    int aes_key_handle_rekey(aes_key_handle *h, const unsigned char *key, size_t key_len);
 
-    for(int i = 0; i < 4; ++i) {
-        temp[0] = state[0][i];
-        temp[1] = state[1][i];
-        temp[2] = state[2][i];
-        temp[3] = state[3][i];
-        state[0][i] = temp[(4-i) % 4];
-        state[1][i] = temp[(5-i) % 4];
-        state[2][i] = temp[(6-i) % 4];
-        state[3][i] = temp[(7-i) % 4];
-    }
-}
+    /**
+     * @brief Encryption key schedule of a handle
+     * @param[in] h handle
+     * @return encryption key schedule
+     */
+    const aes_key_schedule *aes_key_handle_enc(const aes_key_handle *h);
 
-static void XtimeLong(uint64_t *w)
-{
-    uint64_t a, b;
+    /**
+     * @brief Decryption key schedule of a handle, derived on first use
+     * @param[in,out] h handle
+     * @return decryption key schedule
+     */
+    const aes_key_schedule *aes_key_handle_dec(aes_key_handle *h);
 
-    a = *w;
-    b = a & (uint64_t)(0x8080808080808080);
-    a ^= b;
-    b -= b >> 7;
-    b &= (uint64_t)(0x1B1B1B1B1B1B1B1B);
-    b ^= a << 1;
-    *w = b;
-}
+    /**
+     * @brief Wipe the key and the key schedules
+     * @param[in,out] h handle
+     * @return 0 OK
+     */
+    int aes_key_handle_final(aes_key_handle *h);
 
-// 学习开源代码之后用的列混淆函数
-static void mix_columns(uint64_t *state) {
-    uni s1, s;
-    for (int c = 0; c < 2; c++) {
-        s1.d = state[c];
-        s.d = s1.d;
-        s.d ^= ((s.d & (uint64_t)(0xFFFF0000FFFF0000)) >> 16)
-               | ((s.d & (uint64_t)(0x0000FFFF0000FFFF)) << 16);
-        s.d ^= ((s.d & (uint64_t)(0xFF00FF00FF00FF00)) >> 8)
-               | ((s.d & (uint64_t)(0x00FF00FF00FF00FF)) << 8);
-        s.d ^= s1.d;
-        XtimeLong(&s1.d);
-        s.d ^= s1.d;
-        s.b[0] ^= s1.b[1];
-        s.b[1] ^= s1.b[2];
-        s.b[2] ^= s1.b[3];
-        s.b[3] ^= s1.b[0];
-        s.b[4] ^= s1.b[5];
-        s.b[5] ^= s1.b[6];
-        s.b[6] ^= s1.b[7];
-        s.b[7] ^= s1.b[4];
-        state[c] = s.d;
-    }
-}
+    /**
+     * @brief AES encrypt single block with a prepared key schedule
+     * @param[in] input plaintext, [length = AES_BLOCK_SIZE]
+     * @param[in] ks encryption key schedule
+     * @param[out] output ciphertext, [length = AES_BLOCK_SIZE], may equal input
+     */
+    void aes_encrypt_block_ks(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output);
 
-static void inv_mix_columns(uint64_t *state)
-{
-    uni s1, s;
-    int c;
+    /**
+     * @brief AES decrypt single block with a prepared key schedule
+     * @param[in] input ciphertext, [length = AES_BLOCK_SIZE]
+     * @param[in] ks decryption key schedule
+     * @param[out] output plaintext, [length = AES_BLOCK_SIZE], may equal input
+     */
+    void aes_decrypt_block_ks(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output);
 
-    for (c = 0; c < 2; c++) {
-        s1.d = state[c];
-        s.d = s1.d;
-        s.d ^= ((s.d & (uint64_t)(0xFFFF0000FFFF0000)) >> 16)
-               | ((s.d & (uint64_t)(0x0000FFFF0000FFFF)) << 16);
-        s.d ^= ((s.d & (uint64_t)(0xFF00FF00FF00FF00)) >> 8)
-               | ((s.d & (uint64_t)(0x00FF00FF00FF00FF)) << 8);
-        s.d ^= s1.d;
-        XtimeLong(&s1.d);
-        s.d ^= s1.d;
-        s.b[0] ^= s1.b[1];
-        s.b[1] ^= s1.b[2];
-        s.b[2] ^= s1.b[3];
-        s.b[3] ^= s1.b[0];
-        s.b[4] ^= s1.b[5];
-        s.b[5] ^= s1.b[6];
-        s.b[6] ^= s1.b[7];
-        s.b[7] ^= s1.b[4];
-        XtimeLong(&s1.d);
-        s1.d ^= ((s1.d & (uint64_t)(0xFFFF0000FFFF0000)) >> 16)
-                | ((s1.d & (uint64_t)(0x0000FFFF0000FFFF)) << 16);
-        s.d ^= s1.d;
-        XtimeLong(&s1.d);
-        s1.d ^= ((s1.d & (uint64_t)(0xFF00FF00FF00FF00)) >> 8)
-                | ((s1.d & (uint64_t)(0x00FF00FF00FF00FF)) << 8);
-        s.d ^= s1.d;
-        state[c] = s.d;
-    }
-}
+    /**
+     * @brief AES encrypt independent blocks (ECB) with the active backend's multi-block path
+     * @param[in] input plaintext, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[out] output ciphertext, [length = nblocks * AES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] ks encryption key schedule
+     */
+    void aes_ecb_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks);
 
-static void RotWord(uint32_t *x) {
-    unsigned char *w0;
-    unsigned char tmp;
+    /**
+     * @brief AES decrypt independent blocks (ECB) with the active backend's multi-block path
+     * @param[in] input ciphertext, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[out] output plaintext, [length = nblocks * AES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] ks decryption key schedule
+     */
+    void aes_ecb_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks);
 
-    w0 = (unsigned char *)x;
-    tmp = w0[0];
-    w0[0] = w0[1];
-    w0[1] = w0[2];
-    w0[2] = w0[3];
-    w0[3] = tmp;
+#ifdef __cplusplus
 }
+#endif
 
-static void convert_uint_to_uchar(const unsigned int temp[4], unsigned char temp1[4][4]) {
-    int i, j;
-
-    for (i = 0; i < 4; i++) {
-        for (j = 0; j < 4; j++) {
-            temp1[i][j] = (temp[i] >> (24 - 8 * j)) & 0xFF;
-        }
-    }
-}
+#endif // AES_H
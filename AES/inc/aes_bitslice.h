@@ -0,0 +1,50 @@
+#ifndef AES_BITSLICE_H
+#define AES_BITSLICE_H
+
+#include "aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Bitsliced constant-time backend, round keys in byte order (the aes_make_enc_subkeys layout)
+     * No table lookups and no secret-dependent branches; 4 blocks per 64-bit lane,
+     * 8 blocks per pass with SSE2 and 16 with AVX2, calls of up to 4 blocks use a single scalar lane.
+     * Only the block cipher is constant time: GCM's GHASH still uses the 4-bit Shoup table
+     */
+
+    /**
+     * @brief Bitsliced encrypt independent blocks
+     * @param[in] input plaintext, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[out] output ciphertext, [length = nblocks * AES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] subKeys encryption round keys, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     */
+    void aes_bs_ecb_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds);
+
+    /**
+     * @brief Bitsliced decrypt independent blocks (equivalent inverse cipher)
+     * @param[in] input ciphertext, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[out] output plaintext, [length = nblocks * AES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] subKeys decryption round keys (InvMixColumns applied to the inner rounds), [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     */
+    void aes_bs_ecb_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds);
+
+    /**
+     * @brief Constant-time SubWord for the key expansion
+     * @param[in] w 32-bit word
+     * @return S-box applied to each byte of w
+     */
+    uint32_t aes_bs_sub_word(uint32_t w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_BITSLICE_H
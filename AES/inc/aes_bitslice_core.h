@@ -0,0 +1,293 @@
+/*
+ * 位切片 AES 的核心运算，对切片字类型通用，不单独编译：
+ * aes_bitslice.c 先后以宽向量与单个 uint64_t 作为 AES_BS_WORD 各包含一次，
+ * AES_BS_FN(name) 给两份实例取不同的函数名。故意不加包含保护。
+ */
+
+#if !defined(AES_BS_WORD) || !defined(AES_BS_FN)
+#error "define AES_BS_WORD and AES_BS_FN before including aes_bitslice_core.h"
+#endif
+
+// S 盒电路：q[i] 为字节的第 i 位
+static inline void AES_BS_FN(sbox)(AES_BS_WORD *q) {
+    AES_BS_WORD x0 = q[7], x1 = q[6], x2 = q[5], x3 = q[4];
+    AES_BS_WORD x4 = q[3], x5 = q[2], x6 = q[1], x7 = q[0];
+
+    AES_BS_WORD y14 = x3 ^ x5;
+    AES_BS_WORD y13 = x0 ^ x6;
+    AES_BS_WORD y9 = x0 ^ x3;
+    AES_BS_WORD y8 = x0 ^ x5;
+    AES_BS_WORD t0 = x1 ^ x2;
+    AES_BS_WORD y1 = t0 ^ x7;
+    AES_BS_WORD y4 = y1 ^ x3;
+    AES_BS_WORD y12 = y13 ^ y14;
+    AES_BS_WORD y2 = y1 ^ x0;
+    AES_BS_WORD y5 = y1 ^ x6;
+    AES_BS_WORD y3 = y5 ^ y8;
+    AES_BS_WORD t1 = x4 ^ y12;
+    AES_BS_WORD y15 = t1 ^ x5;
+    AES_BS_WORD y20 = t1 ^ x1;
+    AES_BS_WORD y6 = y15 ^ x7;
+    AES_BS_WORD y10 = y15 ^ t0;
+    AES_BS_WORD y11 = y20 ^ y9;
+    AES_BS_WORD y7 = x7 ^ y11;
+    AES_BS_WORD y17 = y10 ^ y11;
+    AES_BS_WORD y19 = y10 ^ y8;
+    AES_BS_WORD y16 = t0 ^ y11;
+    AES_BS_WORD y21 = y13 ^ y16;
+    AES_BS_WORD y18 = x0 ^ y16;
+    AES_BS_WORD t2 = y12 & y15;
+    AES_BS_WORD t3 = y3 & y6;
+    AES_BS_WORD t4 = t3 ^ t2;
+    AES_BS_WORD t5 = y4 & x7;
+    AES_BS_WORD t6 = t5 ^ t2;
+    AES_BS_WORD t7 = y13 & y16;
+    AES_BS_WORD t8 = y5 & y1;
+    AES_BS_WORD t9 = t8 ^ t7;
+    AES_BS_WORD t10 = y2 & y7;
+    AES_BS_WORD t11 = t10 ^ t7;
+    AES_BS_WORD t12 = y9 & y11;
+    AES_BS_WORD t13 = y14 & y17;
+    AES_BS_WORD t14 = t13 ^ t12;
+    AES_BS_WORD t15 = y8 & y10;
+    AES_BS_WORD t16 = t15 ^ t12;
+    AES_BS_WORD t17 = t4 ^ t14;
+    AES_BS_WORD t18 = t6 ^ t16;
+    AES_BS_WORD t19 = t9 ^ t14;
+    AES_BS_WORD t20 = t11 ^ t16;
+    AES_BS_WORD t21 = t17 ^ y20;
+    AES_BS_WORD t22 = t18 ^ y19;
+    AES_BS_WORD t23 = t19 ^ y21;
+    AES_BS_WORD t24 = t20 ^ y18;
+    AES_BS_WORD t25 = t21 ^ t22;
+    AES_BS_WORD t26 = t21 & t23;
+    AES_BS_WORD t27 = t24 ^ t26;
+    AES_BS_WORD t28 = t25 & t27;
+    AES_BS_WORD t29 = t28 ^ t22;
+    AES_BS_WORD t30 = t23 ^ t24;
+    AES_BS_WORD t31 = t22 ^ t26;
+    AES_BS_WORD t32 = t31 & t30;
+    AES_BS_WORD t33 = t32 ^ t24;
+    AES_BS_WORD t34 = t23 ^ t33;
+    AES_BS_WORD t35 = t27 ^ t33;
+    AES_BS_WORD t36 = t24 & t35;
+    AES_BS_WORD t37 = t36 ^ t34;
+    AES_BS_WORD t38 = t27 ^ t36;
+    AES_BS_WORD t39 = t29 & t38;
+    AES_BS_WORD t40 = t25 ^ t39;
+    AES_BS_WORD t41 = t40 ^ t37;
+    AES_BS_WORD t42 = t29 ^ t33;
+    AES_BS_WORD t43 = t29 ^ t40;
+    AES_BS_WORD t44 = t33 ^ t37;
+    AES_BS_WORD t45 = t42 ^ t41;
+    AES_BS_WORD z0 = t44 & y15;
+    AES_BS_WORD z1 = t37 & y6;
+    AES_BS_WORD z2 = t33 & x7;
+    AES_BS_WORD z3 = t43 & y16;
+    AES_BS_WORD z4 = t40 & y1;
+    AES_BS_WORD z5 = t29 & y7;
+    AES_BS_WORD z6 = t42 & y11;
+    AES_BS_WORD z7 = t45 & y17;
+    AES_BS_WORD z8 = t41 & y10;
+    AES_BS_WORD z9 = t44 & y12;
+    AES_BS_WORD z10 = t37 & y3;
+    AES_BS_WORD z11 = t33 & y4;
+    AES_BS_WORD z12 = t43 & y13;
+    AES_BS_WORD z13 = t40 & y5;
+    AES_BS_WORD z14 = t29 & y2;
+    AES_BS_WORD z15 = t42 & y9;
+    AES_BS_WORD z16 = t45 & y14;
+    AES_BS_WORD z17 = t41 & y8;
+    AES_BS_WORD t46 = z15 ^ z16;
+    AES_BS_WORD t47 = z10 ^ z11;
+    AES_BS_WORD t48 = z5 ^ z13;
+    AES_BS_WORD t49 = z9 ^ z10;
+    AES_BS_WORD t50 = z2 ^ z12;
+    AES_BS_WORD t51 = z2 ^ z5;
+    AES_BS_WORD t52 = z7 ^ z8;
+    AES_BS_WORD t53 = z0 ^ z3;
+    AES_BS_WORD t54 = z6 ^ z7;
+    AES_BS_WORD t55 = z16 ^ z17;
+    AES_BS_WORD t56 = z12 ^ t48;
+    AES_BS_WORD t57 = t50 ^ t53;
+    AES_BS_WORD t58 = z4 ^ t46;
+    AES_BS_WORD t59 = z3 ^ t54;
+    AES_BS_WORD t60 = t46 ^ t57;
+    AES_BS_WORD t61 = z14 ^ t57;
+    AES_BS_WORD t62 = t52 ^ t58;
+    AES_BS_WORD t63 = t49 ^ t58;
+    AES_BS_WORD t64 = z4 ^ t59;
+    AES_BS_WORD t65 = t61 ^ t62;
+    AES_BS_WORD t66 = z1 ^ t63;
+    AES_BS_WORD s0 = t59 ^ t63;
+    AES_BS_WORD s6 = t56 ^ ~t62;
+    AES_BS_WORD s7 = t48 ^ ~t60;
+    AES_BS_WORD t67 = t64 ^ t65;
+    AES_BS_WORD s3 = t53 ^ t66;
+    AES_BS_WORD s4 = t51 ^ t66;
+    AES_BS_WORD s5 = t47 ^ t65;
+    AES_BS_WORD s1 = t64 ^ ~s3;
+    AES_BS_WORD s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+// 逆 S 盒：InvS(y) = T(S(T(y)))，T(y) = A^-1(y ^ 0x63) 为仿射变换的逆
+static inline void AES_BS_FN(inv_affine)(AES_BS_WORD *q) {
+    AES_BS_WORD q0 = ~q[0], q1 = ~q[1], q2 = q[2], q3 = q[3];
+    AES_BS_WORD q4 = q[4], q5 = ~q[5], q6 = ~q[6], q7 = q[7];
+
+    q[7] = q1 ^ q4 ^ q6;
+    q[6] = q0 ^ q3 ^ q5;
+    q[5] = q7 ^ q2 ^ q4;
+    q[4] = q6 ^ q1 ^ q3;
+    q[3] = q5 ^ q0 ^ q2;
+    q[2] = q4 ^ q7 ^ q1;
+    q[1] = q3 ^ q6 ^ q0;
+    q[0] = q2 ^ q5 ^ q7;
+}
+
+static inline void AES_BS_FN(inv_sbox)(AES_BS_WORD *q) {
+    AES_BS_FN(inv_affine)(q);
+    AES_BS_FN(sbox)(q);
+    AES_BS_FN(inv_affine)(q);
+}
+
+// 交换 x 中 cl 选中的位与 y 中 ch 选中的位（相距 s 位）
+#define AES_BS_SWAPN(CL, CH, S, X, Y) {                         \
+    AES_BS_WORD a_ = (X), b_ = (Y);                             \
+    (X) = (a_ & (uint64_t)(CL)) | ((b_ & (uint64_t)(CL)) << (S)); \
+    (Y) = ((a_ & (uint64_t)(CH)) >> (S)) | (b_ & (uint64_t)(CH)); }
+
+#define AES_BS_SWAP2(X, Y) AES_BS_SWAPN(0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 1, X, Y)
+#define AES_BS_SWAP4(X, Y) AES_BS_SWAPN(0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 2, X, Y)
+#define AES_BS_SWAP8(X, Y) AES_BS_SWAPN(0x0F0F0F0F0F0F0F0FULL, 0xF0F0F0F0F0F0F0F0ULL, 4, X, Y)
+
+// 8x8 位矩阵转置，自身是逆变换
+static inline void AES_BS_FN(ortho)(AES_BS_WORD *q) {
+    AES_BS_SWAP2(q[0], q[1]);
+    AES_BS_SWAP2(q[2], q[3]);
+    AES_BS_SWAP2(q[4], q[5]);
+    AES_BS_SWAP2(q[6], q[7]);
+
+    AES_BS_SWAP4(q[0], q[2]);
+    AES_BS_SWAP4(q[1], q[3]);
+    AES_BS_SWAP4(q[4], q[6]);
+    AES_BS_SWAP4(q[5], q[7]);
+
+    AES_BS_SWAP8(q[0], q[4]);
+    AES_BS_SWAP8(q[1], q[5]);
+    AES_BS_SWAP8(q[2], q[6]);
+    AES_BS_SWAP8(q[3], q[7]);
+}
+
+static inline void AES_BS_FN(add_round_key)(AES_BS_WORD *q, const AES_BS_WORD *sk) {
+    for (int i = 0; i < 8; i++) {
+        q[i] ^= sk[i];
+    }
+}
+
+static inline void AES_BS_FN(shift_rows)(AES_BS_WORD *q) {
+    for (int i = 0; i < 8; i++) {
+        AES_BS_WORD x = q[i];
+        q[i] = (x & 0x000000000000FFFFULL)
+             | ((x & 0x00000000FFF00000ULL) >> 4)
+             | ((x & 0x00000000000F0000ULL) << 12)
+             | ((x & 0x0000FF0000000000ULL) >> 8)
+             | ((x & 0x000000FF00000000ULL) << 8)
+             | ((x & 0xF000000000000000ULL) >> 12)
+             | ((x & 0x0FFF000000000000ULL) << 4);
+    }
+}
+
+static inline void AES_BS_FN(inv_shift_rows)(AES_BS_WORD *q) {
+    for (int i = 0; i < 8; i++) {
+        AES_BS_WORD x = q[i];
+        q[i] = (x & 0x000000000000FFFFULL)
+             | ((x & 0x000000000FFF0000ULL) << 4)
+             | ((x & 0x00000000F0000000ULL) >> 12)
+             | ((x & 0x000000FF00000000ULL) << 8)
+             | ((x & 0x0000FF0000000000ULL) >> 8)
+             | ((x & 0x000F000000000000ULL) << 12)
+             | ((x & 0xFFF0000000000000ULL) >> 4);
+    }
+}
+
+static inline AES_BS_WORD AES_BS_FN(rotr32)(AES_BS_WORD x) {
+    return (x << 32) | (x >> 32);
+}
+
+// r = 列内循环移一行（16 位），rotr32 = 移两行；乘 2 即切片下标加一，最高位回绕为 0x1B
+static inline void AES_BS_FN(mix_columns)(AES_BS_WORD *q) {
+    AES_BS_WORD q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3], q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    AES_BS_WORD r0 = (q0 >> 16) | (q0 << 48), r1 = (q1 >> 16) | (q1 << 48);
+    AES_BS_WORD r2 = (q2 >> 16) | (q2 << 48), r3 = (q3 >> 16) | (q3 << 48);
+    AES_BS_WORD r4 = (q4 >> 16) | (q4 << 48), r5 = (q5 >> 16) | (q5 << 48);
+    AES_BS_WORD r6 = (q6 >> 16) | (q6 << 48), r7 = (q7 >> 16) | (q7 << 48);
+
+    q[0] = q7 ^ r7 ^ r0 ^ AES_BS_FN(rotr32)(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ AES_BS_FN(rotr32)(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ AES_BS_FN(rotr32)(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ AES_BS_FN(rotr32)(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ AES_BS_FN(rotr32)(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ AES_BS_FN(rotr32)(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ AES_BS_FN(rotr32)(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ AES_BS_FN(rotr32)(q7 ^ r7);
+}
+
+static inline void AES_BS_FN(inv_mix_columns)(AES_BS_WORD *q) {
+    AES_BS_WORD q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3], q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    AES_BS_WORD r0 = (q0 >> 16) | (q0 << 48), r1 = (q1 >> 16) | (q1 << 48);
+    AES_BS_WORD r2 = (q2 >> 16) | (q2 << 48), r3 = (q3 >> 16) | (q3 << 48);
+    AES_BS_WORD r4 = (q4 >> 16) | (q4 << 48), r5 = (q5 >> 16) | (q5 << 48);
+    AES_BS_WORD r6 = (q6 >> 16) | (q6 << 48), r7 = (q7 >> 16) | (q7 << 48);
+
+    q[0] = q5 ^ q6 ^ q7 ^ r0 ^ r5 ^ r7 ^ AES_BS_FN(rotr32)(q0 ^ q5 ^ q6 ^ r0 ^ r5);
+    q[1] = q0 ^ q5 ^ r0 ^ r1 ^ r5 ^ r6 ^ r7 ^ AES_BS_FN(rotr32)(q1 ^ q5 ^ q7 ^ r1 ^ r5 ^ r6);
+    q[2] = q0 ^ q1 ^ q6 ^ r1 ^ r2 ^ r6 ^ r7 ^ AES_BS_FN(rotr32)(q0 ^ q2 ^ q6 ^ r2 ^ r6 ^ r7);
+    q[3] = q0 ^ q1 ^ q2 ^ q5 ^ q6 ^ r0 ^ r2 ^ r3 ^ r5 ^ AES_BS_FN(rotr32)(q0 ^ q1 ^ q3 ^ q5 ^ q6 ^ q7 ^ r0 ^ r3 ^ r5 ^ r7);
+    q[4] = q1 ^ q2 ^ q3 ^ q5 ^ r1 ^ r3 ^ r4 ^ r5 ^ r6 ^ r7 ^ AES_BS_FN(rotr32)(q1 ^ q2 ^ q4 ^ q5 ^ q7 ^ r1 ^ r4 ^ r5 ^ r6);
+    q[5] = q2 ^ q3 ^ q4 ^ q6 ^ r2 ^ r4 ^ r5 ^ r6 ^ r7 ^ AES_BS_FN(rotr32)(q2 ^ q3 ^ q5 ^ q6 ^ r2 ^ r5 ^ r6 ^ r7);
+    q[6] = q3 ^ q4 ^ q5 ^ q7 ^ r3 ^ r5 ^ r6 ^ r7 ^ AES_BS_FN(rotr32)(q3 ^ q4 ^ q6 ^ q7 ^ r3 ^ r6 ^ r7);
+    q[7] = q4 ^ q5 ^ q6 ^ r4 ^ r6 ^ r7 ^ AES_BS_FN(rotr32)(q4 ^ q5 ^ q7 ^ r4 ^ r7);
+}
+
+// 完整的加密轮：q 已是切片形式
+static void AES_BS_FN(encrypt_rounds)(AES_BS_WORD *q, const AES_BS_WORD (*sk)[8], int rounds) {
+    AES_BS_FN(add_round_key)(q, sk[0]);
+    for (int r = 1; r < rounds; r++) {
+        AES_BS_FN(sbox)(q);
+        AES_BS_FN(shift_rows)(q);
+        AES_BS_FN(mix_columns)(q);
+        AES_BS_FN(add_round_key)(q, sk[r]);
+    }
+    AES_BS_FN(sbox)(q);
+    AES_BS_FN(shift_rows)(q);
+    AES_BS_FN(add_round_key)(q, sk[rounds]);
+}
+
+// 等价逆密码：中间轮密钥已做过 InvMixColumns，与 T 表解密使用同一份解密密钥编排
+static void AES_BS_FN(decrypt_rounds)(AES_BS_WORD *q, const AES_BS_WORD (*sk)[8], int rounds) {
+    AES_BS_FN(add_round_key)(q, sk[rounds]);
+    for (int r = rounds - 1; r > 0; r--) {
+        AES_BS_FN(inv_shift_rows)(q);
+        AES_BS_FN(inv_sbox)(q);
+        AES_BS_FN(inv_mix_columns)(q);
+        AES_BS_FN(add_round_key)(q, sk[r]);
+    }
+    AES_BS_FN(inv_shift_rows)(q);
+    AES_BS_FN(inv_sbox)(q);
+    AES_BS_FN(add_round_key)(q, sk[0]);
+}
+
+#undef AES_BS_SWAP8
+#undef AES_BS_SWAP4
+#undef AES_BS_SWAP2
+#undef AES_BS_SWAPN
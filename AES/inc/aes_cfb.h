@@ -7,6 +7,47 @@
 extern "C" {
 #endif
 
+/**
+ * @brief AES-CFB（CFB-128）流式上下文，密钥编排只在 aes_cfb_init 中计算一次
+ */
+typedef struct {
+    aes_key_schedule ks;               /* 加密密钥编排，CFB 解密同样只用加密方向 */
+    unsigned char iv[AES_BLOCK_SIZE];  /* num 为 0 时是反馈寄存器（上一密文分组），否则是当前分组的密钥流/密文 */
+    size_t num;                        /* 当前分组已处理的字节数 */
+    int decrypt;
+} aes_cfb_ctx;
+
+/**
+ * @brief 初始化 AES-CFB 上下文
+ * @param[out] ctx 上下文
+ * @param[in] key AES密钥，长度为 key_len
+ * @param[in] key_len AES_KEY_SIZE、AES_192_KEY_SIZE 或 AES_256_KEY_SIZE
+ * @param[in] iv 初始化向量 (16字节)
+ * @param[in] decrypt 0 加密，1 解密
+ * @return 0 成功
+ * @return 1 失败（密钥长度不支持）
+ */
+int aes_cfb_init(aes_cfb_ctx *ctx, const unsigned char *key, size_t key_len,
+                 const unsigned char iv[AES_BLOCK_SIZE], int decrypt);
+
+/**
+ * @brief 处理后续数据，长度任意，反馈寄存器跨调用保留
+ * @param[in,out] ctx 上下文
+ * @param[in] input 输入数据
+ * @param[out] output 输出缓冲区，长度为 len，可与 input 相同
+ * @param[in] len 数据长度（字节）
+ * @return 0 成功
+ * @return 1 失败
+ */
+int aes_cfb_update(aes_cfb_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len);
+
+/**
+ * @brief 结束：CFB 没有填充，只清除上下文中的密钥编排与反馈寄存器
+ * @param[in,out] ctx 上下文
+ * @return 0 成功
+ */
+int aes_cfb_final(aes_cfb_ctx *ctx);
+
 /**
  * @brief AES-CFB加密
  * @param[in] plaintext 明文数据
@@ -0,0 +1,74 @@
+#ifndef AES_CTR_H
+#define AES_CTR_H
+
+#include "aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief AES-CTR (NIST SP 800-38A)
+     * The counter is the last counter_bits bits of the counter block, big-endian, and wraps
+     * modulo 2^counter_bits without carrying into the nonce part.
+     * Byte offset n of the stream uses counter block iv + n / AES_BLOCK_SIZE.
+     */
+    typedef struct {
+        aes_key_schedule ks;              /* encryption key schedule, CTR never decrypts */
+        unsigned char iv[AES_BLOCK_SIZE]; /* counter block of stream offset 0 */
+        int counter_bits;                 /* 32 or 64 */
+        uint64_t offset;                  /* current stream position (bytes) */
+    } aes_ctr_ctx;
+
+    /**
+     * @brief Initialize a CTR context at stream offset 0
+     * @param[out] ctx context
+     * @param[in] key original key, [length = key_len]
+     * @param[in] key_len AES_KEY_SIZE, AES_192_KEY_SIZE or AES_256_KEY_SIZE
+     * @param[in] iv initial counter block, [length = AES_BLOCK_SIZE]
+     * @param[in] counter_bits 32 or 64
+     * @return 0 OK
+     * @return 1 Failed (bad key length or counter size)
+     */
+    int aes_ctr_init(aes_ctr_ctx *ctx, const unsigned char *key, size_t key_len,
+                     const unsigned char iv[AES_BLOCK_SIZE], int counter_bits);
+
+    /**
+     * @brief Move to an arbitrary stream offset, e.g. a disk sector or a resumed download
+     * @param[in,out] ctx context
+     * @param[in] offset stream position (bytes)
+     */
+    void aes_ctr_seek(aes_ctr_ctx *ctx, uint64_t offset);
+
+    /**
+     * @brief Encrypt / decrypt the next part of the stream and advance the offset
+     * @param[in,out] ctx context
+     * @param[in] input input data
+     * @param[out] output output data, [length = len], may equal input
+     * @param[in] len length (bytes), any value
+     * @return 0 OK
+     * @return 1 Failed (the counter would wrap and reuse keystream)
+     */
+    int aes_ctr_update(aes_ctr_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len);
+
+    /**
+     * @brief Encrypt / decrypt len bytes starting at an arbitrary stream offset
+     * @param[in] input input data
+     * @param[out] output output data, [length = len], may equal input
+     * @param[in] len length (bytes), any value
+     * @param[in] ks encryption key schedule
+     * @param[in] iv counter block of stream offset 0, [length = AES_BLOCK_SIZE]
+     * @param[in] counter_bits 32 or 64
+     * @param[in] offset stream position of input[0] (bytes)
+     * @return 0 OK
+     * @return 1 Failed (bad counter size, or the counter would wrap and reuse keystream)
+     */
+    int aes_ctr_crypt(const unsigned char *input, unsigned char *output, size_t len,
+                      const aes_key_schedule *ks, const unsigned char iv[AES_BLOCK_SIZE],
+                      int counter_bits, uint64_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_CTR_H
@@ -0,0 +1,130 @@
+#ifndef AES_FILE_H
+#define AES_FILE_H
+
+#include "aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AES_FILE_CHUNK (1 << 20) /* bytes read / mapped per step, a multiple of AES_BLOCK_SIZE */
+
+    /**
+     * @brief Cipher mode of the streaming file functions
+     * CTR: same length as the input, the IV is the initial counter block (64-bit counter).
+     * CBC: PKCS#7 padded, the output is 1..AES_BLOCK_SIZE bytes longer than the input.
+     * GCM: the first AES_GCM_IV_SIZE bytes of the IV are the nonce, the 16-byte tag follows the ciphertext.
+     */
+    typedef enum {
+        AES_FILE_CTR,
+        AES_FILE_CBC,
+        AES_FILE_GCM
+    } aes_file_mode;
+
+    /**
+     * @brief PKCS#7 pad the last block in place
+     * @param[in,out] block block buffer, [length = AES_BLOCK_SIZE]
+     * @param[in] data_len bytes of data in the block, 0..AES_BLOCK_SIZE - 1
+     */
+    void pkcs7_pad(unsigned char *block, size_t data_len);
+
+    /**
+     * @brief Check the PKCS#7 padding of the last block
+     * @param[in] block last plaintext block, [length = AES_BLOCK_SIZE]
+     * @return bytes of data in the block, 0..AES_BLOCK_SIZE - 1
+     * @return -1 Failed (bad padding)
+     */
+    int pkcs7_unpad(const unsigned char *block);
+
+    /**
+     * @brief Encrypt a memory buffer in ECB mode with PKCS#7 padding
+     * @param[in] src plaintext, [length = bytes]
+     * @param[in] bytes plaintext length (bytes)
+     * @param[in] subKeys encryption subkeys from aes_make_enc_subkeys
+     * @param[out] va_dest ciphertext, [length = bytes / AES_BLOCK_SIZE * AES_BLOCK_SIZE + AES_BLOCK_SIZE]
+     * @param[out] dest_len ciphertext length (bytes)
+     * @return 0 OK
+     */
+    int aes_encrypt_file(const void *src, size_t bytes, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE],
+                         void *va_dest, size_t *dest_len);
+
+    /**
+     * @brief Decrypt a buffer produced by aes_encrypt_file
+     * @param[in] src ciphertext, [length = bytes]
+     * @param[in] bytes ciphertext length (bytes), a positive multiple of AES_BLOCK_SIZE
+     * @param[in] subKeys decryption subkeys from aes_make_dec_subkeys
+     * @param[out] va_dest plaintext, [length = bytes]
+     * @param[out] dest_len plaintext length (bytes)
+     * @return 0 OK
+     * @return 1 Failed (bad length or padding)
+     */
+    int aes_decrypt_file(const void *src, size_t bytes, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE],
+                         void *va_dest, size_t *dest_len);
+
+    /**
+     * @brief Encrypt a stream with AES_FILE_CHUNK sized aligned buffers, works on pipes and sockets
+     * @param[in] in_fd input file descriptor, read until EOF
+     * @param[in] out_fd output file descriptor
+     * @param[in] mode cipher mode
+     * @param[in] key original key, [length = key_len]
+     * @param[in] key_len AES_KEY_SIZE, AES_192_KEY_SIZE or AES_256_KEY_SIZE
+     * @param[in] iv IV / initial counter block, [length = AES_BLOCK_SIZE], never reuse with the same key
+     * @param[out] out_bytes bytes written, may be NULL
+     * @return 0 OK
+     * @return 1 Failed (bad argument or I/O error)
+     */
+    int aes_encrypt_fd(int in_fd, int out_fd, aes_file_mode mode, const unsigned char *key, size_t key_len,
+                       const unsigned char iv[AES_BLOCK_SIZE], uint64_t *out_bytes);
+
+    /**
+     * @brief Decrypt a stream, GCM output is unauthenticated until the function returns 0
+     * @param[in] in_fd input file descriptor, read until EOF
+     * @param[in] out_fd output file descriptor
+     * @param[in] mode cipher mode
+     * @param[in] key original key, [length = key_len]
+     * @param[in] key_len AES_KEY_SIZE, AES_192_KEY_SIZE or AES_256_KEY_SIZE
+     * @param[in] iv IV / initial counter block used for encryption, [length = AES_BLOCK_SIZE]
+     * @param[out] out_bytes bytes written, may be NULL
+     * @return 0 OK
+     * @return 1 Failed (bad argument, I/O error, bad padding or tag mismatch)
+     */
+    int aes_decrypt_fd(int in_fd, int out_fd, aes_file_mode mode, const unsigned char *key, size_t key_len,
+                       const unsigned char iv[AES_BLOCK_SIZE], uint64_t *out_bytes);
+
+    /**
+     * @brief Encrypt a file, the input is memory-mapped when possible
+     * @param[in] in_path input file
+     * @param[in] out_path output file, created or truncated
+     * @param[in] mode cipher mode
+     * @param[in] key original key, [length = key_len]
+     * @param[in] key_len AES_KEY_SIZE, AES_192_KEY_SIZE or AES_256_KEY_SIZE
+     * @param[in] iv IV / initial counter block, [length = AES_BLOCK_SIZE], never reuse with the same key
+     * @param[out] out_bytes bytes written, may be NULL
+     * @return 0 OK
+     * @return 1 Failed, the output file is removed
+     */
+    int aes_encrypt_path(const char *in_path, const char *out_path, aes_file_mode mode,
+                         const unsigned char *key, size_t key_len, const unsigned char iv[AES_BLOCK_SIZE],
+                         uint64_t *out_bytes);
+
+    /**
+     * @brief Decrypt a file, the input is memory-mapped when possible
+     * @param[in] in_path input file
+     * @param[in] out_path output file, created or truncated
+     * @param[in] mode cipher mode
+     * @param[in] key original key, [length = key_len]
+     * @param[in] key_len AES_KEY_SIZE, AES_192_KEY_SIZE or AES_256_KEY_SIZE
+     * @param[in] iv IV / initial counter block used for encryption, [length = AES_BLOCK_SIZE]
+     * @param[out] out_bytes bytes written, may be NULL
+     * @return 0 OK
+     * @return 1 Failed (the output file is removed, so no unauthenticated plaintext is left behind)
+     */
+    int aes_decrypt_path(const char *in_path, const char *out_path, aes_file_mode mode,
+                         const unsigned char *key, size_t key_len, const unsigned char iv[AES_BLOCK_SIZE],
+                         uint64_t *out_bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_FILE_H
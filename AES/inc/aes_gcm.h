@@ -0,0 +1,149 @@
+#ifndef AES_GCM_H
+#define AES_GCM_H
+
+#include "aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AES_GCM_IV_SIZE 12  /* recommended IV length, other lengths are hashed into J0 */
+#define AES_GCM_TAG_SIZE 16 /* full tag length */
+
+    /**
+     * @brief AES-GCM (NIST SP 800-38D) context
+     * aes_gcm_init once per key, then per message: aes_gcm_start, aes_gcm_update_aad*,
+     * aes_gcm_encrypt_update* / aes_gcm_decrypt_update*, aes_gcm_final / aes_gcm_verify.
+     * GHASH uses PCLMULQDQ with the AES-NI implementation, otherwise a 4-bit Shoup table.
+     * The Shoup table is indexed by secret data, so GHASH stays table-driven under AES_IMPL_BITSLICE.
+     */
+    typedef struct {
+        aes_key_schedule ks;                   /* encryption key schedule */
+        uint64_t htable[16][2];                /* 4-bit Shoup table of H, {high, low} */
+        unsigned char hpow[8][AES_BLOCK_SIZE]; /* H^1..H^8 for the PCLMULQDQ path */
+        int use_clmul;
+        unsigned char j0[AES_BLOCK_SIZE];      /* pre-counter block, encrypts the tag */
+        unsigned char xi[AES_BLOCK_SIZE];      /* GHASH accumulator */
+        unsigned char ek[AES_BLOCK_SIZE];      /* keystream of the partial data block */
+        uint64_t aad_len;                      /* bytes of AAD so far */
+        uint64_t msg_len;                      /* bytes of data so far */
+        int aad_done;                          /* data started, no more AAD */
+    } aes_gcm_ctx;
+
+    /**
+     * @brief Set the key: key schedule and GHASH tables are computed once per key
+     * @param[out] ctx context
+     * @param[in] key original key, [length = key_len]
+     * @param[in] key_len AES_KEY_SIZE, AES_192_KEY_SIZE or AES_256_KEY_SIZE
+     * @return 0 OK
+     * @return 1 Failed (unsupported key length)
+     */
+    int aes_gcm_init(aes_gcm_ctx *ctx, const unsigned char *key, size_t key_len);
+
+    /**
+     * @brief Start a new message
+     * @param[in,out] ctx context
+     * @param[in] iv initialization vector, [length = iv_len], never reuse with the same key
+     * @param[in] iv_len IV length (bytes), AES_GCM_IV_SIZE recommended
+     * @return 0 OK
+     * @return 1 Failed (empty IV)
+     */
+    int aes_gcm_start(aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len);
+
+    /**
+     * @brief Authenticate additional data, must precede all message data
+     * @param[in,out] ctx context
+     * @param[in] aad additional authenticated data
+     * @param[in] aad_len length (bytes), any value
+     * @return 0 OK
+     * @return 1 Failed (message data already started)
+     */
+    int aes_gcm_update_aad(aes_gcm_ctx *ctx, const unsigned char *aad, size_t aad_len);
+
+    /**
+     * @brief Encrypt the next part of the message
+     * @param[in,out] ctx context
+     * @param[in] input plaintext
+     * @param[out] output ciphertext, [length = len], may equal input
+     * @param[in] len length (bytes), any value
+     * @return 0 OK
+     * @return 1 Failed (message longer than 2^36 - 32 bytes)
+     */
+    int aes_gcm_encrypt_update(aes_gcm_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len);
+
+    /**
+     * @brief Decrypt the next part of the message, the plaintext is unauthenticated until aes_gcm_verify
+     * @param[in,out] ctx context
+     * @param[in] input ciphertext
+     * @param[out] output plaintext, [length = len], may equal input
+     * @param[in] len length (bytes), any value
+     * @return 0 OK
+     * @return 1 Failed (message longer than 2^36 - 32 bytes)
+     */
+    int aes_gcm_decrypt_update(aes_gcm_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len);
+
+    /**
+     * @brief Finish the message and output the tag
+     * @param[in,out] ctx context
+     * @param[out] tag authentication tag, [length = tag_len]
+     * @param[in] tag_len 4..AES_GCM_TAG_SIZE
+     * @return 0 OK
+     * @return 1 Failed (bad tag length)
+     */
+    int aes_gcm_final(aes_gcm_ctx *ctx, unsigned char *tag, size_t tag_len);
+
+    /**
+     * @brief Finish the message and check the received tag in constant time
+     * @param[in,out] ctx context
+     * @param[in] tag received tag, [length = tag_len]
+     * @param[in] tag_len 4..AES_GCM_TAG_SIZE
+     * @return 0 OK
+     * @return 1 Failed (tag mismatch or bad tag length)
+     */
+    int aes_gcm_verify(aes_gcm_ctx *ctx, const unsigned char *tag, size_t tag_len);
+
+    /**
+     * @brief One-shot authenticated encryption with a keyed context
+     * @param[in,out] ctx context initialized with aes_gcm_init
+     * @param[in] iv initialization vector, [length = iv_len]
+     * @param[in] iv_len IV length (bytes)
+     * @param[in] aad additional authenticated data, [length = aad_len]
+     * @param[in] aad_len AAD length (bytes)
+     * @param[in] input plaintext, [length = len]
+     * @param[out] output ciphertext, [length = len], may equal input
+     * @param[in] len length (bytes)
+     * @param[out] tag authentication tag, [length = tag_len]
+     * @param[in] tag_len 4..AES_GCM_TAG_SIZE
+     * @return 0 OK
+     * @return 1 Failed
+     */
+    int aes_gcm_encrypt(aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len,
+                        const unsigned char *aad, size_t aad_len,
+                        const unsigned char *input, unsigned char *output, size_t len,
+                        unsigned char *tag, size_t tag_len);
+
+    /**
+     * @brief One-shot authenticated decryption, the output is wiped when the tag does not match
+     * @param[in,out] ctx context initialized with aes_gcm_init
+     * @param[in] iv initialization vector, [length = iv_len]
+     * @param[in] iv_len IV length (bytes)
+     * @param[in] aad additional authenticated data, [length = aad_len]
+     * @param[in] aad_len AAD length (bytes)
+     * @param[in] input ciphertext, [length = len]
+     * @param[out] output plaintext, [length = len], may equal input
+     * @param[in] len length (bytes)
+     * @param[in] tag received tag, [length = tag_len]
+     * @param[in] tag_len 4..AES_GCM_TAG_SIZE
+     * @return 0 OK
+     * @return 1 Failed (authentication failure)
+     */
+    int aes_gcm_decrypt(aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len,
+                        const unsigned char *aad, size_t aad_len,
+                        const unsigned char *input, unsigned char *output, size_t len,
+                        const unsigned char *tag, size_t tag_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_GCM_H
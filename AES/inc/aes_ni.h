@@ -0,0 +1,183 @@
+#ifndef AES_NI_H
+#define AES_NI_H
+
+#include "aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief AES-NI backend, round keys in byte order (the aes_make_enc_subkeys layout)
+     * Only call these when aes_has_aesni() returns 1
+     */
+
+    /**
+     * @brief Expand an AES-128 key (AESENCLAST computes SubWord, shorter latency than AESKEYGENASSIST)
+     * @param[in] key original key
+     * @param[out] subKeys encryption round keys
+     */
+    void aes_ni_make_enc_subkeys(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]);
+
+    /**
+     * @brief Derive decryption round keys with AESIMC (same layout as aes_make_dec_subkeys)
+     * @param[in] encSubKeys encryption round keys
+     * @param[out] decSubKeys decryption round keys, may equal encSubKeys
+     */
+    void aes_ni_make_dec_subkeys(const unsigned char encSubKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE],
+                                 unsigned char decSubKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]);
+
+    /**
+     * @brief Expand a 128/192/256-bit key (AESENCLAST computes SubWord)
+     * @param[in] key original key, [length = 4 * (rounds - 6)]
+     * @param[in] rounds 10, 12 or 14
+     * @param[out] subKeys encryption round keys, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[out] words the same round keys as big-endian 32-bit words (aes_key_schedule.rk), [4 * (rounds + 1)], may be NULL
+     */
+    void aes_ni_make_enc_key_schedule(const unsigned char *key, int rounds, unsigned char (*subKeys)[AES_BLOCK_SIZE],
+                                      uint32_t *words);
+
+    /**
+     * @brief Derive decryption round keys of any key length with AESIMC
+     * @param[in] encSubKeys encryption round keys, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     * @param[out] decSubKeys decryption round keys, [rounds + 1][AES_BLOCK_SIZE], may equal encSubKeys
+     * @param[out] words the same round keys as big-endian 32-bit words (aes_key_schedule.rk), [4 * (rounds + 1)], may be NULL
+     */
+    void aes_ni_make_dec_key_schedule(const unsigned char (*encSubKeys)[AES_BLOCK_SIZE], int rounds,
+                                      unsigned char (*decSubKeys)[AES_BLOCK_SIZE], uint32_t *words);
+
+    /**
+     * @brief AES-NI encrypt single block
+     * @param[in] input plaintext, [length = AES_BLOCK_SIZE]
+     * @param[in] subKeys encryption round keys, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     * @param[out] output ciphertext, [length = AES_BLOCK_SIZE]
+     */
+    void aes_ni_encrypt_block(const unsigned char *input, const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                              unsigned char *output);
+
+    /**
+     * @brief AES-NI decrypt single block
+     * @param[in] input ciphertext, [length = AES_BLOCK_SIZE]
+     * @param[in] subKeys decryption round keys, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     * @param[out] output plaintext, [length = AES_BLOCK_SIZE]
+     */
+    void aes_ni_decrypt_block(const unsigned char *input, const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                              unsigned char *output);
+
+    /**
+     * @brief AES-NI encrypt independent blocks, 8 blocks in flight per round
+     * @param[in] input plaintext, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[out] output ciphertext, [length = nblocks * AES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] subKeys encryption round keys, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     */
+    void aes_ni_ecb_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds);
+
+    /**
+     * @brief AES-NI decrypt independent blocks, 8 blocks in flight per round
+     * @param[in] input ciphertext, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[out] output plaintext, [length = nblocks * AES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] subKeys decryption round keys, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     */
+    void aes_ni_ecb_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds);
+
+    /**
+     * @brief GHASH with PCLMULQDQ, H and its powers are kept byte-reflected
+     * Only call these when aes_ni_has_pclmul() returns 1
+     */
+
+    /**
+     * @brief Check whether the CPU supports the PCLMULQDQ GHASH path (PCLMULQDQ, SSSE3, SSE4.1)
+     * @return 1 supported
+     * @return 0 not supported
+     */
+    int aes_ni_has_pclmul(void);
+
+    /**
+     * @brief Precompute H^1..H^8 for aggregated GHASH
+     * @param[in] h hash subkey E(K, 0^128), [length = AES_BLOCK_SIZE]
+     * @param[out] hpow hpow[i] holds H^(i + 1)
+     */
+    void aes_ni_ghash_init(const unsigned char h[AES_BLOCK_SIZE], unsigned char hpow[8][AES_BLOCK_SIZE]);
+
+    /**
+     * @brief Absorb whole blocks into the GHASH accumulator
+     * @param[in,out] xi GHASH accumulator, [length = AES_BLOCK_SIZE]
+     * @param[in] hpow H powers from aes_ni_ghash_init
+     * @param[in] input data, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[in] nblocks number of blocks
+     */
+    void aes_ni_ghash(unsigned char xi[AES_BLOCK_SIZE], const unsigned char hpow[8][AES_BLOCK_SIZE],
+                      const unsigned char *input, size_t nblocks);
+
+    /**
+     * @brief GCM encrypt whole blocks: CTR with a 32-bit counter stitched with GHASH of the ciphertext
+     * @param[in] input plaintext, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[out] output ciphertext, [length = nblocks * AES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] subKeys encryption round keys, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     * @param[in] counter counter block of the first block, [length = AES_BLOCK_SIZE]
+     * @param[in,out] xi GHASH accumulator, [length = AES_BLOCK_SIZE]
+     * @param[in] hpow H powers from aes_ni_ghash_init
+     */
+    void aes_ni_gcm_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                            const unsigned char counter[AES_BLOCK_SIZE], unsigned char xi[AES_BLOCK_SIZE],
+                            const unsigned char hpow[8][AES_BLOCK_SIZE]);
+
+    /**
+     * @brief GCM decrypt whole blocks: GHASH of the ciphertext stitched with CTR
+     * @param[in] input ciphertext, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[out] output plaintext, [length = nblocks * AES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] subKeys encryption round keys, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     * @param[in] counter counter block of the first block, [length = AES_BLOCK_SIZE]
+     * @param[in,out] xi GHASH accumulator, [length = AES_BLOCK_SIZE]
+     * @param[in] hpow H powers from aes_ni_ghash_init
+     */
+    void aes_ni_gcm_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                            const unsigned char counter[AES_BLOCK_SIZE], unsigned char xi[AES_BLOCK_SIZE],
+                            const unsigned char hpow[8][AES_BLOCK_SIZE]);
+
+    /**
+     * @brief XTS encrypt whole blocks of one data unit, tweak kept in a register between blocks
+     * @param[in] input plaintext, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[out] output ciphertext, [length = nblocks * AES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] subKeys encryption round keys of key1, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     * @param[in,out] tweak encrypted tweak of the first block, advanced past the last block
+     */
+    void aes_ni_xts_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                            unsigned char tweak[AES_BLOCK_SIZE]);
+
+    /**
+     * @brief XTS decrypt whole blocks of one data unit
+     * @param[in] input ciphertext, [length = nblocks * AES_BLOCK_SIZE]
+     * @param[out] output plaintext, [length = nblocks * AES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] subKeys decryption round keys of key1, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     * @param[in,out] tweak encrypted tweak of the first block, advanced past the last block
+     */
+    void aes_ni_xts_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                            unsigned char tweak[AES_BLOCK_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_NI_H
@@ -0,0 +1,39 @@
+#ifndef AES_REF_H
+#define AES_REF_H
+
+#include "aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Reference backend: FIPS-197 operations on a 4x4 byte state, one step at a time
+     * Slow on purpose; the other backends are checked against it
+     */
+
+    /**
+     * @brief Reference encrypt single block
+     * @param[in] input plaintext, [length = AES_BLOCK_SIZE]
+     * @param[in] subKeys encryption round keys, [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     * @param[out] output ciphertext, [length = AES_BLOCK_SIZE], may equal input
+     */
+    void aes_ref_encrypt_block(const unsigned char *input, const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                               unsigned char *output);
+
+    /**
+     * @brief Reference decrypt single block (equivalent inverse cipher)
+     * @param[in] input ciphertext, [length = AES_BLOCK_SIZE]
+     * @param[in] subKeys decryption round keys (InvMixColumns applied to the inner rounds), [rounds + 1][AES_BLOCK_SIZE]
+     * @param[in] rounds 10, 12 or 14
+     * @param[out] output plaintext, [length = AES_BLOCK_SIZE], may equal input
+     */
+    void aes_ref_decrypt_block(const unsigned char *input, const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                               unsigned char *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_REF_H
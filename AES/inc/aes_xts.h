@@ -0,0 +1,98 @@
+#ifndef AES_XTS_H
+#define AES_XTS_H
+
+#include "aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief AES-XTS (IEEE 1619 / NIST SP 800-38E) for sector-addressed storage
+     * The key is key1 || key2 of equal length: key1 encrypts the data, key2 the tweak.
+     * Sector n uses the data unit sequence number n, as a 128-bit little-endian tweak.
+     * The context is read-only after aes_xts_init, so threads can share it and each
+     * encrypt a different range of sectors.
+     */
+    typedef struct {
+        aes_key_schedule ks_enc;   /* key1 encryption schedule */
+        aes_key_schedule ks_dec;   /* key1 decryption schedule */
+        aes_key_schedule ks_tweak; /* key2 encryption schedule */
+        size_t sector_size;        /* data unit length (bytes) */
+    } aes_xts_ctx;
+
+    /**
+     * @brief Initialize an XTS context
+     * @param[out] ctx context
+     * @param[in] key key1 || key2, [length = key_len]
+     * @param[in] key_len 2 * AES_KEY_SIZE, 2 * AES_192_KEY_SIZE or 2 * AES_256_KEY_SIZE
+     * @param[in] sector_size data unit length (bytes), at least AES_BLOCK_SIZE, need not be a multiple of it
+     * @return 0 OK
+     * @return 1 Failed (bad key or sector length)
+     */
+    int aes_xts_init(aes_xts_ctx *ctx, const unsigned char *key, size_t key_len, size_t sector_size);
+
+    /**
+     * @brief Encrypt one data unit of any length, ciphertext stealing for the last partial block
+     * @param[in] ctx context
+     * @param[in] input plaintext, [length = len]
+     * @param[out] output ciphertext, [length = len], may equal input
+     * @param[in] len length (bytes), at least AES_BLOCK_SIZE
+     * @param[in] tweak data unit tweak before encryption, [length = AES_BLOCK_SIZE]
+     * @return 0 OK
+     * @return 1 Failed (data unit shorter than one block)
+     */
+    int aes_xts_encrypt(const aes_xts_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len,
+                        const unsigned char tweak[AES_BLOCK_SIZE]);
+
+    /**
+     * @brief Decrypt one data unit of any length, ciphertext stealing for the last partial block
+     * @param[in] ctx context
+     * @param[in] input ciphertext, [length = len]
+     * @param[out] output plaintext, [length = len], may equal input
+     * @param[in] len length (bytes), at least AES_BLOCK_SIZE
+     * @param[in] tweak data unit tweak before encryption, [length = AES_BLOCK_SIZE]
+     * @return 0 OK
+     * @return 1 Failed (data unit shorter than one block)
+     */
+    int aes_xts_decrypt(const aes_xts_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len,
+                        const unsigned char tweak[AES_BLOCK_SIZE]);
+
+    /**
+     * @brief Encrypt consecutive sectors
+     * @param[in] ctx context
+     * @param[in] input plaintext, [length = nsectors * sector_size]
+     * @param[out] output ciphertext, [length = nsectors * sector_size], may equal input
+     * @param[in] sector number of the first sector
+     * @param[in] nsectors number of sectors
+     * @return 0 OK
+     * @return 1 Failed (sector numbers overflow)
+     */
+    int aes_xts_encrypt_sectors(const aes_xts_ctx *ctx, const unsigned char *input, unsigned char *output,
+                                uint64_t sector, size_t nsectors);
+
+    /**
+     * @brief Decrypt consecutive sectors
+     * @param[in] ctx context
+     * @param[in] input ciphertext, [length = nsectors * sector_size]
+     * @param[out] output plaintext, [length = nsectors * sector_size], may equal input
+     * @param[in] sector number of the first sector
+     * @param[in] nsectors number of sectors
+     * @return 0 OK
+     * @return 1 Failed (sector numbers overflow)
+     */
+    int aes_xts_decrypt_sectors(const aes_xts_ctx *ctx, const unsigned char *input, unsigned char *output,
+                                uint64_t sector, size_t nsectors);
+
+    /**
+     * @brief Wipe the key schedules
+     * @param[in,out] ctx context
+     * @return 0 OK
+     */
+    int aes_xts_final(aes_xts_ctx *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_XTS_H
@@ -1,105 +1,59 @@
 #include "../inc/aes.h"
+#include "../inc/aes_ni.h"
+#include "../inc/aes_bitslice.h"
+#include "../inc/aes_ref.h"
+#include "../inc/table.h"
 #include <string.h>
 #include <stdio.h>
 
-int aes_make_enc_subkeys(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]) {
-    unsigned int i, j;
-    unsigned char temp[4];
-    unsigned char expandedKey[AES_EXPANDED_KEY_SIZE];
-
-    // 前16字节是原始密钥
-    memcpy(expandedKey, key, AES_KEY_SIZE);
-
-    // 生成其余的密钥
-    for (i = AES_KEY_SIZE; i < AES_EXPANDED_KEY_SIZE; i += 4) {
-        // temp = W[I-1]
-        for (j = 0; j < 4; j++) {
-            temp[j] = expandedKey[(i - 4) + j];
-        }
+// 轮常量
+static const uint8_t RCON[11] = {
+    0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+};
 
-        // I = Nk的整数倍
-        if (i % AES_KEY_SIZE == 0) {
-            // 轮常量
-            unsigned char k = temp[0];
-            temp[0] = S_BOX[temp[1]] ^ RCON[i / AES_KEY_SIZE];
-            temp[1] = S_BOX[temp[2]];
-            temp[2] = S_BOX[temp[3]];
-            temp[3] = S_BOX[k];
-        }
+static void add_round_key(unsigned char state[4][4], const unsigned char roundKey[AES_BLOCK_SIZE]) {
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+        state[i / 4][i % 4] ^= roundKey[i];
+    }
+}
 
+static void inv_sub_bytes(unsigned char state[4][4]) {
+    int i, j;
+    for (i = 0; i < 4; i++) {
         for (j = 0; j < 4; j++) {
-            expandedKey[i + j] = expandedKey[(i - AES_KEY_SIZE) + j] ^ temp[j];
+            state[i][j] = INV_S_BOX[state[i][j]];
         }
     }
-
-    for(int i = 0; i < 11; i++) {
-        memcpy(subKeys[i], expandedKey + i * 16, AES_BLOCK_SIZE);
-    }
-
-    // 调试输出
-    // for(int i = 0; i < 11; i++) {
-    //     for(int j = 0; j < 16; j++) {
-    //         printf("%02x ", subKeys[i][j]);
-    //     }
-    //     printf("\n");
-    // }
-
-    return 0;
 }
 
-int aes_make_dec_subkeys(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]) {
-    unsigned int i, j;
+// 逆行移位函数
+static void inv_shift_rows(unsigned char state[4][4]) {
+    // 逆移位方法1
     unsigned char temp[4];
-    unsigned char expandedKey[AES_EXPANDED_KEY_SIZE];
 
-    // 前16字节是原始密钥
-    memcpy(expandedKey, key, AES_KEY_SIZE);
-
-    // 生成加密的扩展密钥
-    for (i = AES_KEY_SIZE; i < AES_EXPANDED_KEY_SIZE; i += 4) {
-        // temp = W[i-1]
-        for (j = 0; j < 4; j++) {
-            temp[j] = expandedKey[(i - 4) + j];
-        }
+    for(int i = 0; i < 4; ++i) {
+        temp[0] = state[0][i];
+        temp[1] = state[1][i];
+        temp[2] = state[2][i];
+        temp[3] = state[3][i];
+        state[0][i] = temp[(4-i) % 4];
+        state[1][i] = temp[(5-i) % 4];
+        state[2][i] = temp[(6-i) % 4];
+        state[3][i] = temp[(7-i) % 4];
+    }
+}
 
-        // I 是 Nk 的整数倍
-        if (i % AES_KEY_SIZE == 0) {
-            // 轮常量
-            unsigned char k = temp[0];
-            temp[0] = S_BOX[temp[1]] ^ RCON[i / AES_KEY_SIZE];
-            temp[1] = S_BOX[temp[2]];
-            temp[2] = S_BOX[temp[3]];
-            temp[3] = S_BOX[k];
-        }
+static void convert_uint_to_uchar(const unsigned int temp[4], unsigned char temp1[4][4]) {
+    int i, j;
 
+    for (i = 0; i < 4; i++) {
         for (j = 0; j < 4; j++) {
-            expandedKey[i + j] = expandedKey[(i - AES_KEY_SIZE) + j] ^ temp[j];
+            temp1[i][j] = (temp[i] >> (24 - 8 * j)) & 0xFF;
         }
     }
-
-    // 反向存储轮密钥
-    for (i = 0; i < AES_EXPANDED_KEY_BLOCK; i++) {
-        memcpy(subKeys[i], expandedKey + i * AES_BLOCK_SIZE, AES_BLOCK_SIZE);
-    }
-
-    // 对解密的每个轮密钥（除第0轮和最后一轮）进行逆MixColumns变换
-    uint64_t *state = (uint64_t *)subKeys; 
-    for (i = 1; i < AES_EXPANDED_KEY_BLOCK - 1; i++) {
-        inv_mix_columns(&state[2 * i]); 
-    }
-
-    //  调试输出
-    // for(int i = 0; i < 11; i++) {
-    //     for(int j = 0; j < 16; j++) {
-    //         printf("%02x ", subKeys[i][j]);
-    //     }
-    //     printf("\n");
-    // }
-
-    return 0;
 }
 
-void aes_encrypt_block(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
+static void aes_encrypt_block_table(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
     unsigned int state[4];
     unsigned int temp[4];
     int i, round;
@@ -155,7 +109,7 @@ void aes_encrypt_block(const unsigned char *input, unsigned char subKeys[AES_EXP
     }
 }
 
-void aes_decrypt_block(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
+static void aes_decrypt_block_table(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
     unsigned int state[4];
     unsigned int temp[4];
     int i, round;
@@ -203,4 +157,607 @@ void aes_decrypt_block(const unsigned char *input, unsigned char subKeys[AES_EXP
             output[i * 4 + j] = state1[i][j];
         }
     }
-}
\ No newline at end of file
+}
+
+// 大端装载 / 存储 32 位字
+#define GETU32(p) (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                   ((uint32_t)(p)[2] << 8) | ((uint32_t)(p)[3]))
+#define PUTU32(p, v) { (p)[0] = (unsigned char)((v) >> 24); (p)[1] = (unsigned char)((v) >> 16); \
+                       (p)[2] = (unsigned char)((v) >> 8); (p)[3] = (unsigned char)(v); }
+
+// 一轮 T 表加密：SubBytes、ShiftRows、MixColumns 合并为每列 4 次查表
+#define AES_ENC_ROUND(T0, T1, T2, T3, S0, S1, S2, S3, RK) {                                        \
+    T0 = Te0[(S0) >> 24] ^ Te1[((S1) >> 16) & 0xFF] ^ Te2[((S2) >> 8) & 0xFF] ^ Te3[(S3) & 0xFF] ^ (RK)[0]; \
+    T1 = Te0[(S1) >> 24] ^ Te1[((S2) >> 16) & 0xFF] ^ Te2[((S3) >> 8) & 0xFF] ^ Te3[(S0) & 0xFF] ^ (RK)[1]; \
+    T2 = Te0[(S2) >> 24] ^ Te1[((S3) >> 16) & 0xFF] ^ Te2[((S0) >> 8) & 0xFF] ^ Te3[(S1) & 0xFF] ^ (RK)[2]; \
+    T3 = Te0[(S3) >> 24] ^ Te1[((S0) >> 16) & 0xFF] ^ Te2[((S1) >> 8) & 0xFF] ^ Te3[(S2) & 0xFF] ^ (RK)[3]; }
+
+// 一轮 T 表解密（等价逆密码），行移位方向相反
+#define AES_DEC_ROUND(T0, T1, T2, T3, S0, S1, S2, S3, RK) {                                        \
+    T0 = Td0[(S0) >> 24] ^ Td1[((S3) >> 16) & 0xFF] ^ Td2[((S2) >> 8) & 0xFF] ^ Td3[(S1) & 0xFF] ^ (RK)[0]; \
+    T1 = Td0[(S1) >> 24] ^ Td1[((S0) >> 16) & 0xFF] ^ Td2[((S3) >> 8) & 0xFF] ^ Td3[(S2) & 0xFF] ^ (RK)[1]; \
+    T2 = Td0[(S2) >> 24] ^ Td1[((S1) >> 16) & 0xFF] ^ Td2[((S0) >> 8) & 0xFF] ^ Td3[(S3) & 0xFF] ^ (RK)[2]; \
+    T3 = Td0[(S3) >> 24] ^ Td1[((S2) >> 16) & 0xFF] ^ Td2[((S1) >> 8) & 0xFF] ^ Td3[(S0) & 0xFF] ^ (RK)[3]; }
+
+// 最后一轮加密（无 MixColumns）的一列
+#define AES_ENC_LAST(S0, S1, S2, S3, K)                 \
+    ((((uint32_t)S_BOX[(S0) >> 24]) << 24) ^            \
+     (((uint32_t)S_BOX[((S1) >> 16) & 0xFF]) << 16) ^   \
+     (((uint32_t)S_BOX[((S2) >> 8) & 0xFF]) << 8) ^     \
+     ((uint32_t)S_BOX[(S3) & 0xFF]) ^ (K))
+
+// 最后一轮解密（无 InvMixColumns）的一列
+#define AES_DEC_LAST(S0, S1, S2, S3, K)                 \
+    ((((uint32_t)Td4[(S0) >> 24]) << 24) ^              \
+     (((uint32_t)Td4[((S1) >> 16) & 0xFF]) << 16) ^     \
+     (((uint32_t)Td4[((S2) >> 8) & 0xFF]) << 8) ^       \
+     ((uint32_t)Td4[(S3) & 0xFF]) ^ (K))
+
+// 字代换：对 32 位字的每个字节查 S 盒
+static inline uint32_t sub_word(uint32_t w) {
+    return ((uint32_t)S_BOX[w >> 24] << 24) | ((uint32_t)S_BOX[(w >> 16) & 0xFF] << 16) |
+           ((uint32_t)S_BOX[(w >> 8) & 0xFF] << 8) | (uint32_t)S_BOX[w & 0xFF];
+}
+
+// 常数时间的字代换与 InvMixColumns：位切片实现下密钥编排也不查表
+static inline uint32_t xtime_word(uint32_t w) {
+    return ((w & 0x7F7F7F7FU) << 1) ^ (((w >> 7) & 0x01010101U) * 0x1B);
+}
+
+static inline uint32_t rotl_word(uint32_t w, int n) {
+    return (w << n) | (w >> (32 - n));
+}
+
+static inline uint32_t inv_mix_column_word(uint32_t w) {
+    uint32_t w2 = xtime_word(w);
+    uint32_t w4 = xtime_word(w2);
+    uint32_t w8 = xtime_word(w4);
+    uint32_t w9 = w8 ^ w;
+    uint32_t wb = w9 ^ w2;
+    uint32_t wd = w9 ^ w4;
+    uint32_t we = w8 ^ w4 ^ w2;
+
+    // 列的第 0 行在最高字节：r0 = 0e*a0 ^ 0b*a1 ^ 0d*a2 ^ 09*a3
+    return we ^ rotl_word(wb, 8) ^ rotl_word(wd, 16) ^ rotl_word(w9, 24);
+}
+
+// 同一组轮密钥再按字节序存一份，AES-NI 直接装载；每个字算出后立即写两份，不再另走一遍
+#define AES_KS_PUT(KS, I, W) { (KS)->rk[I] = (W); PUTU32(&(KS)->rkb[0][0] + 4 * (I), (KS)->rk[I]); }
+
+// 按 32 位字扩展密钥，subw 决定字代换是否查表
+static inline __attribute__((always_inline))
+void aes_expand_key_words(const unsigned char *key, aes_key_schedule *ks, uint32_t (*subw)(uint32_t)) {
+    uint32_t *rk = ks->rk;
+    int nk = ks->rounds - 6;
+
+    for (int i = 0; i < nk; i++) {
+        rk[i] = GETU32(key + 4 * i);
+    }
+    memcpy(ks->rkb, key, 4 * nk);
+
+    if (nk == 4) {
+        // 128 位密钥每轮恰好 4 个字，直接按 32 位字扩展：W[i] = W[i-4] ^ SubWord(RotWord(W[i-1])) ^ Rcon
+        for (int i = 4; i < 4 * (AES_ROUNDS + 1); i += 4) {
+            uint32_t t = rk[i - 1];
+            AES_KS_PUT(ks, i, rk[i - 4] ^ subw((t << 8) | (t >> 24)) ^ ((uint32_t)RCON[i / 4] << 24));
+            AES_KS_PUT(ks, i + 1, rk[i - 3] ^ rk[i]);
+            AES_KS_PUT(ks, i + 2, rk[i - 2] ^ rk[i + 1]);
+            AES_KS_PUT(ks, i + 3, rk[i - 1] ^ rk[i + 2]);
+        }
+    } else {
+        // FIPS-197 通用扩展：每 Nk 个字做一次 RotWord/SubWord，256 位密钥在 i % Nk == 4 处额外 SubWord
+        for (int i = nk; i < 4 * (ks->rounds + 1); i++) {
+            uint32_t t = rk[i - 1];
+            if (i % nk == 0) {
+                t = subw((t << 8) | (t >> 24)) ^ ((uint32_t)RCON[i / nk] << 24);
+            } else if (nk > 6 && i % nk == 4) {
+                t = subw(t);
+            }
+            AES_KS_PUT(ks, i, rk[i - nk] ^ t);
+        }
+    }
+}
+
+// 各实现的密钥扩展：ks->rounds 已由调用者设置；解密编排由加密编排原地变换得到
+static void aes_make_enc_key_schedule_table(const unsigned char *key, aes_key_schedule *ks) {
+    aes_expand_key_words(key, ks, sub_word);
+}
+
+static void aes_make_dec_key_schedule_table(aes_key_schedule *ks) {
+    // 中间各轮密钥做 InvMixColumns：Td 表已含逆 S 盒，先查 S 盒抵消
+    for (int i = 4; i < 4 * ks->rounds; i++) {
+        uint32_t w = ks->rk[i];
+        AES_KS_PUT(ks, i, Td0[S_BOX[w >> 24]] ^ Td1[S_BOX[(w >> 16) & 0xFF]] ^
+                          Td2[S_BOX[(w >> 8) & 0xFF]] ^ Td3[S_BOX[w & 0xFF]]);
+    }
+}
+
+// 位切片实现下密钥编排也不查表
+static void aes_make_enc_key_schedule_bs(const unsigned char *key, aes_key_schedule *ks) {
+    aes_expand_key_words(key, ks, aes_bs_sub_word);
+}
+
+static void aes_make_dec_key_schedule_bs(aes_key_schedule *ks) {
+    for (int i = 4; i < 4 * ks->rounds; i++) {
+        AES_KS_PUT(ks, i, inv_mix_column_word(ks->rk[i]));
+    }
+}
+
+// AESKEYGENASSIST / AESIMC 直接生成字节序轮密钥，同时按字写出 T 表布局；指令本身也是常数时间的
+static void aes_make_enc_key_schedule_ni(const unsigned char *key, aes_key_schedule *ks) {
+    aes_ni_make_enc_key_schedule(key, ks->rounds, ks->rkb, ks->rk);
+}
+
+static void aes_make_dec_key_schedule_ni(aes_key_schedule *ks) {
+    aes_ni_make_dec_key_schedule((const unsigned char (*)[AES_BLOCK_SIZE])ks->rkb, ks->rounds, ks->rkb, ks->rk);
+}
+
+static void aes_backend_make_enc_key_schedule(const unsigned char *key, aes_key_schedule *ks);
+static void aes_backend_make_dec_key_schedule(aes_key_schedule *ks);
+
+int aes_make_enc_key_schedule(const unsigned char *key, size_t key_len, aes_key_schedule *ks) {
+    if (key_len != AES_KEY_SIZE && key_len != AES_192_KEY_SIZE && key_len != AES_256_KEY_SIZE) {
+        return 1;
+    }
+    ks->rounds = (int)(key_len / 4) + 6;
+    aes_backend_make_enc_key_schedule(key, ks);
+    return 0;
+}
+
+int aes_make_dec_key_schedule(const unsigned char *key, size_t key_len, aes_key_schedule *ks) {
+    if (aes_make_enc_key_schedule(key, key_len, ks) != 0) {
+        return 1;
+    }
+    aes_backend_make_dec_key_schedule(ks);
+    return 0;
+}
+
+int aes_make_dec_key_schedule_from_enc(const aes_key_schedule *enc, aes_key_schedule *dec) {
+    if (enc->rounds != 10 && enc->rounds != 12 && enc->rounds != 14) {
+        return 1;
+    }
+    if (dec != enc) {
+        *dec = *enc;
+    }
+    aes_backend_make_dec_key_schedule(dec);
+    return 0;
+}
+
+// 密钥未变时直接复用已有的编排；比较不提前退出
+static int aes_key_handle_same(const aes_key_handle *h, const unsigned char *key, size_t key_len) {
+    unsigned char diff = 0;
+
+    if (h->key_len != key_len) {
+        return 0;
+    }
+    for (size_t i = 0; i < key_len; i++) {
+        diff |= h->key[i] ^ key[i];
+    }
+    return diff == 0;
+}
+
+int aes_key_handle_init(aes_key_handle *h, const unsigned char *key, size_t key_len) {
+    if (aes_make_enc_key_schedule(key, key_len, &h->enc) != 0) {
+        memset(h, 0, sizeof(*h));
+        return 1;
+    }
+    memcpy(h->key, key, key_len);
+    h->key_len = key_len;
+    h->has_dec = 0;
+    return 0;
+}
+
+int aes_key_handle_rekey(aes_key_handle *h, const unsigned char *key, size_t key_len) {
+    if (aes_key_handle_same(h, key, key_len)) {
+        return 0;
+    }
+    return aes_key_handle_init(h, key, key_len);
+}
+
+const aes_key_schedule *aes_key_handle_enc(const aes_key_handle *h) {
+    return &h->enc;
+}
+
+const aes_key_schedule *aes_key_handle_dec(aes_key_handle *h) {
+    // 只有真正解密的流才付出 InvMixColumns 的代价，且只付一次
+    if (!h->has_dec) {
+        aes_make_dec_key_schedule_from_enc(&h->enc, &h->dec);
+        h->has_dec = 1;
+    }
+    return &h->dec;
+}
+
+int aes_key_handle_final(aes_key_handle *h) {
+    // 不留下密钥与编排
+    memset(h, 0, sizeof(*h));
+    return 0;
+}
+
+// 轮数为编译期常量时循环完全展开，状态始终保存在局部变量中；每种密钥长度各生成一份
+static inline __attribute__((always_inline))
+void aes_encrypt_rounds_table(const unsigned char *input, const uint32_t *rk, const int rounds, unsigned char *output) {
+    uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+
+    s0 = GETU32(input) ^ rk[0];
+    s1 = GETU32(input + 4) ^ rk[1];
+    s2 = GETU32(input + 8) ^ rk[2];
+    s3 = GETU32(input + 12) ^ rk[3];
+
+    AES_ENC_ROUND(t0, t1, t2, t3, s0, s1, s2, s3, rk + 4);
+    for (int r = 2; r < rounds; r += 2) {
+        AES_ENC_ROUND(s0, s1, s2, s3, t0, t1, t2, t3, rk + 4 * r);
+        AES_ENC_ROUND(t0, t1, t2, t3, s0, s1, s2, s3, rk + 4 * r + 4);
+    }
+
+    rk += 4 * rounds;
+    s0 = AES_ENC_LAST(t0, t1, t2, t3, rk[0]);
+    s1 = AES_ENC_LAST(t1, t2, t3, t0, rk[1]);
+    s2 = AES_ENC_LAST(t2, t3, t0, t1, rk[2]);
+    s3 = AES_ENC_LAST(t3, t0, t1, t2, rk[3]);
+
+    PUTU32(output, s0);
+    PUTU32(output + 4, s1);
+    PUTU32(output + 8, s2);
+    PUTU32(output + 12, s3);
+}
+
+static inline __attribute__((always_inline))
+void aes_decrypt_rounds_table(const unsigned char *input, const uint32_t *rk, const int rounds, unsigned char *output) {
+    uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+
+    s0 = GETU32(input) ^ rk[4 * rounds];
+    s1 = GETU32(input + 4) ^ rk[4 * rounds + 1];
+    s2 = GETU32(input + 8) ^ rk[4 * rounds + 2];
+    s3 = GETU32(input + 12) ^ rk[4 * rounds + 3];
+
+    // 轮密钥倒序使用
+    AES_DEC_ROUND(t0, t1, t2, t3, s0, s1, s2, s3, rk + 4 * (rounds - 1));
+    for (int r = rounds - 2; r > 0; r -= 2) {
+        AES_DEC_ROUND(s0, s1, s2, s3, t0, t1, t2, t3, rk + 4 * r);
+        AES_DEC_ROUND(t0, t1, t2, t3, s0, s1, s2, s3, rk + 4 * r - 4);
+    }
+
+    s0 = AES_DEC_LAST(t0, t3, t2, t1, rk[0]);
+    s1 = AES_DEC_LAST(t1, t0, t3, t2, rk[1]);
+    s2 = AES_DEC_LAST(t2, t1, t0, t3, rk[2]);
+    s3 = AES_DEC_LAST(t3, t2, t1, t0, rk[3]);
+
+    PUTU32(output, s0);
+    PUTU32(output + 4, s1);
+    PUTU32(output + 8, s2);
+    PUTU32(output + 12, s3);
+}
+
+static void aes_encrypt_block_ks_table(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output) {
+    switch (ks->rounds) {
+    case 12:
+        aes_encrypt_rounds_table(input, ks->rk, 12, output);
+        break;
+    case 14:
+        aes_encrypt_rounds_table(input, ks->rk, 14, output);
+        break;
+    default:
+        aes_encrypt_rounds_table(input, ks->rk, AES_ROUNDS, output);
+        break;
+    }
+}
+
+static void aes_decrypt_block_ks_table(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output) {
+    switch (ks->rounds) {
+    case 12:
+        aes_decrypt_rounds_table(input, ks->rk, 12, output);
+        break;
+    case 14:
+        aes_decrypt_rounds_table(input, ks->rk, 14, output);
+        break;
+    default:
+        aes_decrypt_rounds_table(input, ks->rk, AES_ROUNDS, output);
+        break;
+    }
+}
+
+
+// 逐块处理：相邻分组互不依赖，乱序执行本身就能重叠它们的查表访存延迟；
+// 按轮交错 4 个状态反而因寄存器不足而溢出到栈上，实测更慢
+static inline __attribute__((always_inline))
+void aes_ecb_encrypt_rounds_table(const unsigned char *input, unsigned char *output, size_t nblocks,
+                                  const uint32_t *rk, const int rounds) {
+    for (; nblocks > 0; nblocks--) {
+        aes_encrypt_rounds_table(input, rk, rounds, output);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+}
+
+static inline __attribute__((always_inline))
+void aes_ecb_decrypt_rounds_table(const unsigned char *input, unsigned char *output, size_t nblocks,
+                                  const uint32_t *rk, const int rounds) {
+    for (; nblocks > 0; nblocks--) {
+        aes_decrypt_rounds_table(input, rk, rounds, output);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+}
+
+static void aes_ecb_encrypt_table(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks) {
+    switch (ks->rounds) {
+    case 12:
+        aes_ecb_encrypt_rounds_table(input, output, nblocks, ks->rk, 12);
+        break;
+    case 14:
+        aes_ecb_encrypt_rounds_table(input, output, nblocks, ks->rk, 14);
+        break;
+    default:
+        aes_ecb_encrypt_rounds_table(input, output, nblocks, ks->rk, AES_ROUNDS);
+        break;
+    }
+}
+
+static void aes_ecb_decrypt_table(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks) {
+    switch (ks->rounds) {
+    case 12:
+        aes_ecb_decrypt_rounds_table(input, output, nblocks, ks->rk, 12);
+        break;
+    case 14:
+        aes_ecb_decrypt_rounds_table(input, output, nblocks, ks->rk, 14);
+        break;
+    default:
+        aes_ecb_decrypt_rounds_table(input, output, nblocks, ks->rk, AES_ROUNDS);
+        break;
+    }
+}
+
+
+int aes_has_aesni(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") ? 1 : 0;
+}
+
+static int aes_always_supported(void) {
+    return 1;
+}
+
+// 旧接口的 11x16 子密钥与 rkb 的前 11 个轮密钥布局相同，没有专用扩展的实现经由密钥编排生成
+static int aes_make_enc_subkeys_ks(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]) {
+    aes_key_schedule ks;
+
+    if (aes_make_enc_key_schedule(key, AES_KEY_SIZE, &ks) != 0) {
+        return 1;
+    }
+    memcpy(subKeys, ks.rkb, AES_EXPANDED_KEY_SIZE);
+    return 0;
+}
+
+static int aes_make_dec_subkeys_ks(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]) {
+    aes_key_schedule ks;
+
+    if (aes_make_dec_key_schedule(key, AES_KEY_SIZE, &ks) != 0) {
+        return 1;
+    }
+    memcpy(subKeys, ks.rkb, AES_EXPANDED_KEY_SIZE);
+    return 0;
+}
+
+static int aes_make_dec_subkeys_ni(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]) {
+    // AESIMC 原地变换，不需要临时的加密子密钥
+    aes_ni_make_enc_subkeys(key, subKeys);
+    aes_ni_make_dec_subkeys(subKeys, subKeys);
+    return 0;
+}
+
+static int aes_make_enc_subkeys_ni(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]) {
+    aes_ni_make_enc_subkeys(key, subKeys);
+    return 0;
+}
+
+// 各实现按字节序轮密钥工作的入口，适配成统一的函数签名
+#define AES_SUBKEYS(K) ((const unsigned char (*)[AES_BLOCK_SIZE])(K))
+
+static void aes_encrypt_block_ni(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
+    aes_ni_encrypt_block(input, AES_SUBKEYS(subKeys), AES_ROUNDS, output);
+}
+
+static void aes_decrypt_block_ni(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
+    aes_ni_decrypt_block(input, AES_SUBKEYS(subKeys), AES_ROUNDS, output);
+}
+
+static void aes_encrypt_block_ks_ni(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output) {
+    aes_ni_encrypt_block(input, ks->rkb, ks->rounds, output);
+}
+
+static void aes_decrypt_block_ks_ni(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output) {
+    aes_ni_decrypt_block(input, ks->rkb, ks->rounds, output);
+}
+
+static void aes_ecb_encrypt_ni(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks) {
+    aes_ni_ecb_encrypt(input, output, nblocks, ks->rkb, ks->rounds);
+}
+
+static void aes_ecb_decrypt_ni(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks) {
+    aes_ni_ecb_decrypt(input, output, nblocks, ks->rkb, ks->rounds);
+}
+
+static void aes_encrypt_block_bs(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
+    aes_bs_ecb_encrypt(input, output, 1, AES_SUBKEYS(subKeys), AES_ROUNDS);
+}
+
+static void aes_decrypt_block_bs(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
+    aes_bs_ecb_decrypt(input, output, 1, AES_SUBKEYS(subKeys), AES_ROUNDS);
+}
+
+static void aes_encrypt_block_ks_bs(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output) {
+    aes_bs_ecb_encrypt(input, output, 1, ks->rkb, ks->rounds);
+}
+
+static void aes_decrypt_block_ks_bs(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output) {
+    aes_bs_ecb_decrypt(input, output, 1, ks->rkb, ks->rounds);
+}
+
+static void aes_ecb_encrypt_bs(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks) {
+    aes_bs_ecb_encrypt(input, output, nblocks, ks->rkb, ks->rounds);
+}
+
+static void aes_ecb_decrypt_bs(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks) {
+    aes_bs_ecb_decrypt(input, output, nblocks, ks->rkb, ks->rounds);
+}
+
+static void aes_encrypt_block_ref(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
+    aes_ref_encrypt_block(input, AES_SUBKEYS(subKeys), AES_ROUNDS, output);
+}
+
+static void aes_decrypt_block_ref(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
+    aes_ref_decrypt_block(input, AES_SUBKEYS(subKeys), AES_ROUNDS, output);
+}
+
+static void aes_encrypt_block_ks_ref(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output) {
+    aes_ref_encrypt_block(input, ks->rkb, ks->rounds, output);
+}
+
+static void aes_decrypt_block_ks_ref(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output) {
+    aes_ref_decrypt_block(input, ks->rkb, ks->rounds, output);
+}
+
+static void aes_ecb_encrypt_ref(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks) {
+    for (size_t i = 0; i < nblocks; i++) {
+        aes_ref_encrypt_block(input + i * AES_BLOCK_SIZE, ks->rkb, ks->rounds, output + i * AES_BLOCK_SIZE);
+    }
+}
+
+static void aes_ecb_decrypt_ref(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks) {
+    for (size_t i = 0; i < nblocks; i++) {
+        aes_ref_decrypt_block(input + i * AES_BLOCK_SIZE, ks->rkb, ks->rounds, output + i * AES_BLOCK_SIZE);
+    }
+}
+
+// 后端注册表：每个实现提供同一组入口，aes_set_impl 只切换当前表项
+typedef struct {
+    aes_impl impl;
+    const char *name;
+    int (*supported)(void);
+    void (*make_enc_key_schedule)(const unsigned char *key, aes_key_schedule *ks); /* ks->rounds 已设置 */
+    void (*make_dec_key_schedule)(aes_key_schedule *ks);                          /* 由加密编排原地变换 */
+    int (*make_enc_subkeys)(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]);
+    int (*make_dec_subkeys)(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]);
+    void (*encrypt_block)(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output);
+    void (*decrypt_block)(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output);
+    void (*encrypt_block_ks)(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output);
+    void (*decrypt_block_ks)(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output);
+    void (*ecb_encrypt)(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks);
+    void (*ecb_decrypt)(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks);
+} aes_backend;
+
+static const aes_backend aes_backends[] = {
+    { AES_IMPL_TABLE, "T-table", aes_always_supported,
+      aes_make_enc_key_schedule_table, aes_make_dec_key_schedule_table,
+      aes_make_enc_subkeys_ks, aes_make_dec_subkeys_ks,
+      aes_encrypt_block_table, aes_decrypt_block_table,
+      aes_encrypt_block_ks_table, aes_decrypt_block_ks_table,
+      aes_ecb_encrypt_table, aes_ecb_decrypt_table },
+    { AES_IMPL_AESNI, "AES-NI", aes_has_aesni,
+      aes_make_enc_key_schedule_ni, aes_make_dec_key_schedule_ni,
+      aes_make_enc_subkeys_ni, aes_make_dec_subkeys_ni,
+      aes_encrypt_block_ni, aes_decrypt_block_ni,
+      aes_encrypt_block_ks_ni, aes_decrypt_block_ks_ni,
+      aes_ecb_encrypt_ni, aes_ecb_decrypt_ni },
+    { AES_IMPL_BITSLICE, "Bitsliced", aes_always_supported,
+      aes_make_enc_key_schedule_bs, aes_make_dec_key_schedule_bs,
+      aes_make_enc_subkeys_ks, aes_make_dec_subkeys_ks,
+      aes_encrypt_block_bs, aes_decrypt_block_bs,
+      aes_encrypt_block_ks_bs, aes_decrypt_block_ks_bs,
+      aes_ecb_encrypt_bs, aes_ecb_decrypt_bs },
+    { AES_IMPL_REFERENCE, "Reference", aes_always_supported,
+      aes_make_enc_key_schedule_table, aes_make_dec_key_schedule_table,
+      aes_make_enc_subkeys_ks, aes_make_dec_subkeys_ks,
+      aes_encrypt_block_ref, aes_decrypt_block_ref,
+      aes_encrypt_block_ks_ref, aes_decrypt_block_ks_ref,
+      aes_ecb_encrypt_ref, aes_ecb_decrypt_ref },
+};
+
+// 当前使用的实现，首次调用时按 CPUID 确定
+static const aes_backend *aes_active = NULL;
+
+static const aes_backend *aes_find_backend(aes_impl impl) {
+    for (size_t i = 0; i < sizeof(aes_backends) / sizeof(aes_backends[0]); i++) {
+        if (aes_backends[i].impl == impl) {
+            return &aes_backends[i];
+        }
+    }
+    return NULL;
+}
+
+// 首次调用可能同时来自多个线程：指针原子读写，几个线程并发解析 AUTO 得到的是同一表项
+static inline const aes_backend *aes_backend_active(void) {
+    const aes_backend *backend = __atomic_load_n(&aes_active, __ATOMIC_ACQUIRE);
+    if (backend == NULL) {
+        aes_set_impl(AES_IMPL_AUTO);
+        backend = __atomic_load_n(&aes_active, __ATOMIC_ACQUIRE);
+    }
+    return backend;
+}
+
+static void aes_backend_make_enc_key_schedule(const unsigned char *key, aes_key_schedule *ks) {
+    aes_backend_active()->make_enc_key_schedule(key, ks);
+}
+
+static void aes_backend_make_dec_key_schedule(aes_key_schedule *ks) {
+    aes_backend_active()->make_dec_key_schedule(ks);
+}
+
+int aes_impl_supported(aes_impl impl) {
+    const aes_backend *backend = aes_find_backend(impl);
+    return backend != NULL && backend->supported();
+}
+
+const char *aes_impl_name(aes_impl impl) {
+    const aes_backend *backend = aes_find_backend(impl);
+    return backend != NULL ? backend->name : "Auto";
+}
+
+int aes_set_impl(aes_impl impl) {
+    if (impl == AES_IMPL_AUTO) {
+        // 与 SM4 一致：位切片实现串行模式（CFB 加密、CBC 加密）下仍比 T 表慢数倍，需要常数时间时显式选择
+        impl = aes_has_aesni() ? AES_IMPL_AESNI : AES_IMPL_TABLE;
+    }
+    if (!aes_impl_supported(impl)) {
+        return 1;
+    }
+
+    __atomic_store_n(&aes_active, aes_find_backend(impl), __ATOMIC_RELEASE);
+    return 0;
+}
+
+aes_impl aes_get_impl(void) {
+    return aes_backend_active()->impl;
+}
+
+int aes_make_enc_subkeys(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]) {
+    return aes_backend_active()->make_enc_subkeys(key, subKeys);
+}
+
+int aes_make_dec_subkeys(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]) {
+    return aes_backend_active()->make_dec_subkeys(key, subKeys);
+}
+
+void aes_encrypt_block(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
+    aes_backend_active()->encrypt_block(input, subKeys, output);
+}
+
+void aes_decrypt_block(const unsigned char *input, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE], unsigned char *output) {
+    aes_backend_active()->decrypt_block(input, subKeys, output);
+}
+
+void aes_encrypt_block_ks(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output) {
+    aes_backend_active()->encrypt_block_ks(input, ks, output);
+}
+
+void aes_decrypt_block_ks(const unsigned char *input, const aes_key_schedule *ks, unsigned char *output) {
+    aes_backend_active()->decrypt_block_ks(input, ks, output);
+}
+
+void aes_ecb_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks) {
+    aes_backend_active()->ecb_encrypt(input, output, nblocks, ks);
+}
+
+void aes_ecb_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks, const aes_key_schedule *ks) {
+    aes_backend_active()->ecb_decrypt(input, output, nblocks, ks);
+}
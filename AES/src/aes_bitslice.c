@@ -0,0 +1,210 @@
+#include "../inc/aes_bitslice.h"
+#include <string.h>
+
+/*
+ * 位切片（bitslice）AES，按 BearSSL aes_ct64 的布局：每个 64 位通道装 4 个分组，
+ * 8 个切片字 q[0..7] 依次保存所有字节的第 0..7 位。S 盒用 Boyar-Peralta 的 113 门布尔电路计算，
+ * ShiftRows / MixColumns 只是切片字内的移位与异或，整个过程没有查表，也没有依赖密钥或数据的分支。
+ */
+
+// 切片字：SSE2/AVX2 下一次处理 8/16 个分组
+#if defined(__AVX2__)
+#define AES_BS_LANES 4
+#elif defined(__SSE2__)
+#define AES_BS_LANES 2
+#else
+#define AES_BS_LANES 1
+#endif
+
+typedef uint64_t bs_word __attribute__((vector_size(8 * AES_BS_LANES)));
+
+#define AES_BS_BLOCKS (4 * AES_BS_LANES)
+
+// 核心运算实例化两份：aes_bs_* 处理一整批宽向量，aes_bs1_* 只用一个 uint64_t（4 个分组）
+#define AES_BS_WORD bs_word
+#define AES_BS_FN(name) aes_bs_##name
+#include "../inc/aes_bitslice_core.h"
+#undef AES_BS_FN
+#undef AES_BS_WORD
+
+#define AES_BS_WORD uint64_t
+#define AES_BS_FN(name) aes_bs1_##name
+#include "../inc/aes_bitslice_core.h"
+#undef AES_BS_FN
+#undef AES_BS_WORD
+
+// 不超过 4 块时只走窄的标量通道，单块调用（CFB/CBC 等串行模式）不必补零算满一整批
+#define AES_BS1_BLOCKS 4
+
+static inline uint32_t load_le32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void store_le32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+// 一个分组的 4 个小端字按字节交错到两个 64 位字中，ortho 之后每个切片字的 16 位对应一行
+static inline void aes_bs_interleave_in(uint64_t *q0, uint64_t *q1, const unsigned char *block) {
+    uint64_t x[4];
+
+    for (int i = 0; i < 4; i++) {
+        x[i] = load_le32(block + 4 * i);
+        x[i] |= x[i] << 16;
+        x[i] &= 0x0000FFFF0000FFFFULL;
+        x[i] |= x[i] << 8;
+        x[i] &= 0x00FF00FF00FF00FFULL;
+    }
+    *q0 = x[0] | (x[2] << 8);
+    *q1 = x[1] | (x[3] << 8);
+}
+
+static inline void aes_bs_interleave_out(unsigned char *block, uint64_t q0, uint64_t q1) {
+    uint64_t x[4];
+
+    x[0] = q0 & 0x00FF00FF00FF00FFULL;
+    x[1] = q1 & 0x00FF00FF00FF00FFULL;
+    x[2] = (q0 >> 8) & 0x00FF00FF00FF00FFULL;
+    x[3] = (q1 >> 8) & 0x00FF00FF00FF00FFULL;
+    for (int i = 0; i < 4; i++) {
+        x[i] |= x[i] >> 8;
+        x[i] &= 0x0000FFFF0000FFFFULL;
+        store_le32(block + 4 * i, (uint32_t)x[i] | (uint32_t)(x[i] >> 16));
+    }
+}
+
+// 第 b 个分组放在通道 b / 4 的第 b % 4 个位置；不足一批时其余分组补零
+static void aes_bs_load(bs_word *q, const unsigned char *input, size_t nblocks) {
+    static const unsigned char zero[AES_BLOCK_SIZE];
+
+    for (size_t b = 0; b < AES_BS_BLOCKS; b++) {
+        uint64_t q0, q1;
+        aes_bs_interleave_in(&q0, &q1, b < nblocks ? input + b * AES_BLOCK_SIZE : zero);
+        q[b % 4][b / 4] = q0;
+        q[b % 4 + 4][b / 4] = q1;
+    }
+    aes_bs_ortho(q);
+}
+
+static void aes_bs_store(unsigned char *output, bs_word *q, size_t nblocks) {
+    aes_bs_ortho(q);
+    for (size_t b = 0; b < nblocks; b++) {
+        aes_bs_interleave_out(output + b * AES_BLOCK_SIZE, q[b % 4][b / 4], q[b % 4 + 4][b / 4]);
+    }
+}
+
+static void aes_bs1_load(uint64_t *q, const unsigned char *input, size_t nblocks) {
+    static const unsigned char zero[AES_BLOCK_SIZE];
+
+    for (size_t b = 0; b < AES_BS1_BLOCKS; b++) {
+        aes_bs_interleave_in(&q[b], &q[b + 4], b < nblocks ? input + b * AES_BLOCK_SIZE : zero);
+    }
+    aes_bs1_ortho(q);
+}
+
+static void aes_bs1_store(unsigned char *output, uint64_t *q, size_t nblocks) {
+    aes_bs1_ortho(q);
+    for (size_t b = 0; b < nblocks; b++) {
+        aes_bs_interleave_out(output + b * AES_BLOCK_SIZE, q[b], q[b + 4]);
+    }
+}
+
+// 轮密钥在 4 个分组位置上各放一份，转成切片形式
+static void aes_bs1_round_keys(uint64_t (*sk)[8], const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds) {
+    for (int r = 0; r <= rounds; r++) {
+        uint64_t q0, q1;
+        aes_bs_interleave_in(&q0, &q1, subKeys[r]);
+        for (int i = 0; i < 4; i++) {
+            sk[r][i] = q0;
+            sk[r][i + 4] = q1;
+        }
+        aes_bs1_ortho(sk[r]);
+    }
+}
+
+// 宽通道的轮密钥：标量上转好再广播到每个通道，比逐元素插入后做宽向量转置快得多
+static void aes_bs_round_keys(bs_word (*sk)[8], const uint64_t (*sk1)[8], int rounds) {
+    for (int r = 0; r <= rounds; r++) {
+        for (int i = 0; i < 8; i++) {
+            sk[r][i] = (bs_word){0} + sk1[r][i];
+        }
+    }
+}
+
+void aes_bs_ecb_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds) {
+    uint64_t sk1[AES_MAX_ROUNDS + 1][8];
+    bs_word sk[AES_MAX_ROUNDS + 1][8];
+    uint64_t q1[8];
+    bs_word q[8];
+
+    aes_bs1_round_keys(sk1, subKeys, rounds);
+    if (nblocks > AES_BS1_BLOCKS) {
+        aes_bs_round_keys(sk, (const uint64_t (*)[8])sk1, rounds);
+    }
+
+    while (nblocks > AES_BS1_BLOCKS) {
+        size_t n = nblocks < AES_BS_BLOCKS ? nblocks : AES_BS_BLOCKS;
+
+        aes_bs_load(q, input, n);
+        aes_bs_encrypt_rounds(q, (const bs_word (*)[8])sk, rounds);
+        aes_bs_store(output, q, n);
+
+        input += n * AES_BLOCK_SIZE;
+        output += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+    if (nblocks > 0) {
+        aes_bs1_load(q1, input, nblocks);
+        aes_bs1_encrypt_rounds(q1, (const uint64_t (*)[8])sk1, rounds);
+        aes_bs1_store(output, q1, nblocks);
+    }
+}
+
+void aes_bs_ecb_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds) {
+    uint64_t sk1[AES_MAX_ROUNDS + 1][8];
+    bs_word sk[AES_MAX_ROUNDS + 1][8];
+    uint64_t q1[8];
+    bs_word q[8];
+
+    aes_bs1_round_keys(sk1, subKeys, rounds);
+    if (nblocks > AES_BS1_BLOCKS) {
+        aes_bs_round_keys(sk, (const uint64_t (*)[8])sk1, rounds);
+    }
+
+    while (nblocks > AES_BS1_BLOCKS) {
+        size_t n = nblocks < AES_BS_BLOCKS ? nblocks : AES_BS_BLOCKS;
+
+        aes_bs_load(q, input, n);
+        aes_bs_decrypt_rounds(q, (const bs_word (*)[8])sk, rounds);
+        aes_bs_store(output, q, n);
+
+        input += n * AES_BLOCK_SIZE;
+        output += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+    if (nblocks > 0) {
+        aes_bs1_load(q1, input, nblocks);
+        aes_bs1_decrypt_rounds(q1, (const uint64_t (*)[8])sk1, rounds);
+        aes_bs1_store(output, q1, nblocks);
+    }
+}
+
+uint32_t aes_bs_sub_word(uint32_t w) {
+    uint64_t q[8];
+    uint32_t r = 0;
+
+    // 不做转置：4 个字节的第 i 位落在 q[i] 的第 0、8、16、24 位
+    for (int i = 0; i < 8; i++) {
+        q[i] = (w >> i) & 0x01010101U;
+    }
+    aes_bs1_sbox(q);
+    for (int i = 0; i < 8; i++) {
+        r |= ((uint32_t)q[i] & 0x01010101U) << i;
+    }
+    return r;
+}
@@ -1,94 +1,134 @@
 #include "aes_cfb.h"
 #include <string.h>
 
-int aes_cfb_encrypt(const unsigned char *plaintext, size_t plaintext_len,
-                   const unsigned char key[AES_KEY_SIZE],
-                   const unsigned char iv[AES_BLOCK_SIZE],
-                   unsigned char *ciphertext) {
-    unsigned char feedback[AES_BLOCK_SIZE];
-    unsigned char encryptedBlock[AES_BLOCK_SIZE];
-    unsigned char encSubKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE];
-    size_t i, j;
-    size_t remaining;
-
-    // 生成加密子密钥
-    if (aes_make_enc_subkeys(key, encSubKeys) != 0) {
+// 解密批处理的分组数：整批交给 aes_ecb_encrypt，AES-NI 内部按 8 块交错、位切片按 8/16 块一批，查表逐块处理
+#define AES_CFB_BATCH 32
+
+static inline void xor_block(unsigned char *out, const unsigned char *a, const unsigned char *b, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+int aes_cfb_init(aes_cfb_ctx *ctx, const unsigned char *key, size_t key_len,
+                 const unsigned char iv[AES_BLOCK_SIZE], int decrypt) {
+    if (aes_make_enc_key_schedule(key, key_len, &ctx->ks) != 0) {
         return 1;
     }
 
     // 初始化反馈寄存器为IV
-    memcpy(feedback, iv, AES_BLOCK_SIZE);
+    memcpy(ctx->iv, iv, AES_BLOCK_SIZE);
+    ctx->num = 0;
+    ctx->decrypt = decrypt;
+    return 0;
+}
 
-    // 分块处理数据
-    for (i = 0; i < plaintext_len; i += AES_BLOCK_SIZE) {
-        // 加密
-        aes_encrypt_block(feedback, encSubKeys, encryptedBlock);
+// 加密：每个密文分组是下一分组的输入，只能串行
+static void aes_cfb_encrypt_blocks(aes_cfb_ctx *ctx, const unsigned char *input, unsigned char *output, size_t nblocks) {
+    for (size_t i = 0; i < nblocks; i++) {
+        aes_encrypt_block_ks(ctx->iv, &ctx->ks, ctx->iv);
+        xor_block(ctx->iv, ctx->iv, input + i * AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+        memcpy(output + i * AES_BLOCK_SIZE, ctx->iv, AES_BLOCK_SIZE);
+    }
+}
 
-        // 计算当前块还剩下多少字节
-        remaining = plaintext_len - i;
-        if (remaining > AES_BLOCK_SIZE) {
-            remaining = AES_BLOCK_SIZE;
-        }
+// 解密：分组密码的输入是 IV 与前面的密文，全部已知，整批加密后再异或
+static void aes_cfb_decrypt_blocks(aes_cfb_ctx *ctx, const unsigned char *input, unsigned char *output, size_t nblocks) {
+    unsigned char stream[AES_CFB_BATCH * AES_BLOCK_SIZE];
 
-        // 与明文异或生成密文
-        for (j = 0; j < remaining; j++) {
-            ciphertext[i + j] = plaintext[i + j] ^ encryptedBlock[j];
+    while (nblocks > 0) {
+        size_t n = nblocks < AES_CFB_BATCH ? nblocks : AES_CFB_BATCH;
+
+        memcpy(stream, ctx->iv, AES_BLOCK_SIZE);
+        memcpy(stream + AES_BLOCK_SIZE, input, (n - 1) * AES_BLOCK_SIZE);
+        // 原地解密时最后一块密文会被覆盖，先保存为下一批的反馈
+        memcpy(ctx->iv, input + (n - 1) * AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+
+        aes_ecb_encrypt(stream, stream, n, &ctx->ks);
+        xor_block(output, input, stream, n * AES_BLOCK_SIZE);
+
+        input += n * AES_BLOCK_SIZE;
+        output += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+}
+
+int aes_cfb_update(aes_cfb_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len) {
+    size_t n = ctx->num;
+    size_t nblocks;
+
+    // 先补齐上次剩下的不完整分组：iv 中是密钥流，逐字节换成密文
+    while (n != 0 && len > 0) {
+        unsigned char c = *input++;
+        if (ctx->decrypt) {
+            *output++ = ctx->iv[n] ^ c;
+            ctx->iv[n] = c;
+        } else {
+            *output++ = ctx->iv[n] ^= c;
         }
+        n = (n + 1) % AES_BLOCK_SIZE;
+        len--;
+    }
 
-        // 更新反馈寄存器
-        if (remaining == AES_BLOCK_SIZE) {
-            memcpy(feedback, ciphertext + i, AES_BLOCK_SIZE);
+    nblocks = len / AES_BLOCK_SIZE;
+    if (nblocks > 0) {
+        if (ctx->decrypt) {
+            aes_cfb_decrypt_blocks(ctx, input, output, nblocks);
         } else {
-            // 最后一个不完整块的处理
-            memcpy(feedback, ciphertext + i, remaining);
+            aes_cfb_encrypt_blocks(ctx, input, output, nblocks);
+        }
+        input += nblocks * AES_BLOCK_SIZE;
+        output += nblocks * AES_BLOCK_SIZE;
+        len -= nblocks * AES_BLOCK_SIZE;
+    }
+
+    // 尾部不足一块：生成密钥流，已用的字节换成密文，剩余的留给下次调用
+    if (len > 0) {
+        aes_encrypt_block_ks(ctx->iv, &ctx->ks, ctx->iv);
+        for (; n < len; n++) {
+            unsigned char c = input[n];
+            if (ctx->decrypt) {
+                output[n] = ctx->iv[n] ^ c;
+                ctx->iv[n] = c;
+            } else {
+                output[n] = ctx->iv[n] ^= c;
+            }
         }
     }
 
+    ctx->num = n;
     return 0;
 }
 
-int aes_cfb_decrypt(const unsigned char *ciphertext, size_t ciphertext_len,
+int aes_cfb_final(aes_cfb_ctx *ctx) {
+    // 不留下密钥编排与反馈寄存器
+    memset(ctx, 0, sizeof(*ctx));
+    return 0;
+}
+
+int aes_cfb_encrypt(const unsigned char *plaintext, size_t plaintext_len,
                    const unsigned char key[AES_KEY_SIZE],
                    const unsigned char iv[AES_BLOCK_SIZE],
-                   unsigned char *plaintext) {
-    unsigned char feedback[AES_BLOCK_SIZE];
-    unsigned char encryptedBlock[AES_BLOCK_SIZE];
-    unsigned char encSubKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE];
-    size_t i, j;
-    size_t remaining;
-
-    // 生成加密子密钥（CFB解密也使用加密子密钥）
-    if (aes_make_enc_subkeys(key, encSubKeys) != 0) {
+                   unsigned char *ciphertext) {
+    aes_cfb_ctx ctx;
+
+    // 一次性接口：每次调用都要重新生成密钥编排，反复加密短消息请改用上下文接口
+    if (aes_cfb_init(&ctx, key, AES_KEY_SIZE, iv, 0) != 0 ||
+        aes_cfb_update(&ctx, plaintext, ciphertext, plaintext_len) != 0) {
         return 1;
     }
+    return aes_cfb_final(&ctx);
+}
 
-    // 初始化反馈寄存器为IV
-    memcpy(feedback, iv, AES_BLOCK_SIZE);
-
-    // 分块处理数据
-    for (i = 0; i < ciphertext_len; i += AES_BLOCK_SIZE) {
-        // 加密
-        aes_encrypt_block(feedback, encSubKeys, encryptedBlock);
-
-        // 计算当前块还有多少字节
-        remaining = ciphertext_len - i;
-        if (remaining > AES_BLOCK_SIZE) {
-            remaining = AES_BLOCK_SIZE;
-        }
-
-        // 与密文异或生成明文
-        for (j = 0; j < remaining; j++) {
-            plaintext[i + j] = ciphertext[i + j] ^ encryptedBlock[j];
-        }
+int aes_cfb_decrypt(const unsigned char *ciphertext, size_t ciphertext_len,
+                   const unsigned char key[AES_KEY_SIZE],
+                   const unsigned char iv[AES_BLOCK_SIZE],
+                   unsigned char *plaintext) {
+    aes_cfb_ctx ctx;
 
-        // 更新反馈寄存器
-        if (remaining == AES_BLOCK_SIZE) {
-            memcpy(feedback, ciphertext + i, AES_BLOCK_SIZE);
-        } else {
-            // 最后一个不完整块的处理
-            memcpy(feedback, ciphertext + i, remaining);
-        }
+    if (aes_cfb_init(&ctx, key, AES_KEY_SIZE, iv, 1) != 0 ||
+        aes_cfb_update(&ctx, ciphertext, plaintext, ciphertext_len) != 0) {
+        return 1;
     }
-
-    return 0;
+    return aes_cfb_final(&ctx);
 }
@@ -0,0 +1,123 @@
+#include "aes_ctr.h"
+#include <string.h>
+
+// 每批生成的计数器块数：整批交给 aes_ecb_encrypt，AES-NI 内部按 8 块交错、位切片按 8/16 块一批，查表逐块处理
+#define AES_CTR_BATCH 32
+
+// 按 64 位字异或，尾部逐字节
+static inline void xor_block(unsigned char *out, const unsigned char *a, const unsigned char *b, size_t len) {
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        x ^= y;
+        memcpy(out + i, &x, 8);
+    }
+    for (; i < len; i++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+static inline uint64_t load_be64(const unsigned char *p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+// 计数器按大端写入计数器块末尾
+static inline void store_counter(unsigned char *p, uint64_t v, int counter_bits) {
+    if (counter_bits == 32) {
+        uint32_t w = __builtin_bswap32((uint32_t)v);
+        memcpy(p + AES_BLOCK_SIZE - 4, &w, 4);
+    } else {
+        v = __builtin_bswap64(v);
+        memcpy(p + AES_BLOCK_SIZE - 8, &v, 8);
+    }
+}
+
+int aes_ctr_crypt(const unsigned char *input, unsigned char *output, size_t len,
+                  const aes_key_schedule *ks, const unsigned char iv[AES_BLOCK_SIZE],
+                  int counter_bits, uint64_t offset) {
+    unsigned char counters[AES_CTR_BATCH * AES_BLOCK_SIZE];
+    unsigned char stream[AES_CTR_BATCH * AES_BLOCK_SIZE];
+    uint64_t mask, base, block;
+    size_t skip;
+
+    if (counter_bits != 32 && counter_bits != 64) {
+        return 1;
+    }
+    if (len == 0) {
+        return 0;
+    }
+    mask = counter_bits == 64 ? UINT64_MAX : 0xFFFFFFFFULL;
+
+    // 用到的最后一个分组号超出计数器范围时，计数器回绕会重复使用密钥流
+    if ((uint64_t)len - 1 > UINT64_MAX - offset || (offset + (len - 1)) / AES_BLOCK_SIZE > mask) {
+        return 1;
+    }
+
+    base = load_be64(iv + AES_BLOCK_SIZE - 8) & mask;
+    block = offset / AES_BLOCK_SIZE;
+    skip = offset % AES_BLOCK_SIZE;
+
+    // 计数器块的前缀（nonce）在整个调用中不变，只填一次
+    for (int i = 0; i < AES_CTR_BATCH; i++) {
+        memcpy(counters + i * AES_BLOCK_SIZE, iv, AES_BLOCK_SIZE);
+    }
+
+    while (len > 0) {
+        // 本批覆盖的字节数：首批从分组内偏移 skip 开始
+        size_t bytes = sizeof(stream) - skip;
+        if (bytes > len) {
+            bytes = len;
+        }
+        size_t n = (skip + bytes + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+
+        // 计数器块 = IV 的前缀 || (base + 分组号) mod 2^counter_bits
+        for (size_t i = 0; i < n; i++) {
+            store_counter(counters + i * AES_BLOCK_SIZE, (base + block + i) & mask, counter_bits);
+        }
+        aes_ecb_encrypt(counters, stream, n, ks);
+
+        xor_block(output, input, stream + skip, bytes);
+
+        input += bytes;
+        output += bytes;
+        len -= bytes;
+        block += n;
+        skip = 0;
+    }
+
+    return 0;
+}
+
+int aes_ctr_init(aes_ctr_ctx *ctx, const unsigned char *key, size_t key_len,
+                 const unsigned char iv[AES_BLOCK_SIZE], int counter_bits) {
+    if (counter_bits != 32 && counter_bits != 64) {
+        return 1;
+    }
+    if (aes_make_enc_key_schedule(key, key_len, &ctx->ks) != 0) {
+        return 1;
+    }
+
+    memcpy(ctx->iv, iv, AES_BLOCK_SIZE);
+    ctx->counter_bits = counter_bits;
+    ctx->offset = 0;
+    return 0;
+}
+
+void aes_ctr_seek(aes_ctr_ctx *ctx, uint64_t offset) {
+    ctx->offset = offset;
+}
+
+int aes_ctr_update(aes_ctr_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len) {
+    if (aes_ctr_crypt(input, output, len, &ctx->ks, ctx->iv, ctx->counter_bits, ctx->offset) != 0) {
+        return 1;
+    }
+
+    ctx->offset += len;
+    return 0;
+}
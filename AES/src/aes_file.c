@@ -0,0 +1,424 @@
+#define _GNU_SOURCE
+#include "aes_file.h"
+#include "aes_ctr.h"
+#include "aes_gcm.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 流式处理的尾部保留量：非最后一段只处理整块，并且至少留下 32 字节等到 EOF 再处理，
+// 这样最后一段总能包含 CBC 的最后一块或 GCM 的标签
+#define AES_FILE_HOLD (2 * AES_BLOCK_SIZE)
+// 缓冲区 = 一段数据 + 保留量 + 填充块，向上取整到 64 字节对齐
+#define AES_FILE_BUF (AES_FILE_CHUNK + 64)
+
+// PKCS#7 填充函数
+void pkcs7_pad(unsigned char *block, size_t data_len) {
+    unsigned char pad_value = AES_BLOCK_SIZE - data_len;
+    for (size_t i = data_len; i < AES_BLOCK_SIZE; i++) {
+        block[i] = pad_value;
+    }
+}
+
+// PKCS#7 去填充函数：填充值必须在 1..16 之间，且每个填充字节都相同
+int pkcs7_unpad(const unsigned char *block) {
+    unsigned char pad_value = block[AES_BLOCK_SIZE - 1];
+    if (pad_value == 0 || pad_value > AES_BLOCK_SIZE) {
+        return -1; // 错误的填充数据
+    }
+    for (int i = AES_BLOCK_SIZE - pad_value; i < AES_BLOCK_SIZE; i++) {
+        if (block[i] != pad_value) {
+            return -1;
+        }
+    }
+    return AES_BLOCK_SIZE - pad_value;
+}
+
+// 加密接口函数：完整分组逐块加密，最后一块（可能为空）填充后加密
+int aes_encrypt_file(const void *src, size_t bytes, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE],
+                     void *va_dest, size_t *dest_len) {
+    const unsigned char *input = (const unsigned char *)src;
+    unsigned char *dest = (unsigned char *)va_dest;
+    unsigned char block[AES_BLOCK_SIZE];
+    size_t offset = 0;
+
+    for (; bytes - offset >= AES_BLOCK_SIZE; offset += AES_BLOCK_SIZE) {
+        aes_encrypt_block(input + offset, subKeys, dest + offset);
+    }
+
+    memcpy(block, input + offset, bytes - offset);
+    pkcs7_pad(block, bytes - offset);
+    aes_encrypt_block(block, subKeys, dest + offset);
+    *dest_len = offset + AES_BLOCK_SIZE;
+    return 0;
+}
+
+// 解密接口函数：最后一块先解密到临时缓冲区，检查填充后只写出数据部分
+int aes_decrypt_file(const void *src, size_t bytes, unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE],
+                     void *va_dest, size_t *dest_len) {
+    const unsigned char *input = (const unsigned char *)src;
+    unsigned char *dest = (unsigned char *)va_dest;
+    unsigned char block[AES_BLOCK_SIZE];
+    size_t offset;
+    int last;
+
+    if (bytes == 0 || bytes % AES_BLOCK_SIZE != 0) {
+        return 1;
+    }
+
+    for (offset = 0; offset < bytes - AES_BLOCK_SIZE; offset += AES_BLOCK_SIZE) {
+        aes_decrypt_block(input + offset, subKeys, dest + offset);
+    }
+
+    aes_decrypt_block(input + offset, subKeys, block);
+    last = pkcs7_unpad(block);
+    if (last < 0) {
+        return 1;
+    }
+    memcpy(dest + offset, block, last);
+    *dest_len = offset + last;
+    return 0;
+}
+
+// 一次流式加解密的状态：模式上下文、输出缓冲区与输出文件
+typedef struct {
+    aes_file_mode mode;
+    int decrypt;
+    aes_key_schedule ks;                 // CBC 的加密或解密密钥编排
+    unsigned char chain[AES_BLOCK_SIZE]; // CBC 的上一块密文
+    aes_ctr_ctx ctr;
+    aes_gcm_ctx gcm;
+    unsigned char *work; // 输出缓冲区，[AES_FILE_BUF]
+    int out_fd;
+    uint64_t written;
+} file_stream;
+
+// 写满 len 字节，处理被信号打断与部分写入
+static int write_all(int fd, const unsigned char *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return 1;
+        }
+        buf += n;
+        len -= n;
+    }
+    return 0;
+}
+
+// 读到缓冲区满或 EOF，返回读到的字节数，出错时返回 -1
+static ssize_t read_full(int fd, unsigned char *buf, size_t len) {
+    size_t total = 0;
+
+    while (total < len) {
+        ssize_t n = read(fd, buf + total, len - total);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        total += n;
+    }
+    return total;
+}
+
+static int stream_write(file_stream *st, size_t len) {
+    if (write_all(st->out_fd, st->work, len) != 0) {
+        return 1;
+    }
+    st->written += len;
+    return 0;
+}
+
+static int stream_init(file_stream *st, int decrypt, aes_file_mode mode, const unsigned char *key, size_t key_len,
+                       const unsigned char iv[AES_BLOCK_SIZE], int out_fd) {
+    int ret;
+
+    memset(st, 0, sizeof(*st));
+    st->mode = mode;
+    st->decrypt = decrypt;
+    st->out_fd = out_fd;
+
+    switch (mode) {
+    case AES_FILE_CTR:
+        ret = aes_ctr_init(&st->ctr, key, key_len, iv, 64);
+        break;
+    case AES_FILE_CBC:
+        ret = decrypt ? aes_make_dec_key_schedule(key, key_len, &st->ks)
+                      : aes_make_enc_key_schedule(key, key_len, &st->ks);
+        memcpy(st->chain, iv, AES_BLOCK_SIZE);
+        break;
+    case AES_FILE_GCM:
+        ret = aes_gcm_init(&st->gcm, key, key_len) != 0 || aes_gcm_start(&st->gcm, iv, AES_GCM_IV_SIZE) != 0;
+        break;
+    default:
+        return 1;
+    }
+    if (ret != 0) {
+        return 1;
+    }
+
+    st->work = aligned_alloc(64, AES_FILE_BUF);
+    return st->work == NULL;
+}
+
+static void stream_free(file_stream *st) {
+    free(st->work);
+    // 不留下密钥编排
+    memset(st, 0, sizeof(*st));
+}
+
+// CBC 加密：链式依赖，只能逐块串行
+static void cbc_encrypt(file_stream *st, const unsigned char *input, unsigned char *output, size_t nblocks) {
+    for (size_t i = 0; i < nblocks; i++) {
+        for (int j = 0; j < AES_BLOCK_SIZE; j++) {
+            st->chain[j] ^= input[j];
+        }
+        aes_encrypt_block_ks(st->chain, &st->ks, st->chain);
+        memcpy(output, st->chain, AES_BLOCK_SIZE);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+}
+
+// CBC 解密：各块互不依赖，整段交给 aes_ecb_decrypt 并行，再异或上一块密文
+static void cbc_decrypt(file_stream *st, const unsigned char *input, unsigned char *output, size_t nblocks) {
+    if (nblocks == 0) {
+        return;
+    }
+    aes_ecb_decrypt(input, output, nblocks, &st->ks);
+    for (int j = 0; j < AES_BLOCK_SIZE; j++) {
+        output[j] ^= st->chain[j];
+    }
+    for (size_t i = 1; i < nblocks; i++) {
+        for (int j = 0; j < AES_BLOCK_SIZE; j++) {
+            output[i * AES_BLOCK_SIZE + j] ^= input[(i - 1) * AES_BLOCK_SIZE + j];
+        }
+    }
+    memcpy(st->chain, input + (nblocks - 1) * AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+}
+
+// 中间一段：len 为 AES_BLOCK_SIZE 的整数倍，且不超过 AES_FILE_CHUNK + AES_FILE_HOLD
+static int stream_update(file_stream *st, const unsigned char *input, size_t len) {
+    int ret = 0;
+
+    switch (st->mode) {
+    case AES_FILE_CTR:
+        ret = aes_ctr_update(&st->ctr, input, st->work, len);
+        break;
+    case AES_FILE_CBC:
+        if (st->decrypt) {
+            cbc_decrypt(st, input, st->work, len / AES_BLOCK_SIZE);
+        } else {
+            cbc_encrypt(st, input, st->work, len / AES_BLOCK_SIZE);
+        }
+        break;
+    case AES_FILE_GCM:
+        ret = st->decrypt ? aes_gcm_decrypt_update(&st->gcm, input, st->work, len)
+                          : aes_gcm_encrypt_update(&st->gcm, input, st->work, len);
+        break;
+    }
+    if (ret != 0) {
+        return 1;
+    }
+    return stream_write(st, len);
+}
+
+// 最后一段：任意长度，在这里处理填充与标签
+static int stream_final(file_stream *st, const unsigned char *input, size_t len) {
+    size_t full = len / AES_BLOCK_SIZE * AES_BLOCK_SIZE;
+    size_t tail = len - full;
+    int last;
+
+    switch (st->mode) {
+    case AES_FILE_CTR:
+        return stream_update(st, input, len);
+
+    case AES_FILE_CBC:
+        if (!st->decrypt) {
+            // 剩余不足一块的部分（可能为空）填充后加密，整块对齐时补一整块填充
+            cbc_encrypt(st, input, st->work, full / AES_BLOCK_SIZE);
+            memcpy(st->work + full, input + full, tail);
+            pkcs7_pad(st->work + full, tail);
+            cbc_encrypt(st, st->work + full, st->work + full, 1);
+            return stream_write(st, full + AES_BLOCK_SIZE);
+        }
+        if (len == 0 || tail != 0) {
+            return 1; // 密文长度必须是正的整块数
+        }
+        cbc_decrypt(st, input, st->work, len / AES_BLOCK_SIZE);
+        last = pkcs7_unpad(st->work + len - AES_BLOCK_SIZE);
+        if (last < 0) {
+            return 1;
+        }
+        return stream_write(st, len - AES_BLOCK_SIZE + last);
+
+    case AES_FILE_GCM:
+        if (!st->decrypt) {
+            if (aes_gcm_encrypt_update(&st->gcm, input, st->work, len) != 0 ||
+                aes_gcm_final(&st->gcm, st->work + len, AES_GCM_TAG_SIZE) != 0) {
+                return 1;
+            }
+            return stream_write(st, len + AES_GCM_TAG_SIZE);
+        }
+        // 最后 16 字节是标签；明文先写出，调用者在校验失败时负责丢弃
+        if (len < AES_GCM_TAG_SIZE) {
+            return 1;
+        }
+        len -= AES_GCM_TAG_SIZE;
+        if (aes_gcm_decrypt_update(&st->gcm, input, st->work, len) != 0 || stream_write(st, len) != 0) {
+            return 1;
+        }
+        return aes_gcm_verify(&st->gcm, input + len, AES_GCM_TAG_SIZE);
+    }
+    return 1;
+}
+
+// 读文件描述符：输入缓冲区前部保留上一段剩下的不足 AES_FILE_HOLD + AES_BLOCK_SIZE 字节
+static int stream_fd(file_stream *st, int in_fd) {
+    unsigned char *buf = aligned_alloc(64, AES_FILE_BUF);
+    size_t have = 0;
+    int ret = 1;
+
+    if (buf == NULL) {
+        return 1;
+    }
+
+    for (;;) {
+        size_t want = AES_FILE_CHUNK + AES_FILE_HOLD - have;
+        ssize_t n = read_full(in_fd, buf + have, want);
+        size_t len;
+
+        if (n < 0) {
+            break;
+        }
+        have += n;
+        if ((size_t)n < want) {
+            ret = stream_final(st, buf, have);
+            break;
+        }
+
+        // 缓冲区满：处理除保留量以外的整块，余下的挪到开头
+        len = (have - AES_FILE_HOLD) / AES_BLOCK_SIZE * AES_BLOCK_SIZE;
+        if (stream_update(st, buf, len) != 0) {
+            break;
+        }
+        memmove(buf, buf + len, have - len);
+        have -= len;
+    }
+
+    free(buf);
+    return ret;
+}
+
+// 映射的输入：按 AES_FILE_CHUNK 分段处理，最后一段至少保留 AES_FILE_HOLD 字节
+static int stream_mapped(file_stream *st, const unsigned char *input, size_t size) {
+    size_t pos = 0;
+
+    while (size - pos > AES_FILE_CHUNK + AES_FILE_HOLD) {
+        if (stream_update(st, input + pos, AES_FILE_CHUNK) != 0) {
+            return 1;
+        }
+        // 已处理的页不再需要，及早从进程的驻留集里释放
+        madvise((void *)(input + pos), AES_FILE_CHUNK, MADV_DONTNEED);
+        pos += AES_FILE_CHUNK;
+    }
+    return stream_final(st, input + pos, size - pos);
+}
+
+static int crypt_fd(int decrypt, int in_fd, int out_fd, aes_file_mode mode, const unsigned char *key, size_t key_len,
+                    const unsigned char iv[AES_BLOCK_SIZE], uint64_t *out_bytes) {
+    file_stream st;
+    int ret;
+
+    if (stream_init(&st, decrypt, mode, key, key_len, iv, out_fd) != 0) {
+        stream_free(&st);
+        return 1;
+    }
+    ret = stream_fd(&st, in_fd);
+    if (out_bytes != NULL) {
+        *out_bytes = st.written;
+    }
+    stream_free(&st);
+    return ret;
+}
+
+int aes_encrypt_fd(int in_fd, int out_fd, aes_file_mode mode, const unsigned char *key, size_t key_len,
+                   const unsigned char iv[AES_BLOCK_SIZE], uint64_t *out_bytes) {
+    return crypt_fd(0, in_fd, out_fd, mode, key, key_len, iv, out_bytes);
+}
+
+int aes_decrypt_fd(int in_fd, int out_fd, aes_file_mode mode, const unsigned char *key, size_t key_len,
+                   const unsigned char iv[AES_BLOCK_SIZE], uint64_t *out_bytes) {
+    return crypt_fd(1, in_fd, out_fd, mode, key, key_len, iv, out_bytes);
+}
+
+// 普通文件整体只读映射，映射失败（管道、设备等）时退回读缓冲区
+static int crypt_path(int decrypt, const char *in_path, const char *out_path, aes_file_mode mode,
+                      const unsigned char *key, size_t key_len, const unsigned char iv[AES_BLOCK_SIZE],
+                      uint64_t *out_bytes) {
+    file_stream st;
+    struct stat sb;
+    void *map = MAP_FAILED;
+    int in_fd, out_fd;
+    int ret = 1;
+
+    in_fd = open(in_path, O_RDONLY);
+    if (in_fd < 0) {
+        return 1;
+    }
+    out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (out_fd < 0) {
+        close(in_fd);
+        return 1;
+    }
+
+    if (stream_init(&st, decrypt, mode, key, key_len, iv, out_fd) == 0) {
+        if (fstat(in_fd, &sb) == 0 && S_ISREG(sb.st_mode) && sb.st_size > 0) {
+            map = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, in_fd, 0);
+        }
+        if (map != MAP_FAILED) {
+            madvise(map, sb.st_size, MADV_SEQUENTIAL);
+            ret = stream_mapped(&st, map, sb.st_size);
+            munmap(map, sb.st_size);
+        } else {
+            ret = stream_fd(&st, in_fd);
+        }
+    }
+    if (out_bytes != NULL) {
+        *out_bytes = st.written;
+    }
+    stream_free(&st);
+
+    close(in_fd);
+    if (close(out_fd) != 0) {
+        ret = 1;
+    }
+    if (ret != 0) {
+        unlink(out_path);
+    }
+    return ret;
+}
+
+int aes_encrypt_path(const char *in_path, const char *out_path, aes_file_mode mode,
+                     const unsigned char *key, size_t key_len, const unsigned char iv[AES_BLOCK_SIZE],
+                     uint64_t *out_bytes) {
+    return crypt_path(0, in_path, out_path, mode, key, key_len, iv, out_bytes);
+}
+
+int aes_decrypt_path(const char *in_path, const char *out_path, aes_file_mode mode,
+                     const unsigned char *key, size_t key_len, const unsigned char iv[AES_BLOCK_SIZE],
+                     uint64_t *out_bytes) {
+    return crypt_path(1, in_path, out_path, mode, key, key_len, iv, out_bytes);
+}
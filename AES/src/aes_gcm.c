@@ -0,0 +1,388 @@
+#include "aes_gcm.h"
+#include "aes_ctr.h"
+#include "aes_ni.h"
+#include <string.h>
+
+// 查表实现每段处理的分组数：先 CTR 加密一段，趁数据还在 L1 中立即对这段做 GHASH
+#define AES_GCM_CHUNK 32
+
+// 数据长度上限 2^39 - 256 位
+#define AES_GCM_MAX_MSG ((((uint64_t)1) << 36) - 32)
+
+// 4 位 Shoup 算法中右移 4 位时移出的低 4 位对应的约减值（已左移到最高 16 位）
+static const uint64_t GCM_REM_4BIT[16] = {
+    (uint64_t)0x0000 << 48, (uint64_t)0x1C20 << 48, (uint64_t)0x3840 << 48, (uint64_t)0x2460 << 48,
+    (uint64_t)0x7080 << 48, (uint64_t)0x6CA0 << 48, (uint64_t)0x48C0 << 48, (uint64_t)0x54E0 << 48,
+    (uint64_t)0xE100 << 48, (uint64_t)0xFD20 << 48, (uint64_t)0xD940 << 48, (uint64_t)0xC560 << 48,
+    (uint64_t)0x9180 << 48, (uint64_t)0x8DA0 << 48, (uint64_t)0xA9C0 << 48, (uint64_t)0xB5E0 << 48
+};
+
+static inline uint64_t load_be64(const unsigned char *p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static inline void store_be64(unsigned char *p, uint64_t v) {
+    for (int i = 7; i >= 0; i--) {
+        p[i] = (unsigned char)v;
+        v >>= 8;
+    }
+}
+
+// htable[n] = n·H，n 的 4 位按 GCM 位序（最高位对应 x^0）；乘 x 即右移一位，移出位为 1 时异或 0xE1
+static void gcm_init_4bit(uint64_t htable[16][2], const unsigned char h[AES_BLOCK_SIZE]) {
+    uint64_t vhi = load_be64(h), vlo = load_be64(h + 8);
+
+    htable[0][0] = 0;
+    htable[0][1] = 0;
+    for (int i = 8; i > 0; i >>= 1) {
+        htable[i][0] = vhi;
+        htable[i][1] = vlo;
+        // 掩码代替分支，H 的位不影响执行路径
+        uint64_t t = (uint64_t)0xE100000000000000ULL & (0 - (vlo & 1));
+        vlo = (vhi << 63) | (vlo >> 1);
+        vhi = (vhi >> 1) ^ t;
+    }
+    for (int i = 2; i < 16; i <<= 1) {
+        for (int j = 1; j < i; j++) {
+            htable[i + j][0] = htable[i][0] ^ htable[j][0];
+            htable[i + j][1] = htable[i][1] ^ htable[j][1];
+        }
+    }
+}
+
+// Xi = Xi·H，从最后一个字节开始每次吸收 4 位
+static void gcm_gmult_4bit(unsigned char xi[AES_BLOCK_SIZE], const uint64_t htable[16][2]) {
+    uint64_t zhi, zlo, rem;
+    int nlo = xi[15], nhi = nlo >> 4;
+    int cnt = 15;
+
+    nlo &= 0xF;
+    zhi = htable[nlo][0];
+    zlo = htable[nlo][1];
+
+    while (1) {
+        rem = zlo & 0xF;
+        zlo = (zhi << 60) | (zlo >> 4);
+        zhi = (zhi >> 4) ^ GCM_REM_4BIT[rem];
+        zhi ^= htable[nhi][0];
+        zlo ^= htable[nhi][1];
+
+        if (--cnt < 0) {
+            break;
+        }
+
+        nlo = xi[cnt];
+        nhi = nlo >> 4;
+        nlo &= 0xF;
+
+        rem = zlo & 0xF;
+        zlo = (zhi << 60) | (zlo >> 4);
+        zhi = (zhi >> 4) ^ GCM_REM_4BIT[rem];
+        zhi ^= htable[nlo][0];
+        zlo ^= htable[nlo][1];
+    }
+
+    store_be64(xi, zhi);
+    store_be64(xi + 8, zlo);
+}
+
+// 吸收整块数据：Xi = (Xi ^ C)·H
+static void gcm_ghash(aes_gcm_ctx *ctx, const unsigned char *input, size_t nblocks) {
+    if (ctx->use_clmul) {
+        aes_ni_ghash(ctx->xi, (const unsigned char (*)[AES_BLOCK_SIZE])ctx->hpow, input, nblocks);
+        return;
+    }
+
+    for (; nblocks > 0; nblocks--, input += AES_BLOCK_SIZE) {
+        for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+            ctx->xi[i] ^= input[i];
+        }
+        gcm_gmult_4bit(ctx->xi, (const uint64_t (*)[2])ctx->htable);
+    }
+}
+
+// 不完整分组的字节已异或进 Xi，补零后乘 H
+static void gcm_gmult(aes_gcm_ctx *ctx) {
+    static const unsigned char zero[AES_BLOCK_SIZE];
+    gcm_ghash(ctx, zero, 1);
+}
+
+// 第 block 个数据分组的计数器块：J0 的低 32 位加 block + 1（inc32）
+static void gcm_counter_block(const aes_gcm_ctx *ctx, uint64_t block, unsigned char cb[AES_BLOCK_SIZE]) {
+    uint32_t c = ((uint32_t)ctx->j0[12] << 24) | ((uint32_t)ctx->j0[13] << 16) |
+                 ((uint32_t)ctx->j0[14] << 8) | (uint32_t)ctx->j0[15];
+
+    c += (uint32_t)block + 1;
+    memcpy(cb, ctx->j0, 12);
+    cb[12] = (unsigned char)(c >> 24);
+    cb[13] = (unsigned char)(c >> 16);
+    cb[14] = (unsigned char)(c >> 8);
+    cb[15] = (unsigned char)c;
+}
+
+int aes_gcm_init(aes_gcm_ctx *ctx, const unsigned char *key, size_t key_len) {
+    unsigned char h[AES_BLOCK_SIZE] = {0};
+
+    if (aes_make_enc_key_schedule(key, key_len, &ctx->ks) != 0) {
+        return 1;
+    }
+
+    // 散列子密钥 H = E(K, 0^128)
+    aes_encrypt_block_ks(h, &ctx->ks, h);
+    gcm_init_4bit(ctx->htable, h);
+
+    ctx->use_clmul = aes_get_impl() == AES_IMPL_AESNI && aes_ni_has_pclmul();
+    if (ctx->use_clmul) {
+        aes_ni_ghash_init(h, ctx->hpow);
+    }
+
+    // 消息状态由 aes_gcm_start 设置
+    memset(ctx->j0, 0, AES_BLOCK_SIZE);
+    memset(ctx->xi, 0, AES_BLOCK_SIZE);
+    ctx->aad_len = 0;
+    ctx->msg_len = 0;
+    ctx->aad_done = 0;
+    return 0;
+}
+
+int aes_gcm_start(aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len) {
+    if (iv_len == 0) {
+        return 1;
+    }
+
+    memset(ctx->xi, 0, AES_BLOCK_SIZE);
+    if (iv_len == AES_GCM_IV_SIZE) {
+        // J0 = IV || 0^31 || 1
+        memcpy(ctx->j0, iv, AES_GCM_IV_SIZE);
+        memset(ctx->j0 + AES_GCM_IV_SIZE, 0, 3);
+        ctx->j0[15] = 1;
+    } else {
+        // J0 = GHASH(IV || 0^s || 0^64 || [len(IV)]64)
+        unsigned char block[AES_BLOCK_SIZE] = {0};
+        size_t full = iv_len / AES_BLOCK_SIZE;
+
+        gcm_ghash(ctx, iv, full);
+        if (iv_len % AES_BLOCK_SIZE != 0) {
+            memcpy(block, iv + full * AES_BLOCK_SIZE, iv_len % AES_BLOCK_SIZE);
+            gcm_ghash(ctx, block, 1);
+        }
+        memset(block, 0, AES_BLOCK_SIZE);
+        store_be64(block + 8, (uint64_t)iv_len * 8);
+        gcm_ghash(ctx, block, 1);
+
+        memcpy(ctx->j0, ctx->xi, AES_BLOCK_SIZE);
+        memset(ctx->xi, 0, AES_BLOCK_SIZE);
+    }
+
+    ctx->aad_len = 0;
+    ctx->msg_len = 0;
+    ctx->aad_done = 0;
+    return 0;
+}
+
+int aes_gcm_update_aad(aes_gcm_ctx *ctx, const unsigned char *aad, size_t aad_len) {
+    size_t n = ctx->aad_len % AES_BLOCK_SIZE;
+
+    if (ctx->aad_done) {
+        return 1;
+    }
+    ctx->aad_len += aad_len;
+
+    // 先补齐上次剩下的不完整分组
+    if (n != 0) {
+        for (; n < AES_BLOCK_SIZE && aad_len > 0; n++, aad_len--) {
+            ctx->xi[n] ^= *aad++;
+        }
+        if (n < AES_BLOCK_SIZE) {
+            return 0;
+        }
+        gcm_gmult(ctx);
+    }
+
+    gcm_ghash(ctx, aad, aad_len / AES_BLOCK_SIZE);
+    aad += aad_len / AES_BLOCK_SIZE * AES_BLOCK_SIZE;
+    for (n = 0; n < aad_len % AES_BLOCK_SIZE; n++) {
+        ctx->xi[n] ^= aad[n];
+    }
+
+    return 0;
+}
+
+// 整块数据：AES-NI 走 CTR 与 GHASH 交织的内核，否则按段交替 CTR 与 GHASH
+static void gcm_crypt_blocks(aes_gcm_ctx *ctx, const unsigned char *input, unsigned char *output,
+                             size_t nblocks, int decrypt) {
+    uint64_t block = ctx->msg_len / AES_BLOCK_SIZE;
+
+    if (ctx->use_clmul) {
+        unsigned char cb[AES_BLOCK_SIZE];
+        const unsigned char (*hpow)[AES_BLOCK_SIZE] = (const unsigned char (*)[AES_BLOCK_SIZE])ctx->hpow;
+
+        gcm_counter_block(ctx, block, cb);
+        if (decrypt) {
+            aes_ni_gcm_decrypt(input, output, nblocks, ctx->ks.rkb, ctx->ks.rounds, cb, ctx->xi, hpow);
+        } else {
+            aes_ni_gcm_encrypt(input, output, nblocks, ctx->ks.rkb, ctx->ks.rounds, cb, ctx->xi, hpow);
+        }
+        return;
+    }
+
+    while (nblocks > 0) {
+        size_t n = nblocks < AES_GCM_CHUNK ? nblocks : AES_GCM_CHUNK;
+
+        // 以 J0 为 CTR 的起点，第 block 个数据分组位于流偏移 (block + 1) * 16
+        if (decrypt) {
+            gcm_ghash(ctx, input, n);
+        }
+        aes_ctr_crypt(input, output, n * AES_BLOCK_SIZE, &ctx->ks, ctx->j0, 32, (block + 1) * AES_BLOCK_SIZE);
+        if (!decrypt) {
+            gcm_ghash(ctx, output, n);
+        }
+
+        input += n * AES_BLOCK_SIZE;
+        output += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+        block += n;
+    }
+}
+
+static int gcm_crypt_update(aes_gcm_ctx *ctx, const unsigned char *input, unsigned char *output,
+                            size_t len, int decrypt) {
+    size_t n = ctx->msg_len % AES_BLOCK_SIZE;
+    size_t nblocks;
+
+    if (len > AES_GCM_MAX_MSG - ctx->msg_len) {
+        return 1;
+    }
+
+    // AAD 到此结束，其不完整的最后一块补零
+    if (!ctx->aad_done) {
+        if (ctx->aad_len % AES_BLOCK_SIZE != 0) {
+            gcm_gmult(ctx);
+        }
+        ctx->aad_done = 1;
+    }
+
+    // 先用上次剩下的密钥流补齐不完整分组
+    if (n != 0) {
+        for (; n < AES_BLOCK_SIZE && len > 0; n++, len--, ctx->msg_len++) {
+            unsigned char c = *input++;
+            unsigned char p = c ^ ctx->ek[n];
+            *output++ = p;
+            ctx->xi[n] ^= decrypt ? c : p;
+        }
+        if (n < AES_BLOCK_SIZE) {
+            return 0;
+        }
+        gcm_gmult(ctx);
+    }
+
+    nblocks = len / AES_BLOCK_SIZE;
+    if (nblocks > 0) {
+        gcm_crypt_blocks(ctx, input, output, nblocks, decrypt);
+        input += nblocks * AES_BLOCK_SIZE;
+        output += nblocks * AES_BLOCK_SIZE;
+        ctx->msg_len += nblocks * AES_BLOCK_SIZE;
+        len -= nblocks * AES_BLOCK_SIZE;
+    }
+
+    // 尾部不足一块：生成该块的密钥流并保留，下次调用继续使用
+    if (len > 0) {
+        gcm_counter_block(ctx, ctx->msg_len / AES_BLOCK_SIZE, ctx->ek);
+        aes_encrypt_block_ks(ctx->ek, &ctx->ks, ctx->ek);
+        for (n = 0; n < len; n++) {
+            unsigned char c = input[n];
+            unsigned char p = c ^ ctx->ek[n];
+            output[n] = p;
+            ctx->xi[n] ^= decrypt ? c : p;
+        }
+        ctx->msg_len += len;
+    }
+
+    return 0;
+}
+
+int aes_gcm_encrypt_update(aes_gcm_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len) {
+    return gcm_crypt_update(ctx, input, output, len, 0);
+}
+
+int aes_gcm_decrypt_update(aes_gcm_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len) {
+    return gcm_crypt_update(ctx, input, output, len, 1);
+}
+
+// S = GHASH(... || [len(A)]64 || [len(C)]64)，T = E(K, J0) ^ S
+static void gcm_tag(aes_gcm_ctx *ctx, unsigned char tag[AES_BLOCK_SIZE]) {
+    unsigned char block[AES_BLOCK_SIZE];
+
+    if ((!ctx->aad_done && ctx->aad_len % AES_BLOCK_SIZE != 0) || ctx->msg_len % AES_BLOCK_SIZE != 0) {
+        gcm_gmult(ctx);
+    }
+    ctx->aad_done = 1;
+
+    store_be64(block, ctx->aad_len * 8);
+    store_be64(block + 8, ctx->msg_len * 8);
+    gcm_ghash(ctx, block, 1);
+
+    aes_encrypt_block_ks(ctx->j0, &ctx->ks, tag);
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+        tag[i] ^= ctx->xi[i];
+    }
+}
+
+int aes_gcm_final(aes_gcm_ctx *ctx, unsigned char *tag, size_t tag_len) {
+    unsigned char full[AES_BLOCK_SIZE];
+
+    if (tag_len < 4 || tag_len > AES_GCM_TAG_SIZE) {
+        return 1;
+    }
+
+    gcm_tag(ctx, full);
+    memcpy(tag, full, tag_len);
+    return 0;
+}
+
+int aes_gcm_verify(aes_gcm_ctx *ctx, const unsigned char *tag, size_t tag_len) {
+    unsigned char full[AES_BLOCK_SIZE];
+    unsigned char diff = 0;
+
+    if (tag_len < 4 || tag_len > AES_GCM_TAG_SIZE) {
+        return 1;
+    }
+
+    // 逐字节累积差异，比较时间与不匹配的位置无关
+    gcm_tag(ctx, full);
+    for (size_t i = 0; i < tag_len; i++) {
+        diff |= full[i] ^ tag[i];
+    }
+    return diff != 0;
+}
+
+int aes_gcm_encrypt(aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len,
+                    const unsigned char *aad, size_t aad_len,
+                    const unsigned char *input, unsigned char *output, size_t len,
+                    unsigned char *tag, size_t tag_len) {
+    if (aes_gcm_start(ctx, iv, iv_len) != 0 ||
+        aes_gcm_update_aad(ctx, aad, aad_len) != 0 ||
+        aes_gcm_encrypt_update(ctx, input, output, len) != 0) {
+        return 1;
+    }
+    return aes_gcm_final(ctx, tag, tag_len);
+}
+
+int aes_gcm_decrypt(aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len,
+                    const unsigned char *aad, size_t aad_len,
+                    const unsigned char *input, unsigned char *output, size_t len,
+                    const unsigned char *tag, size_t tag_len) {
+    if (aes_gcm_start(ctx, iv, iv_len) != 0 ||
+        aes_gcm_update_aad(ctx, aad, aad_len) != 0 ||
+        aes_gcm_decrypt_update(ctx, input, output, len) != 0 ||
+        aes_gcm_verify(ctx, tag, tag_len) != 0) {
+        // 认证失败不交出任何明文
+        memset(output, 0, len);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,618 @@
+#include "../inc/aes_ni.h"
+#include <smmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+// 仅这些函数使用 AES-NI 指令，其余代码不依赖编译选项；是否调用由 CPUID 检测决定
+#define AES_NI_TARGET __attribute__((target("aes,sse2")))
+#define AES_NI_KS_TARGET __attribute__((target("aes,ssse3")))
+
+#define AES_NI_SUBKEYS(K) ((const unsigned char (*)[AES_BLOCK_SIZE])(K))
+
+// 密钥扩展不用 AESKEYGENASSIST：把 RotWord(W) 复制到 4 列后做 AESENCLAST，行移位对 4 列相同的状态不起作用，
+// 结果每列都是 SubWord(RotWord(W)) ^ Rcon。AESENCLAST 的延迟比 AESKEYGENASSIST 短得多，扩展是一条依赖链
+#define AES_NI_ROT_W3 _mm_set1_epi32(0x0c0f0e0d) /* 每列取第 3 列的 RotWord */
+#define AES_NI_ROT_W1 _mm_set1_epi32(0x04070605) /* 每列取第 1 列的 RotWord */
+
+// W[i] ^= W[i-1] ^ ... ^ W[0]：三个移位互不依赖，比逐次移位异或的依赖链短
+static inline AES_NI_KS_TARGET __m128i aes_ni_prefix_xor(__m128i k) {
+    return _mm_xor_si128(_mm_xor_si128(k, _mm_slli_si128(k, 4)),
+                         _mm_xor_si128(_mm_slli_si128(k, 8), _mm_slli_si128(k, 12)));
+}
+
+// 由前一轮密钥与 SubWord(RotWord(W)) ^ Rcon 生成下一轮密钥
+static inline AES_NI_KS_TARGET __m128i aes_ni_expand_step(__m128i key, __m128i src, __m128i rot, int rcon) {
+    __m128i t = _mm_aesenclast_si128(_mm_shuffle_epi8(src, rot), _mm_set1_epi32(rcon));
+    return _mm_xor_si128(aes_ni_prefix_xor(key), t);
+}
+
+#define AES_NI_EXPAND(K, I, RCON) {                                         \
+    K = aes_ni_expand_step(K, K, AES_NI_ROT_W3, RCON);                      \
+    _mm_storeu_si128((__m128i *)subKeys[I], K); }
+
+static inline AES_NI_KS_TARGET void aes_ni_expand_128(const unsigned char *key, unsigned char (*subKeys)[AES_BLOCK_SIZE]) {
+    __m128i k = _mm_loadu_si128((const __m128i *)key);
+
+    _mm_storeu_si128((__m128i *)subKeys[0], k);
+    AES_NI_EXPAND(k, 1, 0x01);
+    AES_NI_EXPAND(k, 2, 0x02);
+    AES_NI_EXPAND(k, 3, 0x04);
+    AES_NI_EXPAND(k, 4, 0x08);
+    AES_NI_EXPAND(k, 5, 0x10);
+    AES_NI_EXPAND(k, 6, 0x20);
+    AES_NI_EXPAND(k, 7, 0x40);
+    AES_NI_EXPAND(k, 8, 0x80);
+    AES_NI_EXPAND(k, 9, 0x1B);
+    AES_NI_EXPAND(k, 10, 0x36);
+}
+
+// 192 位：每步产生 6 个字（1.5 个轮密钥），hi 只有低 64 位有效，轮密钥按 64 位拼接
+#define AES_NI_EXPAND_192(LO, HI, RCON) {                                   \
+    LO = aes_ni_expand_step(LO, HI, AES_NI_ROT_W1, RCON);                   \
+    HI = _mm_xor_si128(HI, _mm_slli_si128(HI, 4));                          \
+    HI = _mm_xor_si128(HI, _mm_shuffle_epi32(LO, 0xFF)); }
+
+#define AES_NI_CONCAT_LO(A, B) _mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(A), _mm_castsi128_pd(B), 0))
+#define AES_NI_CONCAT_HI(A, B) _mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(A), _mm_castsi128_pd(B), 1))
+
+static inline AES_NI_KS_TARGET void aes_ni_expand_192(const unsigned char *key, unsigned char (*subKeys)[AES_BLOCK_SIZE]) {
+    __m128i lo = _mm_loadu_si128((const __m128i *)key);
+    __m128i hi = _mm_loadl_epi64((const __m128i *)(key + 16));
+    __m128i prev;
+
+    _mm_storeu_si128((__m128i *)subKeys[0], lo);
+    prev = hi;
+    AES_NI_EXPAND_192(lo, hi, 0x01);
+    _mm_storeu_si128((__m128i *)subKeys[1], AES_NI_CONCAT_LO(prev, lo));
+    _mm_storeu_si128((__m128i *)subKeys[2], AES_NI_CONCAT_HI(lo, hi));
+    AES_NI_EXPAND_192(lo, hi, 0x02);
+    _mm_storeu_si128((__m128i *)subKeys[3], lo);
+    prev = hi;
+    AES_NI_EXPAND_192(lo, hi, 0x04);
+    _mm_storeu_si128((__m128i *)subKeys[4], AES_NI_CONCAT_LO(prev, lo));
+    _mm_storeu_si128((__m128i *)subKeys[5], AES_NI_CONCAT_HI(lo, hi));
+    AES_NI_EXPAND_192(lo, hi, 0x08);
+    _mm_storeu_si128((__m128i *)subKeys[6], lo);
+    prev = hi;
+    AES_NI_EXPAND_192(lo, hi, 0x10);
+    _mm_storeu_si128((__m128i *)subKeys[7], AES_NI_CONCAT_LO(prev, lo));
+    _mm_storeu_si128((__m128i *)subKeys[8], AES_NI_CONCAT_HI(lo, hi));
+    AES_NI_EXPAND_192(lo, hi, 0x20);
+    _mm_storeu_si128((__m128i *)subKeys[9], lo);
+    prev = hi;
+    AES_NI_EXPAND_192(lo, hi, 0x40);
+    _mm_storeu_si128((__m128i *)subKeys[10], AES_NI_CONCAT_LO(prev, lo));
+    _mm_storeu_si128((__m128i *)subKeys[11], AES_NI_CONCAT_HI(lo, hi));
+    AES_NI_EXPAND_192(lo, hi, 0x80);
+    _mm_storeu_si128((__m128i *)subKeys[12], lo);
+}
+
+// 256 位：偶数轮密钥用 SubWord(RotWord) 与轮常量，奇数轮密钥只用 SubWord（不旋转，Rcon 为 0）
+#define AES_NI_EXPAND_256(K0, K1, I, RCON) {                                \
+    K0 = aes_ni_expand_step(K0, K1, AES_NI_ROT_W3, RCON);                   \
+    _mm_storeu_si128((__m128i *)subKeys[I], K0);                            \
+    K1 = _mm_xor_si128(aes_ni_prefix_xor(K1),                               \
+                       _mm_aesenclast_si128(_mm_shuffle_epi32(K0, 0xFF), _mm_setzero_si128())); \
+    _mm_storeu_si128((__m128i *)subKeys[I + 1], K1); }
+
+static inline AES_NI_KS_TARGET void aes_ni_expand_256(const unsigned char *key, unsigned char (*subKeys)[AES_BLOCK_SIZE]) {
+    __m128i k0 = _mm_loadu_si128((const __m128i *)key);
+    __m128i k1 = _mm_loadu_si128((const __m128i *)(key + 16));
+
+    _mm_storeu_si128((__m128i *)subKeys[0], k0);
+    _mm_storeu_si128((__m128i *)subKeys[1], k1);
+    AES_NI_EXPAND_256(k0, k1, 2, 0x01);
+    AES_NI_EXPAND_256(k0, k1, 4, 0x02);
+    AES_NI_EXPAND_256(k0, k1, 6, 0x04);
+    AES_NI_EXPAND_256(k0, k1, 8, 0x08);
+    AES_NI_EXPAND_256(k0, k1, 10, 0x10);
+    AES_NI_EXPAND_256(k0, k1, 12, 0x20);
+    k0 = aes_ni_expand_step(k0, k1, AES_NI_ROT_W3, 0x40);
+    _mm_storeu_si128((__m128i *)subKeys[14], k0);
+}
+
+AES_NI_KS_TARGET
+void aes_ni_make_enc_subkeys(const unsigned char key[AES_KEY_SIZE], unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]) {
+    aes_ni_expand_128(key, subKeys);
+}
+
+AES_NI_KS_TARGET
+void aes_ni_make_dec_subkeys(const unsigned char encSubKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE],
+                             unsigned char decSubKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE]) {
+    aes_ni_make_dec_key_schedule(AES_NI_SUBKEYS(encSubKeys), AES_ROUNDS, decSubKeys, NULL);
+}
+
+// 轮密钥按 32 位大端字写出（aes_key_schedule.rk 的布局）：每个字内字节逆序，整块与刚写入的字节序轮密钥等宽装载
+static inline AES_NI_KS_TARGET void aes_ni_subkeys_to_words(const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                                                            uint32_t *words) {
+    const __m128i bswap32 = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+    for (int i = 0; i <= rounds; i++) {
+        __m128i k = _mm_loadu_si128((const __m128i *)subKeys[i]);
+        _mm_storeu_si128((__m128i *)(words + 4 * i), _mm_shuffle_epi8(k, bswap32));
+    }
+}
+
+AES_NI_KS_TARGET
+void aes_ni_make_enc_key_schedule(const unsigned char *key, int rounds, unsigned char (*subKeys)[AES_BLOCK_SIZE],
+                                  uint32_t *words) {
+    switch (rounds) {
+    case 12:
+        aes_ni_expand_192(key, subKeys);
+        break;
+    case 14:
+        aes_ni_expand_256(key, subKeys);
+        break;
+    default:
+        aes_ni_expand_128(key, subKeys);
+        break;
+    }
+    if (words != NULL) {
+        aes_ni_subkeys_to_words(AES_NI_SUBKEYS(subKeys), rounds, words);
+    }
+}
+
+AES_NI_KS_TARGET
+void aes_ni_make_dec_key_schedule(const unsigned char (*encSubKeys)[AES_BLOCK_SIZE], int rounds,
+                                  unsigned char (*decSubKeys)[AES_BLOCK_SIZE], uint32_t *words) {
+    // 首末轮密钥不变，中间各轮做 InvMixColumns（AESIMC）
+    _mm_storeu_si128((__m128i *)decSubKeys[0], _mm_loadu_si128((const __m128i *)encSubKeys[0]));
+    for (int i = 1; i < rounds; i++) {
+        _mm_storeu_si128((__m128i *)decSubKeys[i], _mm_aesimc_si128(_mm_loadu_si128((const __m128i *)encSubKeys[i])));
+    }
+    _mm_storeu_si128((__m128i *)decSubKeys[rounds], _mm_loadu_si128((const __m128i *)encSubKeys[rounds]));
+    if (words != NULL) {
+        aes_ni_subkeys_to_words(AES_NI_SUBKEYS(decSubKeys), rounds, words);
+    }
+}
+
+// 轮数为编译期常量时循环完全展开，每种密钥长度各生成一份
+static inline __attribute__((always_inline)) AES_NI_TARGET
+void aes_ni_encrypt_rounds(const unsigned char *input, const unsigned char (*subKeys)[AES_BLOCK_SIZE], const int rounds,
+                           unsigned char *output) {
+    __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i *)input), _mm_loadu_si128((const __m128i *)subKeys[0]));
+
+    for (int i = 1; i < rounds; i++) {
+        s = _mm_aesenc_si128(s, _mm_loadu_si128((const __m128i *)subKeys[i]));
+    }
+    s = _mm_aesenclast_si128(s, _mm_loadu_si128((const __m128i *)subKeys[rounds]));
+
+    _mm_storeu_si128((__m128i *)output, s);
+}
+
+static inline __attribute__((always_inline)) AES_NI_TARGET
+void aes_ni_decrypt_rounds(const unsigned char *input, const unsigned char (*subKeys)[AES_BLOCK_SIZE], const int rounds,
+                           unsigned char *output) {
+    __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i *)input), _mm_loadu_si128((const __m128i *)subKeys[rounds]));
+
+    for (int i = rounds - 1; i > 0; i--) {
+        s = _mm_aesdec_si128(s, _mm_loadu_si128((const __m128i *)subKeys[i]));
+    }
+    s = _mm_aesdeclast_si128(s, _mm_loadu_si128((const __m128i *)subKeys[0]));
+
+    _mm_storeu_si128((__m128i *)output, s);
+}
+
+AES_NI_TARGET
+void aes_ni_encrypt_block(const unsigned char *input, const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                          unsigned char *output) {
+    switch (rounds) {
+    case 12:
+        aes_ni_encrypt_rounds(input, subKeys, 12, output);
+        break;
+    case 14:
+        aes_ni_encrypt_rounds(input, subKeys, 14, output);
+        break;
+    default:
+        aes_ni_encrypt_rounds(input, subKeys, AES_ROUNDS, output);
+        break;
+    }
+}
+
+AES_NI_TARGET
+void aes_ni_decrypt_block(const unsigned char *input, const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                          unsigned char *output) {
+    switch (rounds) {
+    case 12:
+        aes_ni_decrypt_rounds(input, subKeys, 12, output);
+        break;
+    case 14:
+        aes_ni_decrypt_rounds(input, subKeys, 14, output);
+        break;
+    default:
+        aes_ni_decrypt_rounds(input, subKeys, AES_ROUNDS, output);
+        break;
+    }
+}
+
+// AESENC 延迟约 4 个周期、吞吐 1 条/周期，8 个互不相关的分组交错执行才能填满流水线
+#define AES_NI_ECB_BATCH 8
+
+static inline __attribute__((always_inline)) AES_NI_TARGET
+void aes_ni_ecb_encrypt_rounds(const unsigned char *input, unsigned char *output, size_t nblocks,
+                               const unsigned char (*subKeys)[AES_BLOCK_SIZE], const int rounds) {
+    for (; nblocks >= AES_NI_ECB_BATCH; nblocks -= AES_NI_ECB_BATCH) {
+        __m128i s[AES_NI_ECB_BATCH];
+        __m128i k = _mm_loadu_si128((const __m128i *)subKeys[0]);
+
+        for (int j = 0; j < AES_NI_ECB_BATCH; j++) {
+            s[j] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)input + j), k);
+        }
+        for (int i = 1; i < rounds; i++) {
+            k = _mm_loadu_si128((const __m128i *)subKeys[i]);
+            for (int j = 0; j < AES_NI_ECB_BATCH; j++) {
+                s[j] = _mm_aesenc_si128(s[j], k);
+            }
+        }
+        k = _mm_loadu_si128((const __m128i *)subKeys[rounds]);
+        for (int j = 0; j < AES_NI_ECB_BATCH; j++) {
+            _mm_storeu_si128((__m128i *)output + j, _mm_aesenclast_si128(s[j], k));
+        }
+
+        input += AES_NI_ECB_BATCH * AES_BLOCK_SIZE;
+        output += AES_NI_ECB_BATCH * AES_BLOCK_SIZE;
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        aes_ni_encrypt_rounds(input, subKeys, rounds, output);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+}
+
+static inline __attribute__((always_inline)) AES_NI_TARGET
+void aes_ni_ecb_decrypt_rounds(const unsigned char *input, unsigned char *output, size_t nblocks,
+                               const unsigned char (*subKeys)[AES_BLOCK_SIZE], const int rounds) {
+    for (; nblocks >= AES_NI_ECB_BATCH; nblocks -= AES_NI_ECB_BATCH) {
+        __m128i s[AES_NI_ECB_BATCH];
+        __m128i k = _mm_loadu_si128((const __m128i *)subKeys[rounds]);
+
+        for (int j = 0; j < AES_NI_ECB_BATCH; j++) {
+            s[j] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)input + j), k);
+        }
+        for (int i = rounds - 1; i > 0; i--) {
+            k = _mm_loadu_si128((const __m128i *)subKeys[i]);
+            for (int j = 0; j < AES_NI_ECB_BATCH; j++) {
+                s[j] = _mm_aesdec_si128(s[j], k);
+            }
+        }
+        k = _mm_loadu_si128((const __m128i *)subKeys[0]);
+        for (int j = 0; j < AES_NI_ECB_BATCH; j++) {
+            _mm_storeu_si128((__m128i *)output + j, _mm_aesdeclast_si128(s[j], k));
+        }
+
+        input += AES_NI_ECB_BATCH * AES_BLOCK_SIZE;
+        output += AES_NI_ECB_BATCH * AES_BLOCK_SIZE;
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        aes_ni_decrypt_rounds(input, subKeys, rounds, output);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+}
+
+AES_NI_TARGET
+void aes_ni_ecb_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds) {
+    switch (rounds) {
+    case 12:
+        aes_ni_ecb_encrypt_rounds(input, output, nblocks, subKeys, 12);
+        break;
+    case 14:
+        aes_ni_ecb_encrypt_rounds(input, output, nblocks, subKeys, 14);
+        break;
+    default:
+        aes_ni_ecb_encrypt_rounds(input, output, nblocks, subKeys, AES_ROUNDS);
+        break;
+    }
+}
+
+AES_NI_TARGET
+void aes_ni_ecb_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds) {
+    switch (rounds) {
+    case 12:
+        aes_ni_ecb_decrypt_rounds(input, output, nblocks, subKeys, 12);
+        break;
+    case 14:
+        aes_ni_ecb_decrypt_rounds(input, output, nblocks, subKeys, 14);
+        break;
+    default:
+        aes_ni_ecb_decrypt_rounds(input, output, nblocks, subKeys, AES_ROUNDS);
+        break;
+    }
+}
+
+// GCM 另外需要 PCLMULQDQ（GHASH）、PSHUFB（字节逆序）与 PINSRD（写计数器）
+#define AES_NI_GCM_TARGET __attribute__((target("aes,pclmul,sse4.1,ssse3,sse2")))
+
+// GHASH 的位序与 PCLMULQDQ 相反：整块字节逆序后，每个字节内的位序恰好匹配，只是乘积整体差一位
+#define GHASH_BSWAP(X) _mm_shuffle_epi8((X), _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15))
+
+int aes_ni_has_pclmul(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3") &&
+           __builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("aes");
+}
+
+// 无约减的 128x128 位乘法，结果累加到 lo / mid / hi，多块乘积可以只约减一次
+static inline AES_NI_GCM_TARGET
+void ghash_mul_acc(__m128i a, __m128i b, __m128i *lo, __m128i *mid, __m128i *hi) {
+    *lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+    *hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+    *mid = _mm_xor_si128(*mid, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01)));
+}
+
+// 256 位乘积左移一位补齐位序差，再模 x^128 + x^7 + x^2 + x + 1 约减（Intel CLMUL 白皮书算法 5）
+static inline AES_NI_GCM_TARGET
+__m128i ghash_reduce(__m128i lo, __m128i mid, __m128i hi) {
+    __m128i t3 = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    __m128i t6 = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+    __m128i t7, t8, t9, t2, t4, t5;
+
+    t7 = _mm_srli_epi32(t3, 31);
+    t8 = _mm_srli_epi32(t6, 31);
+    t3 = _mm_slli_epi32(t3, 1);
+    t6 = _mm_slli_epi32(t6, 1);
+    t9 = _mm_srli_si128(t7, 12);
+    t8 = _mm_slli_si128(t8, 4);
+    t7 = _mm_slli_si128(t7, 4);
+    t3 = _mm_or_si128(t3, t7);
+    t6 = _mm_or_si128(t6, t8);
+    t6 = _mm_or_si128(t6, t9);
+
+    t7 = _mm_slli_epi32(t3, 31);
+    t8 = _mm_slli_epi32(t3, 30);
+    t9 = _mm_slli_epi32(t3, 25);
+    t7 = _mm_xor_si128(t7, t8);
+    t7 = _mm_xor_si128(t7, t9);
+    t8 = _mm_srli_si128(t7, 4);
+    t7 = _mm_slli_si128(t7, 12);
+    t3 = _mm_xor_si128(t3, t7);
+
+    t2 = _mm_srli_epi32(t3, 1);
+    t4 = _mm_srli_epi32(t3, 2);
+    t5 = _mm_srli_epi32(t3, 7);
+    t2 = _mm_xor_si128(t2, t4);
+    t2 = _mm_xor_si128(t2, t5);
+    t2 = _mm_xor_si128(t2, t8);
+    t3 = _mm_xor_si128(t3, t2);
+    return _mm_xor_si128(t6, t3);
+}
+
+static inline AES_NI_GCM_TARGET __m128i ghash_mul(__m128i a, __m128i b) {
+    __m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+    ghash_mul_acc(a, b, &lo, &mid, &hi);
+    return ghash_reduce(lo, mid, hi);
+}
+
+// 8 块聚合：X' = (X ^ C0)·H^8 ^ C1·H^7 ^ ... ^ C7·H，8 次乘法只约减一次
+static inline AES_NI_GCM_TARGET
+__m128i ghash_8blocks(__m128i x, const unsigned char *input, const unsigned char hpow[8][AES_BLOCK_SIZE]) {
+    __m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+
+    for (int j = 0; j < 8; j++) {
+        __m128i c = GHASH_BSWAP(_mm_loadu_si128((const __m128i *)input + j));
+        if (j == 0) {
+            c = _mm_xor_si128(c, x);
+        }
+        ghash_mul_acc(c, _mm_loadu_si128((const __m128i *)hpow[7 - j]), &lo, &mid, &hi);
+    }
+    return ghash_reduce(lo, mid, hi);
+}
+
+AES_NI_GCM_TARGET
+void aes_ni_ghash_init(const unsigned char h[AES_BLOCK_SIZE], unsigned char hpow[8][AES_BLOCK_SIZE]) {
+    __m128i hr = GHASH_BSWAP(_mm_loadu_si128((const __m128i *)h));
+    __m128i p = hr;
+
+    _mm_storeu_si128((__m128i *)hpow[0], hr);
+    for (int i = 1; i < 8; i++) {
+        p = ghash_mul(p, hr);
+        _mm_storeu_si128((__m128i *)hpow[i], p);
+    }
+}
+
+AES_NI_GCM_TARGET
+void aes_ni_ghash(unsigned char xi[AES_BLOCK_SIZE], const unsigned char hpow[8][AES_BLOCK_SIZE],
+                  const unsigned char *input, size_t nblocks) {
+    __m128i x = GHASH_BSWAP(_mm_loadu_si128((const __m128i *)xi));
+    __m128i h = _mm_loadu_si128((const __m128i *)hpow[0]);
+
+    for (; nblocks >= 8; nblocks -= 8, input += 8 * AES_BLOCK_SIZE) {
+        x = ghash_8blocks(x, input, hpow);
+    }
+    for (; nblocks > 0; nblocks--, input += AES_BLOCK_SIZE) {
+        x = ghash_mul(_mm_xor_si128(x, GHASH_BSWAP(_mm_loadu_si128((const __m128i *)input))), h);
+    }
+
+    _mm_storeu_si128((__m128i *)xi, GHASH_BSWAP(x));
+}
+
+// 单块 CTR：密钥流与输入异或
+static inline AES_NI_GCM_TARGET
+__m128i gcm_ctr_block(__m128i cb, const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds, const unsigned char *input) {
+    __m128i s = _mm_xor_si128(cb, _mm_loadu_si128((const __m128i *)subKeys[0]));
+
+    for (int i = 1; i < rounds; i++) {
+        s = _mm_aesenc_si128(s, _mm_loadu_si128((const __m128i *)subKeys[i]));
+    }
+    s = _mm_aesenclast_si128(s, _mm_loadu_si128((const __m128i *)subKeys[rounds]));
+    return _mm_xor_si128(s, _mm_loadu_si128((const __m128i *)input));
+}
+
+// 8 块 CTR 与 8 块 GHASH 写在同一个循环体中：两条依赖链互不相关，乱序执行把 AESENC 与 PCLMULQDQ 交错发射
+static inline __attribute__((always_inline)) AES_NI_GCM_TARGET
+void aes_ni_gcm_crypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                      const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                      const unsigned char counter[AES_BLOCK_SIZE], unsigned char xi[AES_BLOCK_SIZE],
+                      const unsigned char hpow[8][AES_BLOCK_SIZE], const int decrypt) {
+    __m128i x = GHASH_BSWAP(_mm_loadu_si128((const __m128i *)xi));
+    __m128i h = _mm_loadu_si128((const __m128i *)hpow[0]);
+    __m128i cb = _mm_loadu_si128((const __m128i *)counter);
+    uint32_t ctr = ((uint32_t)counter[12] << 24) | ((uint32_t)counter[13] << 16) |
+                   ((uint32_t)counter[14] << 8) | (uint32_t)counter[15];
+    // 加密时 GHASH 滞后一批：本批密文要等 AES 结束才有，先处理上一批
+    const unsigned char *pending = NULL;
+
+    for (; nblocks >= 8; nblocks -= 8) {
+        __m128i s[8];
+        __m128i k = _mm_loadu_si128((const __m128i *)subKeys[0]);
+
+        for (int j = 0; j < 8; j++) {
+            s[j] = _mm_xor_si128(_mm_insert_epi32(cb, (int)__builtin_bswap32(ctr + j), 3), k);
+        }
+        ctr += 8;
+
+        if (decrypt) {
+            x = ghash_8blocks(x, input, hpow);
+        } else if (pending != NULL) {
+            x = ghash_8blocks(x, pending, hpow);
+        }
+
+        for (int i = 1; i < rounds; i++) {
+            k = _mm_loadu_si128((const __m128i *)subKeys[i]);
+            for (int j = 0; j < 8; j++) {
+                s[j] = _mm_aesenc_si128(s[j], k);
+            }
+        }
+        k = _mm_loadu_si128((const __m128i *)subKeys[rounds]);
+        for (int j = 0; j < 8; j++) {
+            s[j] = _mm_xor_si128(_mm_aesenclast_si128(s[j], k), _mm_loadu_si128((const __m128i *)input + j));
+        }
+        for (int j = 0; j < 8; j++) {
+            _mm_storeu_si128((__m128i *)output + j, s[j]);
+        }
+
+        pending = output;
+        input += 8 * AES_BLOCK_SIZE;
+        output += 8 * AES_BLOCK_SIZE;
+    }
+
+    if (!decrypt && pending != NULL) {
+        x = ghash_8blocks(x, pending, hpow);
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        __m128i c = _mm_loadu_si128((const __m128i *)input);
+        __m128i o = gcm_ctr_block(_mm_insert_epi32(cb, (int)__builtin_bswap32(ctr), 3), subKeys, rounds, input);
+        ctr++;
+        _mm_storeu_si128((__m128i *)output, o);
+        x = ghash_mul(_mm_xor_si128(x, GHASH_BSWAP(decrypt ? c : o)), h);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+
+    _mm_storeu_si128((__m128i *)xi, GHASH_BSWAP(x));
+}
+
+AES_NI_GCM_TARGET
+void aes_ni_gcm_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                        const unsigned char counter[AES_BLOCK_SIZE], unsigned char xi[AES_BLOCK_SIZE],
+                        const unsigned char hpow[8][AES_BLOCK_SIZE]) {
+    aes_ni_gcm_crypt(input, output, nblocks, subKeys, rounds, counter, xi, hpow, 0);
+}
+
+AES_NI_GCM_TARGET
+void aes_ni_gcm_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                        const unsigned char counter[AES_BLOCK_SIZE], unsigned char xi[AES_BLOCK_SIZE],
+                        const unsigned char hpow[8][AES_BLOCK_SIZE]) {
+    aes_ni_gcm_crypt(input, output, nblocks, subKeys, rounds, counter, xi, hpow, 1);
+}
+
+// XTS 调整值乘 α：每个 32 位字左移一位，各字的最高位移入下一个字，最高字的进位折回为 0x87
+static inline AES_NI_TARGET __m128i xts_mul_alpha(__m128i t) {
+    __m128i carry = _mm_shuffle_epi32(_mm_srai_epi32(t, 31), 0x93);
+
+    carry = _mm_and_si128(carry, _mm_set_epi32(1, 1, 1, 0x87));
+    return _mm_xor_si128(_mm_add_epi32(t, t), carry);
+}
+
+static inline __attribute__((always_inline)) AES_NI_TARGET
+void aes_ni_xts_crypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                      const unsigned char (*subKeys)[AES_BLOCK_SIZE], const int rounds,
+                      unsigned char tweak[AES_BLOCK_SIZE], const int decrypt) {
+    __m128i t = _mm_loadu_si128((const __m128i *)tweak);
+
+    // 每批 8 块：调整值链只有几条整数指令，与 AES 轮函数重叠执行
+    for (; nblocks >= AES_NI_ECB_BATCH; nblocks -= AES_NI_ECB_BATCH) {
+        __m128i s[AES_NI_ECB_BATCH], tw[AES_NI_ECB_BATCH];
+        __m128i k = _mm_loadu_si128((const __m128i *)subKeys[decrypt ? rounds : 0]);
+
+        for (int j = 0; j < AES_NI_ECB_BATCH; j++) {
+            tw[j] = t;
+            t = xts_mul_alpha(t);
+            s[j] = _mm_xor_si128(_mm_xor_si128(_mm_loadu_si128((const __m128i *)input + j), tw[j]), k);
+        }
+        for (int i = 1; i < rounds; i++) {
+            k = _mm_loadu_si128((const __m128i *)subKeys[decrypt ? rounds - i : i]);
+            for (int j = 0; j < AES_NI_ECB_BATCH; j++) {
+                s[j] = decrypt ? _mm_aesdec_si128(s[j], k) : _mm_aesenc_si128(s[j], k);
+            }
+        }
+        k = _mm_loadu_si128((const __m128i *)subKeys[decrypt ? 0 : rounds]);
+        for (int j = 0; j < AES_NI_ECB_BATCH; j++) {
+            s[j] = decrypt ? _mm_aesdeclast_si128(s[j], k) : _mm_aesenclast_si128(s[j], k);
+            _mm_storeu_si128((__m128i *)output + j, _mm_xor_si128(s[j], tw[j]));
+        }
+
+        input += AES_NI_ECB_BATCH * AES_BLOCK_SIZE;
+        output += AES_NI_ECB_BATCH * AES_BLOCK_SIZE;
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i *)input), t);
+
+        s = _mm_xor_si128(s, _mm_loadu_si128((const __m128i *)subKeys[decrypt ? rounds : 0]));
+        for (int i = 1; i < rounds; i++) {
+            __m128i k = _mm_loadu_si128((const __m128i *)subKeys[decrypt ? rounds - i : i]);
+            s = decrypt ? _mm_aesdec_si128(s, k) : _mm_aesenc_si128(s, k);
+        }
+        s = decrypt ? _mm_aesdeclast_si128(s, _mm_loadu_si128((const __m128i *)subKeys[0]))
+                    : _mm_aesenclast_si128(s, _mm_loadu_si128((const __m128i *)subKeys[rounds]));
+        _mm_storeu_si128((__m128i *)output, _mm_xor_si128(s, t));
+        t = xts_mul_alpha(t);
+
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+
+    _mm_storeu_si128((__m128i *)tweak, t);
+}
+
+AES_NI_TARGET
+void aes_ni_xts_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                        unsigned char tweak[AES_BLOCK_SIZE]) {
+    switch (rounds) {
+    case 12:
+        aes_ni_xts_crypt(input, output, nblocks, subKeys, 12, tweak, 0);
+        break;
+    case 14:
+        aes_ni_xts_crypt(input, output, nblocks, subKeys, 14, tweak, 0);
+        break;
+    default:
+        aes_ni_xts_crypt(input, output, nblocks, subKeys, AES_ROUNDS, tweak, 0);
+        break;
+    }
+}
+
+AES_NI_TARGET
+void aes_ni_xts_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                        unsigned char tweak[AES_BLOCK_SIZE]) {
+    switch (rounds) {
+    case 12:
+        aes_ni_xts_crypt(input, output, nblocks, subKeys, 12, tweak, 1);
+        break;
+    case 14:
+        aes_ni_xts_crypt(input, output, nblocks, subKeys, 14, tweak, 1);
+        break;
+    default:
+        aes_ni_xts_crypt(input, output, nblocks, subKeys, AES_ROUNDS, tweak, 1);
+        break;
+    }
+}
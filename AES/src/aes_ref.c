@@ -0,0 +1,144 @@
+#include "../inc/aes_ref.h"
+#include "../inc/table.h"
+
+/*
+ * 参考实现：状态按 FIPS-197 排成 4x4 字节矩阵，state[r][c] 为第 r 行第 c 列，
+ * 列混淆直接用 MIX_COLUMNS / INV_MIX_COLUMNS 矩阵在 GF(2^8) 上做乘法。
+ * 只求与标准逐步对应，便于和其他实现对照，不追求速度。
+ */
+
+// 列混淆矩阵
+static const uint8_t MIX_COLUMNS[4][4] = {
+    {0x02, 0x03, 0x01, 0x01},
+    {0x01, 0x02, 0x03, 0x01},
+    {0x01, 0x01, 0x02, 0x03},
+    {0x03, 0x01, 0x01, 0x02}
+};
+
+// 逆列混淆矩阵
+static const uint8_t INV_MIX_COLUMNS[4][4] = {
+    {0x0e, 0x0b, 0x0d, 0x09},
+    {0x09, 0x0e, 0x0b, 0x0d},
+    {0x0d, 0x09, 0x0e, 0x0b},
+    {0x0b, 0x0d, 0x09, 0x0e}
+};
+
+// GF(2^8) 乘法，模 x^8 + x^4 + x^3 + x + 1
+static unsigned char gmul(unsigned char a, unsigned char b) {
+    unsigned char p = 0;
+
+    while (b) {
+        if (b & 1) {
+            p ^= a;
+        }
+        a = (unsigned char)((a << 1) ^ ((a & 0x80) ? 0x1B : 0x00));
+        b >>= 1;
+    }
+    return p;
+}
+
+// 输入按列装入状态矩阵
+static void ref_load(unsigned char state[4][4], const unsigned char *input) {
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            state[r][c] = input[4 * c + r];
+        }
+    }
+}
+
+static void ref_store(unsigned char *output, unsigned char state[4][4]) {
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            output[4 * c + r] = state[r][c];
+        }
+    }
+}
+
+static void ref_add_round_key(unsigned char state[4][4], const unsigned char *roundKey) {
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            state[r][c] ^= roundKey[4 * c + r];
+        }
+    }
+}
+
+static void ref_sub_bytes(unsigned char state[4][4], const uint8_t box[256]) {
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            state[r][c] = box[state[r][c]];
+        }
+    }
+}
+
+// 第 r 行循环左移 r 个字节，逆变换右移
+static void ref_shift_rows(unsigned char state[4][4], int inverse) {
+    unsigned char row[4];
+
+    for (int r = 1; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            row[c] = state[r][c];
+        }
+        for (int c = 0; c < 4; c++) {
+            state[r][c] = inverse ? row[(c - r + 4) % 4] : row[(c + r) % 4];
+        }
+    }
+}
+
+// 每一列左乘常数矩阵
+static void ref_mix_columns(unsigned char state[4][4], const uint8_t matrix[4][4]) {
+    unsigned char col[4];
+
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            col[r] = state[r][c];
+        }
+        for (int r = 0; r < 4; r++) {
+            state[r][c] = gmul(matrix[r][0], col[0]) ^ gmul(matrix[r][1], col[1]) ^
+                          gmul(matrix[r][2], col[2]) ^ gmul(matrix[r][3], col[3]);
+        }
+    }
+}
+
+void aes_ref_encrypt_block(const unsigned char *input, const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                           unsigned char *output) {
+    unsigned char state[4][4];
+
+    ref_load(state, input);
+    ref_add_round_key(state, subKeys[0]);
+
+    for (int round = 1; round < rounds; round++) {
+        ref_sub_bytes(state, S_BOX);
+        ref_shift_rows(state, 0);
+        ref_mix_columns(state, MIX_COLUMNS);
+        ref_add_round_key(state, subKeys[round]);
+    }
+
+    // 最后一轮没有列混淆
+    ref_sub_bytes(state, S_BOX);
+    ref_shift_rows(state, 0);
+    ref_add_round_key(state, subKeys[rounds]);
+
+    ref_store(output, state);
+}
+
+void aes_ref_decrypt_block(const unsigned char *input, const unsigned char (*subKeys)[AES_BLOCK_SIZE], int rounds,
+                           unsigned char *output) {
+    unsigned char state[4][4];
+
+    ref_load(state, input);
+    ref_add_round_key(state, subKeys[rounds]);
+
+    // 等价逆密码：轮密钥已做过 InvMixColumns，各步顺序与加密相同
+    for (int round = rounds - 1; round > 0; round--) {
+        ref_sub_bytes(state, INV_S_BOX);
+        ref_shift_rows(state, 1);
+        ref_mix_columns(state, INV_MIX_COLUMNS);
+        ref_add_round_key(state, subKeys[round]);
+    }
+
+    ref_sub_bytes(state, INV_S_BOX);
+    ref_shift_rows(state, 1);
+    ref_add_round_key(state, subKeys[0]);
+
+    ref_store(output, state);
+}
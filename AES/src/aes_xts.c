@@ -0,0 +1,211 @@
+#include "aes_xts.h"
+#include "aes_ni.h"
+#include <string.h>
+
+// 每批处理的分组数：整批交给 aes_ecb_encrypt / aes_ecb_decrypt，AES-NI 内部按 8 块交错、位切片按 8/16 块一批，查表逐块处理
+#define AES_XTS_BATCH 32
+
+// 调整值按 128 位小端整数保存，[0] 为低 64 位。整块 16 字节读写，避免后面 16 字节装载时存储转发失败
+typedef uint64_t xts_tweak __attribute__((vector_size(16)));
+
+// 乘 α：128 位左移一位，溢出时低字节异或 0x87。溢出位扩展成掩码，没有分支
+static inline xts_tweak xts_tweak_double(xts_tweak t) {
+    uint64_t lo = t[0], hi = t[1];
+    uint64_t carry = (uint64_t)0 - (hi >> 63);
+
+    return (xts_tweak){(lo << 1) ^ (carry & 0x87), (hi << 1) | (lo >> 63)};
+}
+
+static inline void xts_tweak_load(xts_tweak *t, const unsigned char *p) {
+    memcpy(t, p, AES_BLOCK_SIZE);
+}
+
+static inline void xor_tweak(unsigned char *out, const unsigned char *in, const xts_tweak *t) {
+    xts_tweak x;
+
+    memcpy(&x, in, AES_BLOCK_SIZE);
+    x ^= *t;
+    memcpy(out, &x, AES_BLOCK_SIZE);
+}
+
+// 连续 nblocks 个完整分组：先把整批调整值算出来，异或后一次做 ECB，再异或回去。t 推进到下一个分组
+static void xts_blocks(const aes_key_schedule *ks, int decrypt, const unsigned char *input, unsigned char *output,
+                       size_t nblocks, xts_tweak *t) {
+    unsigned char buf[AES_XTS_BATCH * AES_BLOCK_SIZE];
+    xts_tweak tw[AES_XTS_BATCH];
+    xts_tweak cur;
+
+    // AES-NI：调整值留在寄存器里，异或与加解密合在一趟里完成
+    if (aes_get_impl() == AES_IMPL_AESNI) {
+        unsigned char tb[AES_BLOCK_SIZE];
+        memcpy(tb, t, AES_BLOCK_SIZE);
+        if (decrypt) {
+            aes_ni_xts_decrypt(input, output, nblocks, ks->rkb, ks->rounds, tb);
+        } else {
+            aes_ni_xts_encrypt(input, output, nblocks, ks->rkb, ks->rounds, tb);
+        }
+        memcpy(t, tb, AES_BLOCK_SIZE);
+        return;
+    }
+
+    // 倍乘链保存在局部变量里，不经过 *t
+    cur = *t;
+
+    while (nblocks > 0) {
+        size_t n = nblocks < AES_XTS_BATCH ? nblocks : AES_XTS_BATCH;
+
+        for (size_t i = 0; i < n; i++) {
+            tw[i] = cur;
+            cur = xts_tweak_double(cur);
+            xor_tweak(buf + i * AES_BLOCK_SIZE, input + i * AES_BLOCK_SIZE, &tw[i]);
+        }
+
+        if (decrypt) {
+            aes_ecb_decrypt(buf, buf, n, ks);
+        } else {
+            aes_ecb_encrypt(buf, buf, n, ks);
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            xor_tweak(output + i * AES_BLOCK_SIZE, buf + i * AES_BLOCK_SIZE, &tw[i]);
+        }
+
+        input += n * AES_BLOCK_SIZE;
+        output += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+    *t = cur;
+}
+
+// 单个分组
+static void xts_block(const aes_key_schedule *ks, int decrypt, const unsigned char *input, unsigned char *output,
+                      const xts_tweak *t) {
+    unsigned char buf[AES_BLOCK_SIZE];
+
+    xor_tweak(buf, input, t);
+    if (decrypt) {
+        aes_decrypt_block_ks(buf, ks, buf);
+    } else {
+        aes_encrypt_block_ks(buf, ks, buf);
+    }
+    xor_tweak(output, buf, t);
+}
+
+// 一个数据单元，t0 是已用 key2 加密过的调整值
+static void xts_crypt_unit(const aes_xts_ctx *ctx, int decrypt, const unsigned char *input, unsigned char *output,
+                           size_t len, const unsigned char t0[AES_BLOCK_SIZE]) {
+    const aes_key_schedule *ks = decrypt ? &ctx->ks_dec : &ctx->ks_enc;
+    size_t tail = len % AES_BLOCK_SIZE;
+    size_t nblocks = len / AES_BLOCK_SIZE;
+    unsigned char cc[AES_BLOCK_SIZE];
+    unsigned char pp[AES_BLOCK_SIZE];
+    xts_tweak t, t_next;
+
+    xts_tweak_load(&t, t0);
+
+    // 有不完整尾块时，最后一个完整分组留给密文挪用
+    if (tail != 0) {
+        nblocks--;
+    }
+    xts_blocks(ks, decrypt, input, output, nblocks, &t);
+    if (tail == 0) {
+        return;
+    }
+
+    input += nblocks * AES_BLOCK_SIZE;
+    output += nblocks * AES_BLOCK_SIZE;
+    t_next = xts_tweak_double(t);
+
+    // 密文挪用：加密时倒数第二块用 t，拼接块用 t_next；解密时两者次序相反
+    xts_block(ks, decrypt, input, cc, decrypt ? &t_next : &t);
+    memcpy(pp, input + AES_BLOCK_SIZE, tail);
+    memcpy(pp + tail, cc + tail, AES_BLOCK_SIZE - tail);
+    // 原地处理时尾块输入已读入 pp，可以覆盖
+    memcpy(output + AES_BLOCK_SIZE, cc, tail);
+    xts_block(ks, decrypt, pp, output, decrypt ? &t : &t_next);
+}
+
+static int xts_crypt(const aes_xts_ctx *ctx, int decrypt, const unsigned char *input, unsigned char *output,
+                     size_t len, const unsigned char tweak[AES_BLOCK_SIZE]) {
+    unsigned char t0[AES_BLOCK_SIZE];
+
+    if (len < AES_BLOCK_SIZE) {
+        return 1;
+    }
+
+    aes_encrypt_block_ks(tweak, &ctx->ks_tweak, t0);
+    xts_crypt_unit(ctx, decrypt, input, output, len, t0);
+    return 0;
+}
+
+int aes_xts_init(aes_xts_ctx *ctx, const unsigned char *key, size_t key_len, size_t sector_size) {
+    size_t half = key_len / 2;
+
+    if (key_len % 2 != 0 || sector_size < AES_BLOCK_SIZE) {
+        return 1;
+    }
+    if (aes_make_enc_key_schedule(key, half, &ctx->ks_enc) != 0 ||
+        aes_make_dec_key_schedule(key, half, &ctx->ks_dec) != 0 ||
+        aes_make_enc_key_schedule(key + half, half, &ctx->ks_tweak) != 0) {
+        return 1;
+    }
+
+    ctx->sector_size = sector_size;
+    return 0;
+}
+
+int aes_xts_encrypt(const aes_xts_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len,
+                    const unsigned char tweak[AES_BLOCK_SIZE]) {
+    return xts_crypt(ctx, 0, input, output, len, tweak);
+}
+
+int aes_xts_decrypt(const aes_xts_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len,
+                    const unsigned char tweak[AES_BLOCK_SIZE]) {
+    return xts_crypt(ctx, 1, input, output, len, tweak);
+}
+
+// 扇区号作为 128 位小端整数；各扇区的调整值互不依赖，整批用 key2 加密
+static int xts_crypt_sectors(const aes_xts_ctx *ctx, int decrypt, const unsigned char *input, unsigned char *output,
+                             uint64_t sector, size_t nsectors) {
+    unsigned char tweaks[AES_XTS_BATCH * AES_BLOCK_SIZE];
+
+    if (nsectors > 0 && sector + (nsectors - 1) < sector) {
+        return 1;
+    }
+    while (nsectors > 0) {
+        size_t n = nsectors < AES_XTS_BATCH ? nsectors : AES_XTS_BATCH;
+
+        for (size_t i = 0; i < n; i++) {
+            uint64_t s = sector + i;
+            memcpy(tweaks + i * AES_BLOCK_SIZE, &s, 8);
+            memset(tweaks + i * AES_BLOCK_SIZE + 8, 0, 8);
+        }
+        aes_ecb_encrypt(tweaks, tweaks, n, &ctx->ks_tweak);
+
+        for (size_t i = 0; i < n; i++) {
+            xts_crypt_unit(ctx, decrypt, input, output, ctx->sector_size, tweaks + i * AES_BLOCK_SIZE);
+            input += ctx->sector_size;
+            output += ctx->sector_size;
+        }
+
+        sector += n;
+        nsectors -= n;
+    }
+    return 0;
+}
+
+int aes_xts_encrypt_sectors(const aes_xts_ctx *ctx, const unsigned char *input, unsigned char *output,
+                            uint64_t sector, size_t nsectors) {
+    return xts_crypt_sectors(ctx, 0, input, output, sector, nsectors);
+}
+
+int aes_xts_decrypt_sectors(const aes_xts_ctx *ctx, const unsigned char *input, unsigned char *output,
+                            uint64_t sector, size_t nsectors) {
+    return xts_crypt_sectors(ctx, 1, input, output, sector, nsectors);
+}
+
+int aes_xts_final(aes_xts_ctx *ctx) {
+    // 不留下密钥编排
+    memset(ctx, 0, sizeof(*ctx));
+    return 0;
+}
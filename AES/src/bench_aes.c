@@ -0,0 +1,242 @@
+#include "aes.h"
+#include "aes_ctr.h"
+#include "aes_gcm.h"
+#include "aes_xts.h"
+#include "benchmark.h"
+
+#define BENCHS 10
+#define BULK_BLOCKS 256
+#define BULK_BYTES (BULK_BLOCKS * AES_BLOCK_SIZE)
+#define BULK_ROUNDS 5000
+#define REFERENCE_ROUNDS 50
+#define XTS_SECTOR_SIZE 512
+#define KEY_ROUNDS 100000
+#define KEY_REFERENCE_ROUNDS 1000
+#define FLOWS 64
+#define PACKET_BYTES 64
+
+// Inputs shared by every backend
+static unsigned char plaintext[BULK_BYTES];
+static unsigned char key[2 * AES_256_KEY_SIZE];
+static unsigned char iv[AES_BLOCK_SIZE];
+static unsigned char flow_keys[FLOWS][AES_KEY_SIZE];
+
+// Outputs of one backend for every mode
+typedef struct
+{
+    unsigned char ecb128[BULK_BYTES];
+    unsigned char ecb256[BULK_BYTES];
+    unsigned char ctr[BULK_BYTES];
+    unsigned char gcm[BULK_BYTES];
+    unsigned char tag[AES_GCM_TAG_SIZE];
+    unsigned char xts[BULK_BYTES];
+} mode_outputs;
+
+static mode_outputs reference;
+static mode_outputs current;
+
+// Run every mode once with the active backend
+static void run_modes(mode_outputs *out)
+{
+    aes_key_schedule ks;
+    aes_gcm_ctx gcm;
+    aes_xts_ctx xts;
+
+    aes_make_enc_key_schedule(key, AES_KEY_SIZE, &ks);
+    aes_ecb_encrypt(plaintext, out->ecb128, BULK_BLOCKS, &ks);
+    aes_ctr_crypt(plaintext, out->ctr, BULK_BYTES, &ks, iv, 32, 0);
+
+    aes_make_enc_key_schedule(key, AES_256_KEY_SIZE, &ks);
+    aes_ecb_encrypt(plaintext, out->ecb256, BULK_BLOCKS, &ks);
+
+    aes_gcm_init(&gcm, key, AES_KEY_SIZE);
+    aes_gcm_encrypt(&gcm, iv, AES_GCM_IV_SIZE, NULL, 0, plaintext, out->gcm, BULK_BYTES, out->tag, sizeof(out->tag));
+
+    aes_xts_init(&xts, key, 2 * AES_KEY_SIZE, XTS_SECTOR_SIZE);
+    aes_xts_encrypt_sectors(&xts, plaintext, out->xts, 0, BULK_BYTES / XTS_SECTOR_SIZE);
+    aes_xts_final(&xts);
+}
+
+// Check the active backend against the reference outputs, decryption included
+static int check_backend(void)
+{
+    static unsigned char decrypted[BULK_BYTES];
+    aes_key_schedule ks;
+
+    run_modes(&current);
+    if (memcmp(&current, &reference, sizeof(current)) != 0)
+    {
+        return 1;
+    }
+
+    aes_make_dec_key_schedule(key, AES_256_KEY_SIZE, &ks);
+    aes_ecb_decrypt(current.ecb256, decrypted, BULK_BLOCKS, &ks);
+    return memcmp(decrypted, plaintext, BULK_BYTES) != 0;
+}
+
+static void bench_backend(int rounds)
+{
+    static unsigned char output[BULK_BYTES];
+    unsigned char tag[AES_GCM_TAG_SIZE];
+    aes_key_schedule encKs, decKs, encKs256;
+    aes_gcm_ctx gcm;
+    aes_xts_ctx xts;
+
+    aes_make_enc_key_schedule(key, AES_KEY_SIZE, &encKs);
+    aes_make_dec_key_schedule(key, AES_KEY_SIZE, &decKs);
+    aes_make_enc_key_schedule(key, AES_256_KEY_SIZE, &encKs256);
+    aes_gcm_init(&gcm, key, AES_KEY_SIZE);
+    aes_xts_init(&xts, key, 2 * AES_KEY_SIZE, XTS_SECTOR_SIZE);
+
+    BPS_BENCH_START("AES-128 ECB encryption", BENCHS);
+    BPS_BENCH_ITEM(aes_ecb_encrypt(plaintext, output, BULK_BLOCKS, &encKs), rounds);
+    BPS_BENCH_FINAL(BULK_BYTES * 8);
+
+    BPS_BENCH_START("AES-128 ECB decryption", BENCHS);
+    BPS_BENCH_ITEM(aes_ecb_decrypt(plaintext, output, BULK_BLOCKS, &decKs), rounds);
+    BPS_BENCH_FINAL(BULK_BYTES * 8);
+
+    BPS_BENCH_START("AES-256 ECB encryption", BENCHS);
+    BPS_BENCH_ITEM(aes_ecb_encrypt(plaintext, output, BULK_BLOCKS, &encKs256), rounds);
+    BPS_BENCH_FINAL(BULK_BYTES * 8);
+
+    BPS_BENCH_START("AES-128 CTR", BENCHS);
+    BPS_BENCH_ITEM(aes_ctr_crypt(plaintext, output, BULK_BYTES, &encKs, iv, 32, 0), rounds);
+    BPS_BENCH_FINAL(BULK_BYTES * 8);
+
+    BPS_BENCH_START("AES-128 GCM encryption", BENCHS);
+    BPS_BENCH_ITEM(aes_gcm_encrypt(&gcm, iv, AES_GCM_IV_SIZE, NULL, 0, plaintext, output, BULK_BYTES, tag, sizeof(tag)), rounds);
+    BPS_BENCH_FINAL(BULK_BYTES * 8);
+
+    BPS_BENCH_START("AES-128 XTS encryption (512-byte sectors)", BENCHS);
+    BPS_BENCH_ITEM(aes_xts_encrypt_sectors(&xts, plaintext, output, 0, BULK_BYTES / XTS_SECTOR_SIZE), rounds);
+    BPS_BENCH_FINAL(BULK_BYTES * 8);
+
+    aes_xts_final(&xts);
+}
+
+// Per-packet rekeying: every packet belongs to the next flow and expands that flow's key
+static void packet_rekey(const unsigned char *packet, unsigned char *output)
+{
+    static int flow = 0;
+    aes_key_schedule ks;
+
+    aes_make_enc_key_schedule(flow_keys[flow], AES_KEY_SIZE, &ks);
+    aes_ecb_encrypt(packet, output, PACKET_BYTES / AES_BLOCK_SIZE, &ks);
+    flow = (flow + 1) % FLOWS;
+}
+
+// The same traffic with one cached handle per flow; rekey is a key comparison
+static void packet_cached(aes_key_handle *handles, const unsigned char *packet, unsigned char *output)
+{
+    static int flow = 0;
+
+    aes_key_handle_rekey(&handles[flow], flow_keys[flow], AES_KEY_SIZE);
+    aes_ecb_encrypt(packet, output, PACKET_BYTES / AES_BLOCK_SIZE, aes_key_handle_enc(&handles[flow]));
+    flow = (flow + 1) % FLOWS;
+}
+
+static void bench_key_agility(int rounds)
+{
+    static aes_key_handle handles[FLOWS];
+    unsigned char subKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE];
+    unsigned char output[PACKET_BYTES];
+    aes_key_schedule encKs, ks;
+
+    for (int i = 0; i < FLOWS; i++)
+    {
+        aes_key_handle_init(&handles[i], flow_keys[i], AES_KEY_SIZE);
+    }
+    aes_make_enc_key_schedule(key, AES_KEY_SIZE, &encKs);
+
+    BPS_BENCH_START("AES-128 encryption key schedule", BENCHS);
+    BPS_BENCH_ITEM(aes_make_enc_key_schedule(key, AES_KEY_SIZE, &ks), rounds);
+    OPS_BENCH_FINAL(1);
+
+    BPS_BENCH_START("AES-128 decryption key schedule", BENCHS);
+    BPS_BENCH_ITEM(aes_make_dec_key_schedule(key, AES_KEY_SIZE, &ks), rounds);
+    OPS_BENCH_FINAL(1);
+
+    BPS_BENCH_START("AES-128 decryption key schedule from encryption schedule", BENCHS);
+    BPS_BENCH_ITEM(aes_make_dec_key_schedule_from_enc(&encKs, &ks), rounds);
+    OPS_BENCH_FINAL(1);
+
+    BPS_BENCH_START("AES-256 encryption key schedule", BENCHS);
+    BPS_BENCH_ITEM(aes_make_enc_key_schedule(key, AES_256_KEY_SIZE, &ks), rounds);
+    OPS_BENCH_FINAL(1);
+
+    BPS_BENCH_START("AES-256 decryption key schedule", BENCHS);
+    BPS_BENCH_ITEM(aes_make_dec_key_schedule(key, AES_256_KEY_SIZE, &ks), rounds);
+    OPS_BENCH_FINAL(1);
+
+    BPS_BENCH_START("AES-128 aes_make_enc_subkeys", BENCHS);
+    BPS_BENCH_ITEM(aes_make_enc_subkeys(key, subKeys), rounds);
+    OPS_BENCH_FINAL(1);
+
+    BPS_BENCH_START("AES-128 aes_make_dec_subkeys", BENCHS);
+    BPS_BENCH_ITEM(aes_make_dec_subkeys(key, subKeys), rounds);
+    OPS_BENCH_FINAL(1);
+
+    BPS_BENCH_START("AES-128 rekey + 64-byte packet", BENCHS);
+    BPS_BENCH_ITEM(packet_rekey(plaintext, output), rounds);
+    BPS_BENCH_FINAL(PACKET_BYTES * 8);
+
+    BPS_BENCH_START("AES-128 cached handle + 64-byte packet", BENCHS);
+    BPS_BENCH_ITEM(packet_cached(handles, plaintext, output), rounds);
+    BPS_BENCH_FINAL(PACKET_BYTES * 8);
+
+    for (int i = 0; i < FLOWS; i++)
+    {
+        aes_key_handle_final(&handles[i]);
+    }
+}
+
+int main()
+{
+    int failed = 0;
+
+    // Fixed seed: every run and every backend sees the same data
+    srand(2024);
+    for (size_t i = 0; i < sizeof(plaintext); i++)
+    {
+        plaintext[i] = rand() & 0xFF;
+    }
+    for (size_t i = 0; i < sizeof(key); i++)
+    {
+        key[i] = rand() & 0xFF;
+    }
+    for (size_t i = 0; i < sizeof(iv); i++)
+    {
+        iv[i] = rand() & 0xFF;
+    }
+    for (size_t i = 0; i < sizeof(flow_keys); i++)
+    {
+        flow_keys[i / AES_KEY_SIZE][i % AES_KEY_SIZE] = rand() & 0xFF;
+    }
+
+    aes_set_impl(AES_IMPL_REFERENCE);
+    run_modes(&reference);
+
+    for (int impl = AES_IMPL_AUTO + 1; impl < AES_IMPL_COUNT; impl++)
+    {
+        if (aes_set_impl(impl) != 0)
+        {
+            printf(">> %s not supported by this CPU, skipped.\n\n", aes_impl_name(impl));
+            continue;
+        }
+        printf(">> Backend: %s\n", aes_impl_name(impl));
+
+        if (check_backend() != 0)
+        {
+            printf(">> %s does not match the reference backend!\n\n", aes_impl_name(impl));
+            failed = 1;
+            continue;
+        }
+        printf(">> Output matches the reference backend.\n");
+
+        bench_backend(impl == AES_IMPL_REFERENCE ? REFERENCE_ROUNDS : BULK_ROUNDS);
+        bench_key_agility(impl == AES_IMPL_REFERENCE ? KEY_REFERENCE_ROUNDS : KEY_ROUNDS);
+    }
+
+    return failed;
+}
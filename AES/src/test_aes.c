@@ -1,8 +1,18 @@
 #include "aes.h"
+#include "aes_cfb.h"
+#include "aes_ctr.h"
+#include "aes_file.h"
+#include "aes_gcm.h"
+#include "aes_xts.h"
 #include "benchmark.h"
+#include <fcntl.h>
+#include <unistd.h>
 
 #define BENCHS 10
 #define ROUNDS 100000
+#define BULK_BLOCKS 256
+#define BULK_ROUNDS 5000
+#define STREAM_PERF_BYTES (64 << 20)
 
 // Print bytes in hexadecimal format
 void print_bytes(const unsigned char *data, size_t size)
@@ -15,6 +25,19 @@ void print_bytes(const unsigned char *data, size_t size)
 }
 
 
+// Parse a hexadecimal string, returns the number of bytes
+size_t hex_to_bytes(const char *hex, unsigned char *out)
+{
+    size_t n = 0;
+    for (; hex[0] != '\0' && hex[1] != '\0'; hex += 2)
+    {
+        unsigned int v;
+        sscanf(hex, "%2x", &v);
+        out[n++] = (unsigned char)v;
+    }
+    return n;
+}
+
 // Correctness test function
 void test_aes_correctness()
 {
@@ -79,6 +102,254 @@ void test_aes_correctness()
     }
 }
 
+// Key schedule API must match the FIPS-197 vector and the subKeys API
+void test_aes_key_schedule_correctness()
+{
+    // FIPS-197 Appendix C.1
+    unsigned char key[AES_KEY_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+    unsigned char plaintext[AES_BLOCK_SIZE] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+    unsigned char correctResult[AES_BLOCK_SIZE] = {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a};
+
+    unsigned char ciphertext[AES_BLOCK_SIZE];
+    unsigned char expected[AES_BLOCK_SIZE];
+    unsigned char decrypted[AES_BLOCK_SIZE];
+    unsigned char encSubKeys[11][16];
+    aes_key_schedule encKs, decKs;
+    int failed = 0;
+
+    if (aes_make_enc_key_schedule(key, AES_KEY_SIZE, &encKs) != 0 || aes_make_dec_key_schedule(key, AES_KEY_SIZE, &decKs) != 0)
+    {
+        printf("Failed to generate key schedule.\n");
+        return;
+    }
+
+    aes_encrypt_block_ks(plaintext, &encKs, ciphertext);
+    printf("Encrypted ciphertext (key schedule): ");
+    print_bytes(ciphertext, AES_BLOCK_SIZE);
+    aes_decrypt_block_ks(ciphertext, &decKs, decrypted);
+    if (memcmp(ciphertext, correctResult, AES_BLOCK_SIZE) != 0 || memcmp(decrypted, plaintext, AES_BLOCK_SIZE) != 0)
+    {
+        failed = 1;
+    }
+
+    // Chained random blocks against the subKeys API
+    aes_make_enc_subkeys(key, encSubKeys);
+    for (int i = 0; i < 1000; i++)
+    {
+        aes_encrypt_block(plaintext, encSubKeys, expected);
+        aes_encrypt_block_ks(plaintext, &encKs, ciphertext);
+        aes_decrypt_block_ks(ciphertext, &decKs, decrypted);
+        if (memcmp(ciphertext, expected, AES_BLOCK_SIZE) != 0 || memcmp(decrypted, plaintext, AES_BLOCK_SIZE) != 0)
+        {
+            failed = 1;
+            break;
+        }
+        memcpy(plaintext, ciphertext, AES_BLOCK_SIZE);
+    }
+
+    if (!failed)
+    {
+        printf(">> Key schedule correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Key schedule correctness test failed.\n\n");
+    }
+}
+
+// AES-192 / AES-256 key schedules must match FIPS-197 Appendix C.2 / C.3
+void test_aes_long_key_correctness()
+{
+    unsigned char key[AES_256_KEY_SIZE];
+    unsigned char plaintext[AES_BLOCK_SIZE] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+    unsigned char correctResult192[AES_BLOCK_SIZE] = {0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0,
+    0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91};
+    unsigned char correctResult256[AES_BLOCK_SIZE] = {0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+    0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89};
+    size_t keyLens[] = { AES_192_KEY_SIZE, AES_256_KEY_SIZE };
+    unsigned char *correctResults[] = { correctResult192, correctResult256 };
+
+    unsigned char ciphertext[AES_BLOCK_SIZE];
+    unsigned char decrypted[AES_BLOCK_SIZE];
+    aes_key_schedule encKs, decKs;
+    int failed = 0;
+
+    for (int i = 0; i < AES_256_KEY_SIZE; i++)
+    {
+        key[i] = (unsigned char)i;
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        if (aes_make_enc_key_schedule(key, keyLens[i], &encKs) != 0 || aes_make_dec_key_schedule(key, keyLens[i], &decKs) != 0)
+        {
+            printf("Failed to generate key schedule.\n");
+            return;
+        }
+
+        aes_encrypt_block_ks(plaintext, &encKs, ciphertext);
+        printf("Encrypted ciphertext (AES-%d): ", (int)keyLens[i] * 8);
+        print_bytes(ciphertext, AES_BLOCK_SIZE);
+        aes_decrypt_block_ks(ciphertext, &decKs, decrypted);
+        if (memcmp(ciphertext, correctResults[i], AES_BLOCK_SIZE) != 0 || memcmp(decrypted, plaintext, AES_BLOCK_SIZE) != 0)
+        {
+            failed = 1;
+        }
+    }
+
+    // Unsupported key length must be rejected
+    if (aes_make_enc_key_schedule(key, 20, &encKs) == 0)
+    {
+        failed = 1;
+    }
+
+    if (!failed)
+    {
+        printf(">> AES-192/256 correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> AES-192/256 correctness test failed.\n\n");
+    }
+}
+
+// Every backend must expand keys to the same round keys (words and bytes), and the handle must cache them
+void test_aes_key_agility()
+{
+    size_t keyLens[] = { AES_KEY_SIZE, AES_192_KEY_SIZE, AES_256_KEY_SIZE };
+    unsigned char key[AES_256_KEY_SIZE], otherKey[AES_256_KEY_SIZE];
+    aes_key_schedule expectedEnc, expectedDec, encKs, decKs, derived;
+    aes_key_handle handle;
+    aes_impl impl = aes_get_impl();
+    int failed = 0;
+
+    printf(">> Testing key schedules and key handles...\n");
+
+    for (int trial = 0; trial < 100 && !failed; trial++)
+    {
+        size_t keyLen = keyLens[trial % 3];
+        for (size_t i = 0; i < keyLen; i++)
+        {
+            key[i] = rand() & 0xFF;
+        }
+
+        // The T-table schedule is the baseline
+        aes_set_impl(AES_IMPL_TABLE);
+        aes_make_enc_key_schedule(key, keyLen, &expectedEnc);
+        aes_make_dec_key_schedule(key, keyLen, &expectedDec);
+        aes_set_impl(impl);
+
+        size_t used = (size_t)(expectedEnc.rounds + 1) * AES_BLOCK_SIZE;
+        aes_make_enc_key_schedule(key, keyLen, &encKs);
+        aes_make_dec_key_schedule(key, keyLen, &decKs);
+        aes_make_dec_key_schedule_from_enc(&encKs, &derived);
+        if (encKs.rounds != expectedEnc.rounds || decKs.rounds != expectedDec.rounds ||
+            memcmp(encKs.rk, expectedEnc.rk, used) != 0 || memcmp(encKs.rkb, expectedEnc.rkb, used) != 0 ||
+            memcmp(decKs.rk, expectedDec.rk, used) != 0 || memcmp(decKs.rkb, expectedDec.rkb, used) != 0 ||
+            memcmp(derived.rk, expectedDec.rk, used) != 0 || memcmp(derived.rkb, expectedDec.rkb, used) != 0)
+        {
+            failed = 1;
+        }
+
+        // In place derivation
+        aes_make_dec_key_schedule_from_enc(&encKs, &encKs);
+        if (memcmp(encKs.rkb, expectedDec.rkb, used) != 0)
+        {
+            failed = 1;
+        }
+    }
+
+    // The handle keeps its schedules while the key is unchanged and re-expands when it changes
+    for (size_t i = 0; i < sizeof(otherKey); i++)
+    {
+        otherKey[i] = key[i] ^ 0x5a;
+    }
+    aes_make_dec_key_schedule(key, AES_256_KEY_SIZE, &expectedDec);
+    aes_make_enc_key_schedule(otherKey, AES_KEY_SIZE, &encKs);
+    aes_make_dec_key_schedule(otherKey, AES_KEY_SIZE, &decKs);
+    if (aes_key_handle_init(&handle, key, AES_256_KEY_SIZE) != 0 ||
+        memcmp(aes_key_handle_dec(&handle)->rkb, expectedDec.rkb, sizeof(expectedDec.rkb)) != 0 ||
+        aes_key_handle_rekey(&handle, key, AES_256_KEY_SIZE) != 0 || !handle.has_dec ||
+        aes_key_handle_rekey(&handle, otherKey, AES_KEY_SIZE) != 0 || handle.has_dec ||
+        memcmp(aes_key_handle_enc(&handle)->rkb, encKs.rkb, 11 * AES_BLOCK_SIZE) != 0 ||
+        memcmp(aes_key_handle_dec(&handle)->rkb, decKs.rkb, 11 * AES_BLOCK_SIZE) != 0 ||
+        aes_key_handle_rekey(&handle, otherKey, 20) != 1)
+    {
+        failed = 1;
+    }
+    aes_key_handle_final(&handle);
+
+    if (!failed)
+    {
+        printf(">> Key agility test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Key agility test failed!\n\n");
+    }
+}
+
+// Multi-block ECB must match the single-block functions for every batch remainder
+void test_aes_ecb_correctness()
+{
+    size_t counts[] = { 1, 3, 4, 5, 8, 9, 33, BULK_BLOCKS };
+    static unsigned char plaintext[BULK_BLOCKS * AES_BLOCK_SIZE];
+    static unsigned char ciphertext[BULK_BLOCKS * AES_BLOCK_SIZE];
+    static unsigned char expected[BULK_BLOCKS * AES_BLOCK_SIZE];
+    unsigned char key[AES_256_KEY_SIZE];
+    size_t keyLens[] = { AES_KEY_SIZE, AES_192_KEY_SIZE, AES_256_KEY_SIZE };
+    aes_key_schedule encKs, decKs;
+    int failed = 0;
+
+    for (size_t i = 0; i < sizeof(plaintext); i++)
+    {
+        plaintext[i] = rand() & 0xFF;
+    }
+    for (int i = 0; i < AES_256_KEY_SIZE; i++)
+    {
+        key[i] = rand() & 0xFF;
+    }
+
+    for (size_t k = 0; k < sizeof(keyLens) / sizeof(keyLens[0]); k++)
+    {
+        aes_make_enc_key_schedule(key, keyLens[k], &encKs);
+        aes_make_dec_key_schedule(key, keyLens[k], &decKs);
+
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+        {
+            for (size_t i = 0; i < counts[c]; i++)
+            {
+                aes_encrypt_block_ks(plaintext + i * AES_BLOCK_SIZE, &encKs, expected + i * AES_BLOCK_SIZE);
+            }
+            aes_ecb_encrypt(plaintext, ciphertext, counts[c], &encKs);
+            if (memcmp(ciphertext, expected, counts[c] * AES_BLOCK_SIZE) != 0)
+            {
+                failed = 1;
+            }
+
+            // In place
+            aes_ecb_decrypt(ciphertext, ciphertext, counts[c], &decKs);
+            if (memcmp(ciphertext, plaintext, counts[c] * AES_BLOCK_SIZE) != 0)
+            {
+                failed = 1;
+            }
+        }
+    }
+
+    if (!failed)
+    {
+        printf(">> ECB multi-block correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> ECB multi-block correctness test failed.\n\n");
+    }
+}
+
 // Performance test function
 void test_aes_performance()
 {
@@ -121,6 +392,119 @@ void test_aes_performance()
     BPS_BENCH_START("AES decryption", BENCHS);
     BPS_BENCH_ITEM(aes_decrypt_block(ciphertext, decSubKeys, decrypted), ROUNDS);
     BPS_BENCH_FINAL(AES_BLOCK_BITS);
+
+    aes_key_schedule encKs, decKs;
+    if (aes_make_enc_key_schedule(key, AES_KEY_SIZE, &encKs) != 0 || aes_make_dec_key_schedule(key, AES_KEY_SIZE, &decKs) != 0)
+    {
+        printf("Failed to generate key schedule.\n");
+        return;
+    }
+
+    BPS_BENCH_START("AES encryption (key schedule)", BENCHS);
+    BPS_BENCH_ITEM(aes_encrypt_block_ks(plaintext, &encKs, ciphertext), ROUNDS);
+    BPS_BENCH_FINAL(AES_BLOCK_BITS);
+
+    BPS_BENCH_START("AES decryption (key schedule)", BENCHS);
+    BPS_BENCH_ITEM(aes_decrypt_block_ks(ciphertext, &decKs, decrypted), ROUNDS);
+    BPS_BENCH_FINAL(AES_BLOCK_BITS);
+
+    // AES-256, reuse the 128-bit key bytes twice
+    unsigned char key256[AES_256_KEY_SIZE];
+    memcpy(key256, key, AES_KEY_SIZE);
+    memcpy(key256 + AES_KEY_SIZE, key, AES_KEY_SIZE);
+    if (aes_make_enc_key_schedule(key256, AES_256_KEY_SIZE, &encKs) != 0 || aes_make_dec_key_schedule(key256, AES_256_KEY_SIZE, &decKs) != 0)
+    {
+        printf("Failed to generate key schedule.\n");
+        return;
+    }
+
+    BPS_BENCH_START("AES-256 encryption (key schedule)", BENCHS);
+    BPS_BENCH_ITEM(aes_encrypt_block_ks(plaintext, &encKs, ciphertext), ROUNDS);
+    BPS_BENCH_FINAL(AES_BLOCK_BITS);
+
+    BPS_BENCH_START("AES-256 decryption (key schedule)", BENCHS);
+    BPS_BENCH_ITEM(aes_decrypt_block_ks(ciphertext, &decKs, decrypted), ROUNDS);
+    BPS_BENCH_FINAL(AES_BLOCK_BITS);
+}
+
+// Bulk performance test function
+void test_aes_bulk_performance()
+{
+    static unsigned char plaintext[BULK_BLOCKS * AES_BLOCK_SIZE];
+    static unsigned char ciphertext[BULK_BLOCKS * AES_BLOCK_SIZE];
+    unsigned char key[AES_KEY_SIZE];
+    unsigned char iv[AES_BLOCK_SIZE];
+    aes_key_schedule encKs;
+
+    for (size_t i = 0; i < sizeof(plaintext); i++)
+    {
+        plaintext[i] = rand() & 0xFF;
+    }
+    for (int i = 0; i < AES_KEY_SIZE; i++)
+    {
+        key[i] = rand() & 0xFF;
+        iv[i] = rand() & 0xFF;
+    }
+    aes_make_enc_key_schedule(key, AES_KEY_SIZE, &encKs);
+
+    BPS_BENCH_START("AES-ECB encryption (multi-block)", BENCHS);
+    BPS_BENCH_ITEM(aes_ecb_encrypt(plaintext, ciphertext, BULK_BLOCKS, &encKs), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * AES_BLOCK_BITS);
+
+    BPS_BENCH_START("AES-CTR encryption", BENCHS);
+    BPS_BENCH_ITEM(aes_ctr_crypt(plaintext, ciphertext, sizeof(plaintext), &encKs, iv, 32, 0), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * AES_BLOCK_BITS);
+
+    aes_cfb_ctx cfb;
+    aes_cfb_init(&cfb, key, AES_KEY_SIZE, iv, 0);
+
+    BPS_BENCH_START("AES-CFB encryption", BENCHS);
+    BPS_BENCH_ITEM(aes_cfb_update(&cfb, plaintext, ciphertext, sizeof(plaintext)), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * AES_BLOCK_BITS);
+
+    aes_cfb_init(&cfb, key, AES_KEY_SIZE, iv, 1);
+
+    BPS_BENCH_START("AES-CFB decryption (batched)", BENCHS);
+    BPS_BENCH_ITEM(aes_cfb_update(&cfb, ciphertext, plaintext, sizeof(plaintext)), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * AES_BLOCK_BITS);
+
+    // 64-byte messages: one-shot API expands the key on every call, the context does not
+    BPS_BENCH_START("AES-CFB 64-byte messages (one-shot)", BENCHS);
+    BPS_BENCH_ITEM(aes_cfb_encrypt(plaintext, 64, key, iv, ciphertext), ROUNDS);
+    BPS_BENCH_FINAL(64 * 8);
+
+    aes_cfb_init(&cfb, key, AES_KEY_SIZE, iv, 0);
+
+    BPS_BENCH_START("AES-CFB 64-byte messages (context)", BENCHS);
+    BPS_BENCH_ITEM(aes_cfb_update(&cfb, plaintext, ciphertext, 64), ROUNDS);
+    BPS_BENCH_FINAL(64 * 8);
+
+    aes_gcm_ctx gcm;
+    unsigned char tag[AES_GCM_TAG_SIZE];
+    aes_gcm_init(&gcm, key, AES_KEY_SIZE);
+
+    BPS_BENCH_START("AES-GCM encryption", BENCHS);
+    BPS_BENCH_ITEM(aes_gcm_encrypt(&gcm, iv, AES_GCM_IV_SIZE, NULL, 0, plaintext, ciphertext, sizeof(plaintext), tag, sizeof(tag)), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * AES_BLOCK_BITS);
+
+    BPS_BENCH_START("AES-GCM decryption", BENCHS);
+    BPS_BENCH_ITEM(aes_gcm_decrypt(&gcm, iv, AES_GCM_IV_SIZE, NULL, 0, ciphertext, plaintext, sizeof(plaintext), tag, sizeof(tag)), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * AES_BLOCK_BITS);
+
+    // XTS key is key1 || key2; the random plaintext buffer doubles as the second half
+    aes_xts_ctx xts;
+    unsigned char xtsKey[2 * AES_KEY_SIZE];
+    memcpy(xtsKey, key, AES_KEY_SIZE);
+    memcpy(xtsKey + AES_KEY_SIZE, plaintext, AES_KEY_SIZE);
+    aes_xts_init(&xts, xtsKey, sizeof(xtsKey), 512);
+
+    BPS_BENCH_START("AES-XTS encryption (512-byte sectors)", BENCHS);
+    BPS_BENCH_ITEM(aes_xts_encrypt_sectors(&xts, plaintext, ciphertext, 0, sizeof(plaintext) / 512), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * AES_BLOCK_BITS);
+
+    BPS_BENCH_START("AES-XTS decryption (512-byte sectors)", BENCHS);
+    BPS_BENCH_ITEM(aes_xts_decrypt_sectors(&xts, ciphertext, plaintext, 0, sizeof(plaintext) / 512), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * AES_BLOCK_BITS);
 }
 
 void test_aes_cfb()
@@ -164,27 +548,840 @@ void test_aes_cfb()
     printf("Decrypted in hex: ");
     print_bytes(decrypted, plaintext_len);
 
-    if (memcmp(plaintext, decrypted, plaintext_len) == 0) {
+    int failed = memcmp(plaintext, decrypted, plaintext_len) != 0;
+
+    // NIST SP 800-38A F.3.13 CFB128-AES128, context API with random update sizes
+    unsigned char nistPlain[64] = {
+        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+    };
+    unsigned char nistCipher[64] = {
+        0x3b, 0x3f, 0xd9, 0x2e, 0xb7, 0x2d, 0xad, 0x20, 0x33, 0x34, 0x49, 0xf8, 0xe8, 0x3c, 0xfb, 0x4a,
+        0xc8, 0xa6, 0x45, 0x37, 0xa0, 0xb3, 0xa9, 0x3f, 0xcd, 0xe3, 0xcd, 0xad, 0x9f, 0x1c, 0xe5, 0x8b,
+        0x26, 0x75, 0x1f, 0x67, 0xa3, 0xcb, 0xb1, 0x40, 0xb1, 0x80, 0x8c, 0xf1, 0x87, 0xa4, 0xf4, 0xdf,
+        0xc0, 0x4b, 0x05, 0x35, 0x7c, 0x5d, 0x1c, 0x0e, 0xea, 0xc4, 0xc6, 0x6f, 0x9f, 0xf7, 0xf2, 0xe6
+    };
+    static unsigned char message[1000];
+    static unsigned char whole[1000];
+    static unsigned char pieces[1000];
+    unsigned char output[64];
+    aes_cfb_ctx ctx;
+
+    aes_cfb_encrypt(nistPlain, sizeof(nistPlain), key, iv, output);
+    if (memcmp(output, nistCipher, sizeof(output)) != 0)
+    {
+        failed = 1;
+    }
+
+    for (size_t i = 0; i < sizeof(message); i++)
+    {
+        message[i] = rand() & 0xFF;
+    }
+    aes_cfb_encrypt(message, sizeof(message), key, iv, whole);
+    for (int t = 0; t < 100 && !failed; t++)
+    {
+        for (int decrypt = 0; decrypt <= 1; decrypt++)
+        {
+            size_t done = 0;
+            aes_cfb_init(&ctx, key, AES_KEY_SIZE, iv, decrypt);
+            while (done < sizeof(message))
+            {
+                size_t n = rand() % 200;
+                if (n > sizeof(message) - done)
+                {
+                    n = sizeof(message) - done;
+                }
+                // Decrypt in place
+                if (decrypt)
+                {
+                    aes_cfb_update(&ctx, pieces + done, pieces + done, n);
+                }
+                else
+                {
+                    aes_cfb_update(&ctx, message + done, pieces + done, n);
+                }
+                done += n;
+            }
+            aes_cfb_final(&ctx);
+            if (memcmp(pieces, decrypt ? message : whole, sizeof(message)) != 0)
+            {
+                failed = 1;
+            }
+        }
+    }
+
+    if (!failed) {
         printf(">> CFB test passed.\n\n");
     } else {
         printf(">> CFB test failed!\n\n");
     }
 }
 
+// AES-CTR against NIST SP 800-38A F.5.1 / F.5.5, counter wrap, and random seeks
+void test_aes_ctr()
+{
+    unsigned char key128[AES_KEY_SIZE] = {
+        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+        0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+    };
+    unsigned char key256[AES_256_KEY_SIZE] = {
+        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+    };
+    unsigned char iv[AES_BLOCK_SIZE] = {
+        0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+        0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+    };
+    unsigned char plaintext[64] = {
+        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+    };
+    unsigned char correct128[64] = {
+        0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+        0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+        0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e, 0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+        0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1, 0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee
+    };
+    unsigned char correct256[64] = {
+        0x60, 0x1e, 0xc3, 0x13, 0x77, 0x57, 0x89, 0xa5, 0xb7, 0xa7, 0xf5, 0x04, 0xbb, 0xf3, 0xd2, 0x28,
+        0xf4, 0x43, 0xe3, 0xca, 0x4d, 0x62, 0xb5, 0x9a, 0xca, 0x84, 0xe9, 0x90, 0xca, 0xca, 0xf5, 0xc5,
+        0x2b, 0x09, 0x30, 0xda, 0xa2, 0x3d, 0xe9, 0x4c, 0xe8, 0x70, 0x17, 0xba, 0x2d, 0x84, 0x98, 0x8d,
+        0xdf, 0xc9, 0xc5, 0x8d, 0xb6, 0x7a, 0xad, 0xa6, 0x13, 0xc2, 0xdd, 0x08, 0x45, 0x79, 0x41, 0xa6
+    };
+    static unsigned char message[1000];
+    static unsigned char whole[1000];
+    static unsigned char pieces[1000];
+    unsigned char output[64];
+    unsigned char block[AES_BLOCK_SIZE];
+    unsigned char expected[AES_BLOCK_SIZE];
+    aes_ctr_ctx ctx;
+    int failed = 0;
+
+    printf(">> Testing AES-CTR mode...\n");
+
+    if (aes_ctr_init(&ctx, key128, AES_KEY_SIZE, iv, 32) != 0)
+    {
+        printf("CTR init failed!\n");
+        return;
+    }
+    aes_ctr_update(&ctx, plaintext, output, sizeof(plaintext));
+    if (memcmp(output, correct128, sizeof(output)) != 0)
+    {
+        failed = 1;
+    }
+
+    aes_ctr_init(&ctx, key256, AES_256_KEY_SIZE, iv, 64);
+    aes_ctr_update(&ctx, plaintext, output, sizeof(plaintext));
+    if (memcmp(output, correct256, sizeof(output)) != 0)
+    {
+        failed = 1;
+    }
+
+    // Decrypt in place from the third block
+    aes_ctr_seek(&ctx, 2 * AES_BLOCK_SIZE);
+    aes_ctr_update(&ctx, output + 2 * AES_BLOCK_SIZE, output + 2 * AES_BLOCK_SIZE, 2 * AES_BLOCK_SIZE);
+    if (memcmp(output + 2 * AES_BLOCK_SIZE, plaintext + 2 * AES_BLOCK_SIZE, 2 * AES_BLOCK_SIZE) != 0)
+    {
+        failed = 1;
+    }
+
+    // 32-bit counter wraps without carrying into the nonce, 64-bit counter carries
+    unsigned char wrapIv[AES_BLOCK_SIZE] = {0};
+    memset(wrapIv + 12, 0xff, 4);
+    memset(block, 0, sizeof(block));
+    for (int bits = 32; bits <= 64; bits += 32)
+    {
+        unsigned char counter[AES_BLOCK_SIZE] = {0};
+        if (bits == 64)
+        {
+            counter[11] = 1;
+        }
+        aes_ctr_init(&ctx, key128, AES_KEY_SIZE, wrapIv, bits);
+        aes_ctr_crypt(block, output, AES_BLOCK_SIZE, &ctx.ks, wrapIv, bits, AES_BLOCK_SIZE);
+        aes_encrypt_block_ks(counter, &ctx.ks, expected);
+        if (memcmp(output, expected, AES_BLOCK_SIZE) != 0)
+        {
+            failed = 1;
+        }
+    }
+
+    // Offsets past 2^32 blocks are refused for the 32-bit counter only
+    if (aes_ctr_crypt(block, output, AES_BLOCK_SIZE, &ctx.ks, iv, 32, (uint64_t)1 << 36) == 0 ||
+        aes_ctr_crypt(block, output, AES_BLOCK_SIZE, &ctx.ks, iv, 64, (uint64_t)1 << 36) != 0 ||
+        aes_ctr_crypt(block, output, AES_BLOCK_SIZE, &ctx.ks, iv, 16, 0) == 0)
+    {
+        failed = 1;
+    }
+
+    // Random pieces at random offsets must match one call over the whole message
+    for (size_t i = 0; i < sizeof(message); i++)
+    {
+        message[i] = rand() & 0xFF;
+    }
+    aes_ctr_init(&ctx, key128, AES_KEY_SIZE, iv, 32);
+    aes_ctr_update(&ctx, message, whole, sizeof(message));
+    for (int t = 0; t < 200; t++)
+    {
+        size_t start = rand() % sizeof(message);
+        size_t len = rand() % (sizeof(message) - start + 1);
+        aes_ctr_seek(&ctx, start);
+        aes_ctr_update(&ctx, message + start, pieces, len);
+        if (memcmp(pieces, whole + start, len) != 0 || ctx.offset != start + len)
+        {
+            failed = 1;
+            break;
+        }
+    }
+
+    if (!failed)
+    {
+        printf(">> CTR test passed.\n\n");
+    }
+    else
+    {
+        printf(">> CTR test failed!\n\n");
+    }
+}
+
+// AES-GCM against the test cases of the GCM specification (McGrew & Viega), streaming, and forgery
+void test_aes_gcm()
+{
+    static const struct {
+        const char *key, *iv, *aad, *pt, *ct, *tag;
+    } vectors[] = {
+        // Test case 1
+        { "00000000000000000000000000000000", "000000000000000000000000", "", "", "",
+          "58e2fccefa7e3061367f1d57a4e7455a" },
+        // Test case 2
+        { "00000000000000000000000000000000", "000000000000000000000000", "",
+          "00000000000000000000000000000000", "0388dace60b6a392f328c2b971b2fe78",
+          "ab6e47d42cec13bdf53a67b21257bddf" },
+        // Test case 3
+        { "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", "",
+          "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+          "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+          "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+          "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985",
+          "4d5c2af327cd64a62cf35abd2ba6fab4" },
+        // Test case 4
+        { "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+          "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+          "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+          "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+          "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+          "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+          "5bc94fbc3221a5db94fae95ae7121a47" },
+        // Test case 5, 8-byte IV
+        { "feffe9928665731c6d6a8f9467308308", "cafebabefacedbad",
+          "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+          "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+          "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+          "61353b4c2806934a777ff51fa22a4755699b2a714fcdc6f83766e5f97b6c7423"
+          "73806900e49f24b22b097544d4896b424989b5e1ebac0f07c23f4598",
+          "3612d2e79e3b0785561be14aaca2fccb" },
+        // Test case 16, AES-256
+        { "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+          "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+          "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+          "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+          "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+          "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+          "76fc6ece0f4e1768cddf8853bb2d551b" },
+    };
+    unsigned char key[AES_256_KEY_SIZE], iv[64], aad[32], pt[64], ct[64], tag[AES_GCM_TAG_SIZE];
+    unsigned char output[64], outTag[AES_GCM_TAG_SIZE];
+    static unsigned char message[1000];
+    static unsigned char whole[1000];
+    static unsigned char pieces[1000];
+    unsigned char wholeTag[AES_GCM_TAG_SIZE];
+    aes_gcm_ctx ctx;
+    int failed = 0;
+
+    printf(">> Testing AES-GCM mode...\n");
+
+    for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v++)
+    {
+        size_t keyLen = hex_to_bytes(vectors[v].key, key);
+        size_t ivLen = hex_to_bytes(vectors[v].iv, iv);
+        size_t aadLen = hex_to_bytes(vectors[v].aad, aad);
+        size_t len = hex_to_bytes(vectors[v].pt, pt);
+        hex_to_bytes(vectors[v].ct, ct);
+        hex_to_bytes(vectors[v].tag, tag);
+
+        if (aes_gcm_init(&ctx, key, keyLen) != 0 ||
+            aes_gcm_encrypt(&ctx, iv, ivLen, aad, aadLen, pt, output, len, outTag, sizeof(outTag)) != 0 ||
+            memcmp(output, ct, len) != 0 || memcmp(outTag, tag, sizeof(tag)) != 0)
+        {
+            printf("GCM test case %d failed.\n", (int)v);
+            failed = 1;
+            continue;
+        }
+
+        if (aes_gcm_decrypt(&ctx, iv, ivLen, aad, aadLen, ct, output, len, tag, sizeof(tag)) != 0 ||
+            memcmp(output, pt, len) != 0)
+        {
+            failed = 1;
+        }
+
+        // Any flipped bit must be rejected
+        tag[0] ^= 0x80;
+        if (aes_gcm_decrypt(&ctx, iv, ivLen, aad, aadLen, ct, output, len, tag, sizeof(tag)) == 0)
+        {
+            failed = 1;
+        }
+    }
+
+    // Random update sizes must match the one-shot result, across both GHASH paths
+    for (size_t i = 0; i < sizeof(message); i++)
+    {
+        message[i] = rand() & 0xFF;
+    }
+    aes_gcm_init(&ctx, key, AES_KEY_SIZE);
+    aes_gcm_encrypt(&ctx, iv, AES_GCM_IV_SIZE, message, 37, message, whole, sizeof(message), wholeTag, sizeof(wholeTag));
+    for (int t = 0; t < 50; t++)
+    {
+        size_t done = 0, aadDone = 0;
+
+        aes_gcm_start(&ctx, iv, AES_GCM_IV_SIZE);
+        while (aadDone < 37)
+        {
+            size_t n = rand() % (37 - aadDone + 1);
+            aes_gcm_update_aad(&ctx, message + aadDone, n);
+            aadDone += n;
+        }
+        while (done < sizeof(message))
+        {
+            size_t n = rand() % 300;
+            if (n > sizeof(message) - done)
+            {
+                n = sizeof(message) - done;
+            }
+            aes_gcm_encrypt_update(&ctx, message + done, pieces + done, n);
+            done += n;
+        }
+        aes_gcm_final(&ctx, outTag, sizeof(outTag));
+        if (memcmp(pieces, whole, sizeof(message)) != 0 || memcmp(outTag, wholeTag, sizeof(outTag)) != 0)
+        {
+            failed = 1;
+            break;
+        }
+
+        aes_gcm_start(&ctx, iv, AES_GCM_IV_SIZE);
+        aes_gcm_update_aad(&ctx, message, 37);
+        for (done = 0; done < sizeof(message); done += 100)
+        {
+            aes_gcm_decrypt_update(&ctx, pieces + done, pieces + done, 100);
+        }
+        if (aes_gcm_verify(&ctx, wholeTag, sizeof(wholeTag)) != 0 || memcmp(pieces, message, sizeof(message)) != 0)
+        {
+            failed = 1;
+            break;
+        }
+    }
+
+    if (!failed)
+    {
+        printf(">> GCM test passed.\n\n");
+    }
+    else
+    {
+        printf(">> GCM test failed!\n\n");
+    }
+}
+
+void test_aes_xts()
+{
+    static const struct {
+        const char *key, *tweak, *pt, *ct;
+    } vectors[] = {
+        // IEEE 1619 vector 2
+        { "1111111111111111111111111111111122222222222222222222222222222222", "33333333330000000000000000000000",
+          "4444444444444444444444444444444444444444444444444444444444444444",
+          "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0" },
+        // Ciphertext stealing, 17 and 31 bytes
+        { "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0", "10325476980000000000000000000000",
+          "000102030405060708090a0b0c0d0e0f10", "30d627c292be5f6bf6b38b4a76d68dfc80" },
+        { "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0", "10325476980000000000000000000000",
+          "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e",
+          "f7e61f807223187ca4bfeb185aab25f780b533b3781a67926ebaab82f8ab4c" },
+    };
+    // IEEE 1619 vector 10: AES-256, 512-byte data unit 0xff
+    static const char *key10 = "2718281828459045235360287471352662497757247093699959574966967627"
+                               "3141592653589793238462643383279502884197169399375105820974944592";
+    static const char *ct10 =
+        "1c3b3a102f770386e4836c99e370cf9bea00803f5e482357a4ae12d414a3e63b"
+        "5d31e276f8fe4a8d66b317f9ac683f44680a86ac35adfc3345befecb4bb188fd"
+        "5776926c49a3095eb108fd1098baec70aaa66999a72a82f27d848b21d4a741b0"
+        "c5cd4d5fff9dac89aeba122961d03a757123e9870f8acf1000020887891429ca"
+        "2a3e7a7d7df7b10355165c8b9a6d0a7de8b062c4500dc4cd120c0f7418dae3d0"
+        "b5781c34803fa75421c790dfe1de1834f280d7667b327f6c8cd7557e12ac3a0f"
+        "93ec05c52e0493ef31a12d3d9260f79a289d6a379bc70c50841473d1a8cc81ec"
+        "583e9645e07b8d9670655ba5bbcfecc6dc3966380ad8fecb17b6ba02469a020a"
+        "84e18e8f84252070c13e9f1f289be54fbc481457778f616015e1327a02b140f1"
+        "505eb309326d68378f8374595c849d84f4c333ec4423885143cb47bd71c5edae"
+        "9be69a2ffeceb1bec9de244fbe15992b11b77c040f12bd8f6a975a44a0f90c29"
+        "a9abc3d4d893927284c58754cce294529f8614dcd2aba991925fedc4ae74ffac"
+        "6e333b93eb4aff0479da9a410e4450e0dd7ae4c6e2910900575da401fc07059f"
+        "645e8b7e9bfdef33943054ff84011493c27b3429eaedb4ed5376441a77ed4385"
+        "1ad77f16f541dfd269d50d6a5f14fb0aab1cbb4c1550be97f7ab4066193c4caa"
+        "773dad38014bd2092fa755c824bb5e54c4f36ffda9fcea70b9c6e693e148c151";
+    unsigned char key[2 * AES_256_KEY_SIZE], tweak[AES_BLOCK_SIZE], pt[32], ct[32], output[32];
+    static unsigned char sector[512], expected[512];
+    static unsigned char message[40 * 520];
+    static unsigned char whole[40 * 520];
+    aes_xts_ctx ctx;
+    int failed = 0;
+
+    printf(">> Testing AES-XTS mode...\n");
+
+    for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]) && !failed; v++)
+    {
+        size_t keyLen = hex_to_bytes(vectors[v].key, key);
+        size_t len = hex_to_bytes(vectors[v].pt, pt);
+        hex_to_bytes(vectors[v].tweak, tweak);
+        hex_to_bytes(vectors[v].ct, ct);
+
+        if (aes_xts_init(&ctx, key, keyLen, AES_BLOCK_SIZE) != 0)
+        {
+            failed = 1;
+            break;
+        }
+        aes_xts_encrypt(&ctx, pt, output, len, tweak);
+        if (memcmp(output, ct, len) != 0)
+        {
+            failed = 1;
+            break;
+        }
+        aes_xts_decrypt(&ctx, output, output, len, tweak);
+        if (memcmp(output, pt, len) != 0)
+        {
+            failed = 1;
+        }
+    }
+
+    // Sector API: sector 0xff of a 512-byte sector device
+    for (size_t i = 0; i < sizeof(sector); i++)
+    {
+        sector[i] = i & 0xFF;
+    }
+    hex_to_bytes(ct10, expected);
+    aes_xts_init(&ctx, key, hex_to_bytes(key10, key), sizeof(sector));
+    aes_xts_encrypt_sectors(&ctx, sector, sector, 0xff, 1);
+    if (memcmp(sector, expected, sizeof(sector)) != 0)
+    {
+        failed = 1;
+    }
+
+    // Many sectors of a size that is not a block multiple, against one data unit at a time
+    for (size_t i = 0; i < sizeof(message); i++)
+    {
+        message[i] = rand() & 0xFF;
+    }
+    aes_xts_init(&ctx, key, 2 * AES_KEY_SIZE, 520);
+    aes_xts_encrypt_sectors(&ctx, message, whole, 1000, 40);
+    for (uint64_t n = 0; n < 40 && !failed; n++)
+    {
+        memset(tweak, 0, sizeof(tweak));
+        for (int i = 0; i < 8; i++)
+        {
+            tweak[i] = ((1000 + n) >> (8 * i)) & 0xFF;
+        }
+        aes_xts_encrypt(&ctx, message + n * 520, expected, 520, tweak);
+        if (memcmp(expected, whole + n * 520, 520) != 0)
+        {
+            failed = 1;
+        }
+    }
+    aes_xts_decrypt_sectors(&ctx, whole, whole, 1000, 40);
+    if (memcmp(whole, message, sizeof(message)) != 0)
+    {
+        failed = 1;
+    }
+
+    // Data units shorter than a block and sector numbers that would wrap are rejected
+    if (aes_xts_encrypt(&ctx, message, output, AES_BLOCK_SIZE - 1, tweak) == 0 ||
+        aes_xts_encrypt_sectors(&ctx, message, whole, UINT64_MAX, 2) == 0 ||
+        aes_xts_init(&ctx, key, 2 * AES_KEY_SIZE, AES_BLOCK_SIZE - 1) == 0)
+    {
+        failed = 1;
+    }
+    aes_xts_final(&ctx);
+
+    if (!failed)
+    {
+        printf(">> XTS test passed.\n\n");
+    }
+    else
+    {
+        printf(">> XTS test failed!\n\n");
+    }
+}
+
+void test_aes_file()
+{
+    unsigned char key[AES_KEY_SIZE] = {
+        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+        0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+    };
+    unsigned char encSubKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE];
+    unsigned char decSubKeys[AES_EXPANDED_KEY_BLOCK][AES_BLOCK_SIZE];
+    unsigned char message[64], ciphertext[64 + AES_BLOCK_SIZE], decrypted[64 + AES_BLOCK_SIZE];
+    int failed = 0;
+
+    printf(">> Testing AES file interface (ECB + PKCS#7)...\n");
+
+    aes_make_enc_subkeys(key, encSubKeys);
+    aes_make_dec_subkeys(key, decSubKeys);
+    for (size_t i = 0; i < sizeof(message); i++)
+    {
+        message[i] = rand() & 0xFF;
+    }
+
+    // Every length gets at least one byte of padding, whole blocks get a full padding block
+    for (size_t len = 0; len <= sizeof(message) && !failed; len++)
+    {
+        size_t encLen, decLen;
+        if (aes_encrypt_file(message, len, encSubKeys, ciphertext, &encLen) != 0 ||
+            encLen != len / AES_BLOCK_SIZE * AES_BLOCK_SIZE + AES_BLOCK_SIZE ||
+            aes_decrypt_file(ciphertext, encLen, decSubKeys, decrypted, &decLen) != 0 ||
+            decLen != len || memcmp(decrypted, message, len) != 0)
+        {
+            failed = 1;
+        }
+    }
+
+    // A corrupted last block almost never decrypts to valid padding
+    size_t encLen, decLen;
+    aes_encrypt_file(message, 20, encSubKeys, ciphertext, &encLen);
+    ciphertext[31] ^= 0x01;
+    if (aes_decrypt_file(ciphertext, 32, decSubKeys, decrypted, &decLen) != 1 ||
+        aes_decrypt_file(ciphertext, 20, decSubKeys, decrypted, &decLen) != 1)
+    {
+        failed = 1;
+    }
+
+    if (!failed)
+    {
+        printf(">> File interface test passed.\n\n");
+    }
+    else
+    {
+        printf(">> File interface test failed!\n\n");
+    }
+}
+
+// Write a whole buffer to a new file
+static int write_file(const char *path, const unsigned char *data, size_t len)
+{
+    FILE *fp = fopen(path, "wb");
+    int ret;
+
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    ret = fwrite(data, 1, len, fp) != len;
+    return fclose(fp) != 0 || ret;
+}
+
+// Read a whole file into a malloc'ed buffer, NULL if it cannot be opened
+static unsigned char *read_file(const char *path, size_t *len)
+{
+    FILE *fp = fopen(path, "rb");
+    unsigned char *data;
+
+    if (fp == NULL)
+    {
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    *len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    data = malloc(*len + 1);
+    if (fread(data, 1, *len, fp) != *len)
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(fp);
+    return data;
+}
+
+// Encrypt / decrypt the same file with the mmap path API and the fd API, both must agree
+static int stream_round_trip(const char *plain, const char *cipher, const char *back, aes_file_mode mode,
+                             const unsigned char *key, size_t key_len, const unsigned char *iv,
+                             const unsigned char *message, size_t len)
+{
+    static const size_t extra[] = {0, AES_BLOCK_SIZE, AES_GCM_TAG_SIZE};
+    unsigned char *viaPath, *viaFd, *decrypted;
+    size_t pathLen, fdLen, decLen;
+    uint64_t outBytes;
+    int in_fd, out_fd, failed = 0;
+
+    if (write_file(plain, message, len) != 0 ||
+        aes_encrypt_path(plain, cipher, mode, key, key_len, iv, &outBytes) != 0)
+    {
+        return 1;
+    }
+    viaPath = read_file(cipher, &pathLen);
+
+    in_fd = open(plain, O_RDONLY);
+    out_fd = open(cipher, O_WRONLY | O_TRUNC);
+    if (aes_encrypt_fd(in_fd, out_fd, mode, key, key_len, iv, NULL) != 0)
+    {
+        failed = 1;
+    }
+    close(in_fd);
+    close(out_fd);
+    viaFd = read_file(cipher, &fdLen);
+
+    // CBC pads to the next whole block, GCM appends the tag
+    size_t expected = mode == AES_FILE_CBC ? len / AES_BLOCK_SIZE * AES_BLOCK_SIZE + AES_BLOCK_SIZE : len + extra[mode];
+    if (viaPath == NULL || viaFd == NULL || pathLen != expected || outBytes != expected ||
+        fdLen != pathLen || memcmp(viaPath, viaFd, pathLen) != 0)
+    {
+        failed = 1;
+    }
+
+    if (aes_decrypt_path(cipher, back, mode, key, key_len, iv, &outBytes) != 0)
+    {
+        failed = 1;
+    }
+    decrypted = read_file(back, &decLen);
+    if (decrypted == NULL || decLen != len || outBytes != len || memcmp(decrypted, message, len) != 0)
+    {
+        failed = 1;
+    }
+    free(decrypted);
+
+    in_fd = open(cipher, O_RDONLY);
+    out_fd = open(back, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (aes_decrypt_fd(in_fd, out_fd, mode, key, key_len, iv, NULL) != 0)
+    {
+        failed = 1;
+    }
+    close(in_fd);
+    close(out_fd);
+    decrypted = read_file(back, &decLen);
+    if (decrypted == NULL || decLen != len || memcmp(decrypted, message, len) != 0)
+    {
+        failed = 1;
+    }
+
+    free(decrypted);
+    free(viaPath);
+    free(viaFd);
+    return failed;
+}
+
+void test_aes_file_stream()
+{
+    static const char *modeNames[] = {"CTR", "CBC", "GCM"};
+    // Around the block size, the 32-byte hold-back and the chunk boundaries
+    const size_t sizes[] = {
+        0, 1, 15, 16, 17, 31, 32, 33, 47, 48,
+        AES_FILE_CHUNK - 1, AES_FILE_CHUNK + 2 * AES_BLOCK_SIZE, AES_FILE_CHUNK + 2 * AES_BLOCK_SIZE + 1,
+        AES_FILE_CHUNK + 3 * AES_BLOCK_SIZE, 3 * AES_FILE_CHUNK + 37
+    };
+    unsigned char key[AES_256_KEY_SIZE], iv[AES_BLOCK_SIZE], tag[AES_GCM_TAG_SIZE];
+    char plain[] = "/tmp/aes_stream_plain_XXXXXX";
+    char cipher[] = "/tmp/aes_stream_cipher_XXXXXX";
+    char back[] = "/tmp/aes_stream_back_XXXXXX";
+    size_t maxLen = 3 * AES_FILE_CHUNK + 37, len;
+    unsigned char *message = malloc(maxLen), *expected = malloc(maxLen), *data;
+    aes_key_schedule ks;
+    aes_gcm_ctx gcm;
+    int failed = 0;
+
+    printf(">> Testing AES streaming file encryption (CTR / CBC / GCM)...\n");
+
+    close(mkstemp(plain));
+    close(mkstemp(cipher));
+    close(mkstemp(back));
+    for (size_t i = 0; i < maxLen; i++)
+    {
+        message[i] = rand() & 0xFF;
+    }
+    for (size_t i = 0; i < sizeof(key); i++)
+    {
+        key[i] = rand() & 0xFF;
+    }
+    for (size_t i = 0; i < sizeof(iv); i++)
+    {
+        iv[i] = rand() & 0xFF;
+    }
+
+    for (int mode = AES_FILE_CTR; mode <= AES_FILE_GCM; mode++)
+    {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+        {
+            size_t key_len = i % 3 == 0 ? AES_KEY_SIZE : i % 3 == 1 ? AES_192_KEY_SIZE : AES_256_KEY_SIZE;
+            if (stream_round_trip(plain, cipher, back, mode, key, key_len, iv, message, sizes[i]) != 0)
+            {
+                printf(">> %s round trip of %zu bytes failed!\n", modeNames[mode], sizes[i]);
+                failed = 1;
+            }
+        }
+    }
+
+    // The file formats are the plain modes: CTR with a 64-bit counter, GCM with the tag appended
+    write_file(plain, message, maxLen);
+    aes_make_enc_key_schedule(key, AES_KEY_SIZE, &ks);
+    aes_ctr_crypt(message, expected, maxLen, &ks, iv, 64, 0);
+    aes_encrypt_path(plain, cipher, AES_FILE_CTR, key, AES_KEY_SIZE, iv, NULL);
+    data = read_file(cipher, &len);
+    if (data == NULL || len != maxLen || memcmp(data, expected, maxLen) != 0)
+    {
+        failed = 1;
+    }
+    free(data);
+
+    aes_gcm_init(&gcm, key, AES_KEY_SIZE);
+    aes_gcm_encrypt(&gcm, iv, AES_GCM_IV_SIZE, NULL, 0, message, expected, maxLen, tag, sizeof(tag));
+    aes_encrypt_path(plain, cipher, AES_FILE_GCM, key, AES_KEY_SIZE, iv, NULL);
+    data = read_file(cipher, &len);
+    if (data == NULL || len != maxLen + AES_GCM_TAG_SIZE || memcmp(data, expected, maxLen) != 0 ||
+        memcmp(data + maxLen, tag, sizeof(tag)) != 0)
+    {
+        failed = 1;
+    }
+
+    // A flipped ciphertext bit fails authentication and leaves no plaintext behind
+    data[maxLen / 2] ^= 0x01;
+    write_file(cipher, data, len);
+    if (aes_decrypt_path(cipher, back, AES_FILE_GCM, key, AES_KEY_SIZE, iv, NULL) != 1 || access(back, F_OK) == 0)
+    {
+        failed = 1;
+    }
+    free(data);
+
+    // CBC: a truncated file and a corrupted last block are both rejected
+    aes_encrypt_path(plain, cipher, AES_FILE_CBC, key, AES_KEY_SIZE, iv, NULL);
+    data = read_file(cipher, &len);
+    write_file(cipher, data, len - 1);
+    if (aes_decrypt_path(cipher, back, AES_FILE_CBC, key, AES_KEY_SIZE, iv, NULL) != 1)
+    {
+        failed = 1;
+    }
+    data[len - 1] ^= 0x01;
+    write_file(cipher, data, len);
+    if (aes_decrypt_path(cipher, back, AES_FILE_CBC, key, AES_KEY_SIZE, iv, NULL) != 1)
+    {
+        failed = 1;
+    }
+    free(data);
+
+    // Wrong key length and a missing input file
+    if (aes_encrypt_path(plain, cipher, AES_FILE_CTR, key, 20, iv, NULL) != 1 ||
+        aes_encrypt_path("/nonexistent/aes_stream", cipher, AES_FILE_CTR, key, AES_KEY_SIZE, iv, NULL) != 1)
+    {
+        failed = 1;
+    }
+
+    unlink(plain);
+    unlink(cipher);
+    unlink(back);
+    free(message);
+    free(expected);
+
+    if (!failed)
+    {
+        printf(">> Streaming file test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Streaming file test failed!\n\n");
+    }
+}
+
+// File to file throughput, page cache included
+void test_aes_file_stream_performance()
+{
+    static const char *modeNames[] = {"CTR", "CBC", "GCM"};
+    unsigned char key[AES_KEY_SIZE] = {0}, iv[AES_BLOCK_SIZE] = {0};
+    char plain[] = "/tmp/aes_stream_plain_XXXXXX";
+    char cipher[] = "/tmp/aes_stream_cipher_XXXXXX";
+    char back[] = "/tmp/aes_stream_back_XXXXXX";
+    unsigned char *message = malloc(STREAM_PERF_BYTES);
+    struct timespec t0, t1, t2;
+
+    close(mkstemp(plain));
+    close(mkstemp(cipher));
+    close(mkstemp(back));
+    for (size_t i = 0; i < STREAM_PERF_BYTES; i++)
+    {
+        message[i] = i & 0xFF;
+    }
+    write_file(plain, message, STREAM_PERF_BYTES);
+    free(message);
+
+    printf(">> Streaming file throughput (%d MiB, AES-128)...\n", STREAM_PERF_BYTES >> 20);
+    for (int mode = AES_FILE_CTR; mode <= AES_FILE_GCM; mode++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        aes_encrypt_path(plain, cipher, mode, key, AES_KEY_SIZE, iv, NULL);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        aes_decrypt_path(cipher, back, mode, key, AES_KEY_SIZE, iv, NULL);
+        clock_gettime(CLOCK_MONOTONIC, &t2);
+
+        double enc = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        double dec = (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec) / 1e9;
+        printf("%s file encryption: %.1f MB/s, decryption: %.1f MB/s\n", modeNames[mode],
+               STREAM_PERF_BYTES / enc / 1e6, STREAM_PERF_BYTES / dec / 1e6);
+    }
+    printf("\n");
+
+    unlink(plain);
+    unlink(cipher);
+    unlink(back);
+}
+
 int main()
 {
-    // Perform correctness test
-    printf(">> Performing correctness test...\n");
-    test_aes_correctness();
+    for (int impl = AES_IMPL_AUTO + 1; impl < AES_IMPL_COUNT; impl++)
+    {
+        if (aes_set_impl(impl) != 0)
+        {
+            printf(">> %s not supported by this CPU, skipped.\n\n", aes_impl_name(impl));
+            continue;
+        }
+        printf(">> Implementation: %s\n", aes_impl_name(impl));
 
-    // Perform performance test
-    printf(">> Performing performance test...\n");
-    test_aes_performance();
+        // Perform correctness test
+        printf(">> Performing correctness test...\n");
+        test_aes_correctness();
+        test_aes_key_schedule_correctness();
+        test_aes_long_key_correctness();
+        test_aes_key_agility();
+        test_aes_ecb_correctness();
+        test_aes_ctr();
+        test_aes_gcm();
+        test_aes_xts();
+        test_aes_file();
+
+        // The reference backend is only a correctness baseline, aes_bench compares speeds
+        if (impl == AES_IMPL_REFERENCE)
+        {
+            continue;
+        }
+
+        // Perform performance test
+        printf(">> Performing performance test...\n");
+        test_aes_performance();
+        test_aes_bulk_performance();
+    }
+
+    // Use the fastest implementation from here on
+    aes_set_impl(AES_IMPL_AUTO);
 
     // Add CFB mode test
     test_aes_cfb();
-    
+    test_aes_file_stream();
+    test_aes_file_stream_performance();
+
     return 0;
 }
-
-
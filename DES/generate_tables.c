@@ -0,0 +1,146 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "inc/des.h"
+
+/*
+ * 构建时生成 DES 查找表，输出到标准输出（由 Makefile 重定向为 des_tables.h）。
+ * 所有表都由 des.h 中的规范置换表与 S 盒经逐位置换 permute() 推导。
+ * IP/FP 由 swap-move 完成、PC1/PC2 已并入密钥编排差分，不再生成对应的字节查找表。
+ */
+
+// SPtrans：S 盒与 P 置换合并，结果为轮函数使用的位序
+static uint32_t SP_TABLE[8][64];
+
+// 密钥编号（见 des_key_from_index）每一位对应的密钥编排差分，格式同 des_key_schedule
+static uint32_t KS_DELTA[DES_KEY_BITS][2 * DES_ROUNDS];
+
+// 同上，格式同 des_make_subkeys 输出的 16 组 6 字节子密钥
+static uint8_t SUBKEY_DELTA[DES_KEY_BITS][DES_ROUNDS][6];
+
+// 标准位序（第 1 位为最高位）的第 k 位在 SPtrans 位序中位于第 (k + 2) % 32 位（低位为第 0 位）
+static uint32_t to_sp_order(uint32_t x) {
+    uint32_t r = 0;
+    for (int k = 1; k <= 32; k++) {
+        if ((x >> (32 - k)) & 1) {
+            r |= 1U << ((k + 2) % 32);
+        }
+    }
+    return r;
+}
+
+// SPtrans 下标为 E 扩展后 6 位分组的逆序：下标第 0 位是分组最高位
+static void make_sp_table(void) {
+    for (int i = 0; i < 8; i++) {
+        for (int v = 0; v < 64; v++) {
+            int e = 0;
+            for (int j = 0; j < 6; j++) {
+                e |= ((v >> j) & 1) << (5 - j);
+            }
+            int row = ((e >> 4) & 2) | (e & 1);
+            int col = (e >> 1) & 0xF;
+            uint32_t s = (uint32_t)S_BOXES[i][row * 16 + col] << (28 - 4 * i);
+            SP_TABLE[i][v] = to_sp_order((uint32_t)permute(s, 32, P, 32));
+        }
+    }
+}
+
+// 将一轮 48 位子密钥拆成轮函数使用的两个 32 位字，与 des.c 中 des_sp_subkey 相同
+static void pack_subkey(uint64_t subkey, uint32_t k[2]) {
+    uint64_t rev = 0;
+    for (int i = 0; i < 48; i++) {
+        rev |= ((subkey >> i) & 1) << (47 - i);
+    }
+
+    uint32_t even = 0, odd = 0;
+    for (int m = 0; m < 4; m++) {
+        even |= (uint32_t)((rev >> (12 * m)) & 0x3F) << (8 * m + 2);
+        odd  |= (uint32_t)((rev >> (12 * m + 6)) & 0x3F) << (8 * m + 2);
+    }
+    k[0] = even;
+    k[1] = (odd >> 28) | (odd << 4);
+}
+
+// 密钥编排只搬移位置，是密钥的线性函数：对只置一位的密钥按规范流程逐位计算即得该位的差分
+static void make_ks_delta(void) {
+    for (int i = 0; i < DES_KEY_BITS; i++) {
+        // 编号第 i 位位于 key[7 - i / 7] 的第 i % 7 + 1 位
+        uint64_t key64 = 1ULL << (8 * (i / 7) + i % 7 + 1);
+        uint64_t cd = permute(key64, 64, PC1, 56);
+        uint32_t c = (cd >> 28) & 0xFFFFFFF;
+        uint32_t d = cd & 0xFFFFFFF;
+
+        for (int r = 0; r < DES_ROUNDS; r++) {
+            c = ((c << rotations[r]) | (c >> (28 - rotations[r]))) & 0xFFFFFFF;
+            d = ((d << rotations[r]) | (d >> (28 - rotations[r]))) & 0xFFFFFFF;
+            uint64_t subkey = permute(((uint64_t)c << 28) | d, 56, PC2, 48);
+            pack_subkey(subkey, &KS_DELTA[i][2 * r]);
+            for (int j = 0; j < 6; j++) {
+                SUBKEY_DELTA[i][r][j] = (subkey >> (40 - 8 * j)) & 0xFF;
+            }
+        }
+    }
+}
+
+static void print_sp_table(void) {
+    printf("// S 盒与 P 置换合并的轮函数查找表，DES_SPtrans[i] 对应 S%d..S%d 中的第 i + 1 个 S 盒\n", 1, 8);
+    printf("static const uint32_t DES_SPtrans[8][64] = {\n");
+    for (int i = 0; i < 8; i++) {
+        printf("    {\n");
+        printf("        /* S%d */\n", i + 1);
+        for (int v = 0; v < 64; v += 4) {
+            printf("        0x%08xU, 0x%08xU, 0x%08xU, 0x%08xU,\n",
+                   SP_TABLE[i][v], SP_TABLE[i][v + 1], SP_TABLE[i][v + 2], SP_TABLE[i][v + 3]);
+        }
+        printf("    },\n");
+    }
+    printf("};\n\n");
+}
+
+static void print_ks_delta(void) {
+    printf("// 密钥编号每一位的密钥编排差分（des_key_schedule 格式），密钥编排为各置位对应行的异或\n");
+    printf("static const uint32_t DES_KS_DELTA[%d][%d] = {\n", DES_KEY_BITS, 2 * DES_ROUNDS);
+    for (int i = 0; i < DES_KEY_BITS; i++) {
+        printf("    {\n");
+        for (int w = 0; w < 2 * DES_ROUNDS; w += 8) {
+            printf("        ");
+            for (int j = 0; j < 8; j++) {
+                printf("0x%08xU,%s", KS_DELTA[i][w + j], j == 7 ? "\n" : " ");
+            }
+        }
+        printf("    },\n");
+    }
+    printf("};\n\n");
+
+    printf("// 同上，按 des_make_subkeys 输出的 16 组 6 字节子密钥排列\n");
+    printf("static const uint8_t DES_SUBKEY_DELTA[%d][%d][6] = {\n", DES_KEY_BITS, DES_ROUNDS);
+    for (int i = 0; i < DES_KEY_BITS; i++) {
+        printf("    {\n");
+        for (int r = 0; r < DES_ROUNDS; r += 4) {
+            printf("       ");
+            for (int k = r; k < r + 4; k++) {
+                printf(" { 0x%02x, 0x%02x, 0x%02x, 0x%02x, 0x%02x, 0x%02x },",
+                       SUBKEY_DELTA[i][k][0], SUBKEY_DELTA[i][k][1], SUBKEY_DELTA[i][k][2],
+                       SUBKEY_DELTA[i][k][3], SUBKEY_DELTA[i][k][4], SUBKEY_DELTA[i][k][5]);
+            }
+            printf("\n");
+        }
+        printf("    },\n");
+    }
+    printf("};\n\n");
+}
+
+int main(void) {
+    make_sp_table();
+    make_ks_delta();
+
+    printf("/* Generated by generate_tables.c from the tables in des.h, do not edit. */\n");
+    printf("#ifndef DES_TABLES_H\n");
+    printf("#define DES_TABLES_H\n\n");
+    printf("#include <stdint.h>\n\n");
+
+    print_sp_table();
+    print_ks_delta();
+    printf("#endif // DES_TABLES_H\n");
+
+    return 0;
+}
@@ -67,6 +67,16 @@
     }
 
 
+     /**
+      * Prints the rate of FUNCTION with (K/M/G)ops/s, e.g. key setups per second
+      * @param[in] OPS                  -operations performed by one call of FUNCTION
+      */
+#define OPS_BENCH_FINAL(_OPS)                                    \
+    }                                                            \
+    print_sc_ops(time_t, benchs_, retrys, (_OPS)); \
+    }
+
+
       /*============================================================================*/
       /* Function definitions                                                       */
       /*============================================================================*/
@@ -92,6 +102,11 @@ extern "C" { /* start of __cplusplus */
      */
     void print_sc_bps(const uint64_t *t, int benches, int rounds, int block_size);
 
+    /**
+     * Prints the last benchmark with operations per second.
+     */
+    void print_sc_ops(const uint64_t *t, int benches, int rounds, int ops);
+
 #ifdef __cplusplus
 } /* end of __cplusplus */
 #endif
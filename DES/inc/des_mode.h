@@ -0,0 +1,106 @@
+#ifndef DES_MODE_H
+#define DES_MODE_H
+
+#include "des.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief DES block cipher modes of operation
+     */
+    typedef enum {
+        DES_MODE_ECB, /* PKCS#7 padded */
+        DES_MODE_CBC, /* PKCS#7 padded */
+        DES_MODE_CFB, /* CFB-64, stream */
+        DES_MODE_OFB, /* stream */
+        DES_MODE_CTR  /* 64-bit big-endian counter, stream */
+    } des_mode;
+
+    /**
+     * @brief Streaming mode context, the key schedule is computed once in des_mode_init
+     */
+    typedef struct {
+        des_key_schedule ks;
+        des_mode mode;
+        int decrypt;
+        unsigned char iv[DES_BLOCK_SIZE];  /* chaining value, CFB/OFB register or counter */
+        unsigned char buf[DES_BLOCK_SIZE]; /* pending input (ECB/CBC) or unused keystream (CTR) */
+        size_t num;                        /* bytes in buf (ECB/CBC) or keystream offset (CFB/OFB/CTR) */
+    } des_mode_ctx;
+
+    /**
+     * @brief Initialize a mode context
+     * @param[out] ctx context
+     * @param[in] mode mode of operation
+     * @param[in] decrypt 0 encrypt, 1 decrypt
+     * @param[in] key original key, [length = DES_KEY_SIZE]
+     * @param[in] iv initialization vector / initial counter, [length = DES_BLOCK_SIZE], ignored for ECB
+     * @return 0 OK
+     * @return 1 Failed
+     */
+    int des_mode_init(des_mode_ctx *ctx, des_mode mode, int decrypt,
+                      const unsigned char key[DES_KEY_SIZE], const unsigned char iv[DES_BLOCK_SIZE]);
+
+    /**
+     * @brief Process the next part of the message
+     * @param[in,out] ctx context
+     * @param[in] input input data
+     * @param[in] input_len input length (bytes), any value
+     * @param[out] output output buffer, [length >= input_len + DES_BLOCK_SIZE]
+     * @param[out] output_len bytes written
+     * @return 0 OK
+     * @return 1 Failed
+     */
+    int des_mode_update(des_mode_ctx *ctx, const unsigned char *input, size_t input_len,
+                        unsigned char *output, size_t *output_len);
+
+    /**
+     * @brief Finish the message: add (encrypt) or check and strip (decrypt) PKCS#7 padding for ECB/CBC
+     * @param[in,out] ctx context
+     * @param[out] output output buffer, [length >= DES_BLOCK_SIZE]
+     * @param[out] output_len bytes written
+     * @return 0 OK
+     * @return 1 Failed (incomplete last block or bad padding)
+     */
+    int des_mode_final(des_mode_ctx *ctx, unsigned char *output, size_t *output_len);
+
+    /**
+     * @brief DES-CBC encrypt whole blocks
+     * @param[in] input plaintext, [length = nblocks * DES_BLOCK_SIZE]
+     * @param[out] output ciphertext, [length = nblocks * DES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] ks key schedule
+     * @param[in,out] iv initialization vector, updated to the last ciphertext block
+     */
+    void des_cbc_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                         const des_key_schedule *ks, unsigned char iv[DES_BLOCK_SIZE]);
+
+    /**
+     * @brief DES-CBC decrypt whole blocks, the block decryptions are batched
+     * @param[in] input ciphertext, [length = nblocks * DES_BLOCK_SIZE]
+     * @param[out] output plaintext, [length = nblocks * DES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] ks key schedule
+     * @param[in,out] iv initialization vector, updated to the last ciphertext block
+     */
+    void des_cbc_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                         const des_key_schedule *ks, unsigned char iv[DES_BLOCK_SIZE]);
+
+    /**
+     * @brief DES-CTR encrypt / decrypt starting at a block boundary
+     * @param[in] input input data
+     * @param[out] output output data, [length = len], may equal input
+     * @param[in] len length (bytes), any value
+     * @param[in] ks key schedule
+     * @param[in,out] counter counter block of the first block, advanced by ceil(len / DES_BLOCK_SIZE)
+     */
+    void des_ctr_crypt(const unsigned char *input, unsigned char *output, size_t len,
+                       const des_key_schedule *ks, unsigned char counter[DES_BLOCK_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DES_MODE_H
@@ -0,0 +1,100 @@
+#ifndef DES_THREAD_H
+#define DES_THREAD_H
+
+#include "des.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DES_THREAD_DEFAULT_CHUNK 4096 /* blocks per chunk when 0 is given */
+
+    /**
+     * @brief Worker thread pool for multithreaded bulk encryption
+     */
+    typedef struct des_thread_pool des_thread_pool;
+
+    /**
+     * @brief Create a thread pool
+     * @param[in] nthreads number of threads working on a call, including the caller; 0 = online CPUs
+     * @param[in] chunk_blocks blocks per chunk handed to a thread; 0 = DES_THREAD_DEFAULT_CHUNK
+     * @return pool, NULL on failure
+     */
+    des_thread_pool *des_thread_pool_create(int nthreads, size_t chunk_blocks);
+
+    /**
+     * @brief Stop the workers and free the pool
+     * @param[in] pool pool, may be NULL
+     */
+    void des_thread_pool_destroy(des_thread_pool *pool);
+
+    /**
+     * @brief Multithreaded DES-ECB encrypt (bitsliced engine per chunk)
+     * @param[in] pool thread pool
+     * @param[in] input plaintext, [length = nblocks * DES_BLOCK_SIZE]
+     * @param[out] output ciphertext, [length = nblocks * DES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] ks key schedule
+     */
+    void des_ecb_encrypt_mt(des_thread_pool *pool, const unsigned char *input, unsigned char *output,
+                            size_t nblocks, const des_key_schedule *ks);
+
+    /**
+     * @brief Multithreaded DES-ECB decrypt (bitsliced engine per chunk)
+     * @param[in] pool thread pool
+     * @param[in] input ciphertext, [length = nblocks * DES_BLOCK_SIZE]
+     * @param[out] output plaintext, [length = nblocks * DES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] ks key schedule
+     */
+    void des_ecb_decrypt_mt(des_thread_pool *pool, const unsigned char *input, unsigned char *output,
+                            size_t nblocks, const des_key_schedule *ks);
+
+    /**
+     * @brief Multithreaded DES-CTR encrypt / decrypt (bitsliced engine per chunk), same result as des_ctr_crypt
+     * @param[in] pool thread pool
+     * @param[in] input input data
+     * @param[out] output output data, [length = len], may equal input
+     * @param[in] len length (bytes), any value
+     * @param[in] ks key schedule
+     * @param[in,out] counter counter block of the first block, advanced by ceil(len / DES_BLOCK_SIZE)
+     */
+    void des_ctr_crypt_mt(des_thread_pool *pool, const unsigned char *input, unsigned char *output,
+                          size_t len, const des_key_schedule *ks, unsigned char counter[DES_BLOCK_SIZE]);
+
+    /**
+     * @brief Multithreaded DES-CBC decrypt (bitsliced engine per chunk), same result as des_cbc_decrypt
+     * @param[in] pool thread pool
+     * @param[in] input ciphertext, [length = nblocks * DES_BLOCK_SIZE]
+     * @param[out] output plaintext, [length = nblocks * DES_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] ks key schedule
+     * @param[in,out] iv initialization vector, updated to the last ciphertext block
+     * @return 0 OK
+     * @return 1 Failed (out of memory)
+     */
+    int des_cbc_decrypt_mt(des_thread_pool *pool, const unsigned char *input, unsigned char *output,
+                           size_t nblocks, const des_key_schedule *ks, unsigned char iv[DES_BLOCK_SIZE]);
+
+    /**
+     * @brief Multithreaded known-plaintext key search, same range semantics as des_key_search
+     * Each chunk tests chunk_blocks keys; chunks stop early once a key is found
+     * @param[in] pool thread pool
+     * @param[in] plaintext known plaintext, [length = DES_BLOCK_SIZE]
+     * @param[in] ciphertext known ciphertext, [length = DES_BLOCK_SIZE]
+     * @param[in] deltas key schedule differences
+     * @param[in] first first Gray-code position
+     * @param[in] count number of keys to test, clipped at 2^DES_KEY_BITS
+     * @param[out] found key index of a matching key
+     * @return 0 OK (key found)
+     * @return 1 Failed (no key in range)
+     */
+    int des_key_search_mt(des_thread_pool *pool, const unsigned char plaintext[DES_BLOCK_SIZE],
+                          const unsigned char ciphertext[DES_BLOCK_SIZE], const des_key_deltas *deltas,
+                          uint64_t first, uint64_t count, uint64_t *found);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DES_THREAD_H
@@ -119,3 +119,32 @@ void print_sc_bps(const uint64_t *t, int benches, int rounds, int block_size)
     printf("\n");
 }
 
+void print_sc_ops(const uint64_t *t, int benches, int rounds, int ops)
+{
+    if (benches < 2)
+    {
+        fprintf(stderr, "ERROR: Need a least two bench counts!\n");
+        return;
+    }
+
+    uint64_t acc = 0;
+
+    for (int i = 0; i < benches; i++) acc += t[i];
+
+    double count = (double)benches * rounds * ops;
+
+    double secend = (double)acc / NSPERS;
+
+    double rate = count / secend;// ops/s
+
+    printf("Execute time: %f s\n", secend);
+    if (rate < 1e3) printf("Rate: %f ops/s\n", rate);
+    else if (rate < 1e6)
+        printf("Rate: %f Kops/s\n", rate / 1e3);
+    else if (rate < 1e9)
+        printf("Rate: %f Mops/s\n", rate / 1e6);
+    else
+        printf("Rate: %f Gops/s\n", rate / 1e9);
+
+    printf("\n");
+}
@@ -1,145 +1,447 @@
 #include "../inc/des.h"
+#include "des_tables.h"
 #include <string.h>
 
+// 32 位循环右移
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
 
-int des_make_subkeys(const unsigned char key[8], unsigned char subKeys[16][6]) {
-    // 将输入的 8 字节密钥转换为 64 位整型
-    uint64_t key64 = 0;
-    for (int i = 0; i < 8; i++) {
-        key64 |= ((uint64_t)key[i] << (56 - 8 * i));
-    }
+// SPtrans 轮函数：E 扩展隐含在 R 的循环移位中，S 盒与 P 置换合并为 8 次查表
+// u/t 的每个字节中第 2~7 位即为一个 S 盒的 6 位输入（位序与标准相反）
+#define DES_SP_ROUND(LL, R, K0, K1) {                   \
+        uint32_t u_ = (R) ^ (K0);                       \
+        uint32_t t_ = ROTR32((R) ^ (K1), 4);            \
+        (LL) ^= DES_SPtrans[0][(u_ >>  2) & 0x3f] ^     \
+                DES_SPtrans[2][(u_ >> 10) & 0x3f] ^     \
+                DES_SPtrans[4][(u_ >> 18) & 0x3f] ^     \
+                DES_SPtrans[6][(u_ >> 26) & 0x3f] ^     \
+                DES_SPtrans[1][(t_ >>  2) & 0x3f] ^     \
+                DES_SPtrans[3][(t_ >> 10) & 0x3f] ^     \
+                DES_SPtrans[5][(t_ >> 18) & 0x3f] ^     \
+                DES_SPtrans[7][(t_ >> 26) & 0x3f]; }
 
-    // 应用 PC1 置换，将 64 位密钥压缩到 56 位
-    uint64_t permuted_key = permute(key64, 64, PC1, 56);
+// 交换 a 中移位 n 后与 b 中掩码 m 选中的位（swap-move）
+#define PERM_OP(a, b, t, n, m) ((t) = ((((a) >> (n)) ^ (b)) & (m)), \
+                                (b) ^= (t),                          \
+                                (a) ^= ((t) << (n)))
 
-    // 分离左 28 位和右 28 位
-    uint32_t left = (permuted_key >> 28) & 0xFFFFFFF;  // 取高 28 位
-    uint32_t right = permuted_key & 0xFFFFFFF;         // 取低 28 位
+// 初始置换 IP：输入为按小端装载的两个 32 位字，输出即为 SPtrans 位序（循环移位前）的左右两半
+#define DES_IP(l, r) {                                  \
+        uint32_t tt_;                                   \
+        PERM_OP(r, l, tt_,  4, 0x0f0f0f0fU);            \
+        PERM_OP(l, r, tt_, 16, 0x0000ffffU);            \
+        PERM_OP(r, l, tt_,  2, 0x33333333U);            \
+        PERM_OP(l, r, tt_,  8, 0x00ff00ffU);            \
+        PERM_OP(r, l, tt_,  1, 0x55555555U); }
 
-    // 生成 16 个子密钥
-    for (int i = 0; i < 16; i++) {
-        // 左右部分分别循环左移
-        left = ((left << rotations[i]) | (left >> (28 - rotations[i]))) & 0xFFFFFFF;
-        right = ((right << rotations[i]) | (right >> (28 - rotations[i]))) & 0xFFFFFFF;
+// 逆初始置换 IP^-1：DES_IP 的逆过程
+#define DES_FP(l, r) {                                  \
+        uint32_t tt_;                                   \
+        PERM_OP(l, r, tt_,  1, 0x55555555U);            \
+        PERM_OP(r, l, tt_,  8, 0x00ff00ffU);            \
+        PERM_OP(l, r, tt_,  2, 0x33333333U);            \
+        PERM_OP(r, l, tt_, 16, 0x0000ffffU);            \
+        PERM_OP(l, r, tt_,  4, 0x0f0f0f0fU); }
+
+// 小端装载/存储 32 位字
+#define LOAD32_LE(p) ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | \
+                      ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+#define STORE32_LE(p, v) { (p)[0] = (unsigned char)(v);         \
+                           (p)[1] = (unsigned char)((v) >> 8);  \
+                           (p)[2] = (unsigned char)((v) >> 16); \
+                           (p)[3] = (unsigned char)((v) >> 24); }
 
-        // 合并左右部分为 56 位
-        uint64_t combined = ((uint64_t)left << 28) | (uint64_t)right;
+// 32 位按位逆序
+static inline uint32_t bit_reverse32(uint32_t x) {
+    x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+    x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F) | ((x & 0x0F0F0F0F) << 4);
+    return __builtin_bswap32(x);
+}
 
-        // 应用 PC2 置换，将 56 位压缩到 48 位
-        uint64_t subkey = permute(combined, 56, PC2, 48);
+// 将一轮 48 位子密钥拆成与 DES_SP_ROUND 中 u、t 对齐的两个 32 位字
+static inline void des_sp_subkey(const unsigned char subKey[6], uint32_t k[2]) {
+    // 48 位整体逆序后，第 j 组 6 位恰好逆序落在 [6j, 6j + 6) 处
+    uint32_t hi = bit_reverse32(((uint32_t)subKey[0] << 24) | ((uint32_t)subKey[1] << 16) |
+                                ((uint32_t)subKey[2] << 8) | subKey[3]);
+    uint32_t lo = bit_reverse32(((uint32_t)subKey[4] << 8) | subKey[5]) >> 16;
+    uint64_t rev = ((uint64_t)lo << 32) | hi;
 
-        // 将生成的 48 位子密钥存储到子密钥数组
-        for (int j = 0; j < 6; j++) {
-            subKeys[i][j] = (subkey >> (40 - 8 * j)) & 0xFF;
-        }
+    uint32_t even = 0, odd = 0;
+    for (int m = 0; m < 4; m++) {
+        even |= (uint32_t)((rev >> (12 * m)) & 0x3F) << (8 * m + 2);
+        odd  |= (uint32_t)((rev >> (12 * m + 6)) & 0x3F) << (8 * m + 2);
+    }
+    k[0] = even;
+    k[1] = ROTR32(odd, 28);
+}
+
+// 16 轮迭代（SPtrans 位序），ks 为 16 组 des_sp_subkey 输出
+static inline void des_sp_encrypt_rounds(uint32_t *left, uint32_t *right, const uint32_t ks[32]) {
+    uint32_t l = *left, r = *right;
+    for (int i = 0; i < 32; i += 4) {
+        DES_SP_ROUND(l, r, ks[i], ks[i + 1]);
+        DES_SP_ROUND(r, l, ks[i + 2], ks[i + 3]);
+    }
+    *left = l;
+    *right = r;
+}
+
+static inline void des_sp_decrypt_rounds(uint32_t *left, uint32_t *right, const uint32_t ks[32]) {
+    uint32_t l = *left, r = *right;
+    for (int i = 30; i > 0; i -= 4) {
+        DES_SP_ROUND(l, r, ks[i], ks[i + 1]);
+        DES_SP_ROUND(r, l, ks[i - 2], ks[i - 1]);
     }
+    *left = l;
+    *right = r;
+}
+
+
+int des_make_subkeys(const unsigned char key[8], unsigned char subKeys[16][6]) {
+    unsigned char w[16 * 6] = { 0 };
 
-    // // 调试打印生成的子密钥
-    // for (int i = 0; i < 16; i++) {
-    //     printf("Subkey %d: ", i + 1);
-    //     for (int j = 0; j < 6; j++) {
-    //         printf("%02X ", subKeys[i][j]);
-    //     }
-    //     printf("\n");
-    // }
+    // 与 des_make_key_schedule 相同，按掩码异或各密钥位对应的子密钥差分，运行时间与密钥无关
+    for (int j = 0; j < DES_KEY_SIZE; j++) {
+        unsigned char byte = key[DES_KEY_SIZE - 1 - j];
+        for (int b = 0; b < 7; b++) {
+            unsigned char mask = (unsigned char)(0U - ((byte >> (b + 1)) & 1));
+            const unsigned char *delta = &DES_SUBKEY_DELTA[7 * j + b][0][0];
+            for (int i = 0; i < 16 * 6; i++) {
+                w[i] ^= delta[i] & mask;
+            }
+        }
+    }
 
+    memcpy(subKeys, w, sizeof(w));
     return 0;
 }
 
-uint32_t feistel(uint32_t right, uint64_t subKey) {
-    // 扩展置换 E
-    uint64_t expanded = 0;
-    
-    uint8_t block0 = (right >> 24) & 0xFF;
-    uint8_t block1 = (right >> 16) & 0xFF;
-    uint8_t block2 = (right >> 8) & 0xFF;
-    uint8_t block3 = right & 0xFF;
-    
-    // 使用查找表对每个 block 查表并合并结果
-    expanded |= E_TABLE[0][block0];
-    expanded |= E_TABLE[1][block1];
-    expanded |= E_TABLE[2][block2];
-    expanded |= E_TABLE[3][block3];
+// 初始置换后转入 SPtrans 位序（左右两半各循环右移 29 位）
+static inline void des_initial_permutation(const unsigned char *input, uint32_t *left, uint32_t *right) {
+    uint32_t r = LOAD32_LE(input);
+    uint32_t l = LOAD32_LE(input + 4);
 
-    // 与子密钥进行异或
-    uint64_t xor_result = expanded ^ subKey;
+    DES_IP(r, l);
+
+    *left = ROTR32(l, 29);
+    *right = ROTR32(r, 29);
+}
 
-    // S 盒替换
-    uint32_t sbox_output = S_BOX(xor_result);
+// 左右交换后做逆初始置换，输出 8 字节
+static inline void des_final_permutation(uint32_t left, uint32_t right, unsigned char *output) {
+    uint32_t l = ROTR32(left, 3);
+    uint32_t r = ROTR32(right, 3);
 
-    // P 置换
-    uint32_t result = (uint32_t)permute(sbox_output, 32, P, 32);
+    DES_FP(r, l);
 
-    return result;
+    STORE32_LE(output, l);
+    STORE32_LE(output + 4, r);
 }
 
 void des_encrypt_block(const unsigned char *input, unsigned char subKeys[16][6], unsigned char *output) {
-    // 将输入字节转换为 64 位块
-    uint64_t block = 0;
-    for (int i = 0; i < 8; i++) {
-        block |= ((uint64_t)input[i] << (56 - 8 * i));
+    uint32_t ks[32];
+    for (int i = 0; i < 16; i++) {
+        des_sp_subkey(subKeys[i], &ks[2 * i]);
     }
 
-    // 初始置换
-    uint64_t permuted = permute(block, 64, IP, 64);
-
-    // 分割为左、右 32 位
+    // 初始置换并分割为左、右 32 位
     uint32_t left, right;
-    SPLIT_BLOCK(permuted, left, right);
+    des_initial_permutation(input, &left, &right);
 
     // 16 轮迭代
+    des_sp_encrypt_rounds(&left, &right, ks);
+
+    // 交换左右部分并逆初始置换
+    des_final_permutation(left, right, output);
+}
+
+
+void des_decrypt_block(const unsigned char *input, unsigned char subKeys[16][6], unsigned char *output) {
+    uint32_t ks[32];
     for (int i = 0; i < 16; i++) {
-        uint32_t temp = right;
-        uint64_t subKey = bytes_to_uint48(subKeys[i]);
-        uint32_t feistel_result = feistel(right, subKey);
-        right = left ^ feistel_result;
-        left = temp;
+        des_sp_subkey(subKeys[i], &ks[2 * i]);
     }
 
-    // 合并并交换左右部分
-    uint64_t preoutput = COMBINE_BLOCK(right, left);
+    // 初始置换并分割为左、右 32 位
+    uint32_t left, right;
+    des_initial_permutation(input, &left, &right);
+
+    // 16 轮迭代（子密钥顺序相反）
+    des_sp_decrypt_rounds(&left, &right, ks);
+
+    // 交换左右部分并逆初始置换
+    des_final_permutation(left, right, output);
+}
 
-    // 逆初始置换
-    uint64_t final_output = permute(preoutput, 64, IP_INV, 64);
 
-    // 把输出的结果转换为字节
-    for (int i = 0; i < 8; i++) {
-        output[i] = (final_output >> (56 - 8 * i)) & 0xFF;
+int des_make_key_schedule(const unsigned char key[8], des_key_schedule *ks) {
+    uint32_t w[2 * DES_ROUNDS] = { 0 };
+
+    // 密钥编排是密钥位的线性函数，逐位按掩码异或该位的差分：
+    // 不依赖密钥做分支或查表下标，运行时间与密钥无关
+    for (int j = 0; j < DES_KEY_SIZE; j++) {
+        uint32_t byte = key[DES_KEY_SIZE - 1 - j];
+        for (int b = 0; b < 7; b++) {
+            uint32_t mask = 0U - ((byte >> (b + 1)) & 1);
+            const uint32_t *delta = DES_KS_DELTA[7 * j + b];
+            for (int i = 0; i < 2 * DES_ROUNDS; i++) {
+                w[i] ^= delta[i] & mask;
+            }
+        }
     }
+
+    memcpy(ks->ks, w, sizeof(w));
+    return 0;
 }
 
+void des_encrypt_block_ks(const unsigned char *input, const des_key_schedule *ks, unsigned char *output) {
+    uint32_t left, right;
+    des_initial_permutation(input, &left, &right);
+    des_sp_encrypt_rounds(&left, &right, ks->ks);
+    des_final_permutation(left, right, output);
+}
 
-void des_decrypt_block(const unsigned char *input, unsigned char subKeys[16][6], unsigned char *output) {
-    // 将输入字节转换为 64 位块
-    uint64_t block = 0;
-    for (int i = 0; i < 8; i++) {
-        block |= ((uint64_t)input[i] << (56 - 8 * i));
+void des_decrypt_block_ks(const unsigned char *input, const des_key_schedule *ks, unsigned char *output) {
+    uint32_t left, right;
+    des_initial_permutation(input, &left, &right);
+    des_sp_decrypt_rounds(&left, &right, ks->ks);
+    des_final_permutation(left, right, output);
+}
+
+
+void des_key_from_index(uint64_t index, unsigned char key[DES_KEY_SIZE]) {
+    // 每字节高 7 位为有效位，最低位为奇偶校验位（DES 忽略）
+    for (int j = 0; j < DES_KEY_SIZE; j++) {
+        key[DES_KEY_SIZE - 1 - j] = (unsigned char)(((index >> (7 * j)) & 0x7F) << 1);
+    }
+}
+
+int des_make_key_deltas(des_key_deltas *deltas) {
+    // 各位差分在构建时已生成，见 generate_tables.c
+    for (int i = 0; i < DES_KEY_BITS; i++) {
+        memcpy(deltas->bit[i].ks, DES_KS_DELTA[i], sizeof(deltas->bit[i].ks));
     }
 
-    // 初始置换
-    uint64_t permuted = permute(block, 64, IP, 64);
+    return 0;
+}
 
-    // 分割为左、右 32 位
+void des_key_schedule_flip(des_key_schedule *ks, const des_key_deltas *deltas, int bit) {
+    for (int i = 0; i < 2 * DES_ROUNDS; i++) {
+        ks->ks[i] ^= deltas->bit[bit].ks[i];
+    }
+}
+
+int des_key_search(const unsigned char plaintext[DES_BLOCK_SIZE], const unsigned char ciphertext[DES_BLOCK_SIZE],
+                   const des_key_deltas *deltas, uint64_t first, uint64_t count, uint64_t *found) {
+    const uint64_t limit = (uint64_t)1 << DES_KEY_BITS;
+    unsigned char key[DES_KEY_SIZE];
+    des_key_schedule ks;
+    uint32_t pl, pr, cl, cr;
+
+    if (first >= limit || count == 0) {
+        return 1;
+    }
+    if (count > limit - first) {
+        count = limit - first;
+    }
+
+    // 明文的初始置换只做一次；密文做初始置换即为末轮输出在逆初始置换之前的状态
+    des_initial_permutation(plaintext, &pl, &pr);
+    des_initial_permutation(ciphertext, &cr, &cl);
+
+    des_key_from_index(first ^ (first >> 1), key);
+    if (des_make_key_schedule(key, &ks) != 0) {
+        return 1;
+    }
+
+    for (uint64_t n = first;;) {
+        uint32_t left = pl, right = pr;
+        des_sp_encrypt_rounds(&left, &right, ks.ks);
+        if (left == cl && right == cr) {
+            *found = n ^ (n >> 1);
+            return 0;
+        }
+
+        if (++n == first + count) {
+            break;
+        }
+
+        // 格雷码相邻编号只差第 ctz(n) 位，异或该位的差分即得下一个密钥的编排
+        des_key_schedule_flip(&ks, deltas, __builtin_ctzll(n));
+    }
+
+    return 1;
+}
+
+
+// 交错执行的分组数：各分组的查表互不依赖，可以重叠访存延迟
+#define DES_INTERLEAVE 4
+
+static inline void des_sp_encrypt_rounds_x4(uint32_t l[DES_INTERLEAVE], uint32_t r[DES_INTERLEAVE], const uint32_t ks[32]) {
+    for (int i = 0; i < 32; i += 4) {
+        for (int b = 0; b < DES_INTERLEAVE; b++) {
+            DES_SP_ROUND(l[b], r[b], ks[i], ks[i + 1]);
+        }
+        for (int b = 0; b < DES_INTERLEAVE; b++) {
+            DES_SP_ROUND(r[b], l[b], ks[i + 2], ks[i + 3]);
+        }
+    }
+}
+
+static inline void des_sp_decrypt_rounds_x4(uint32_t l[DES_INTERLEAVE], uint32_t r[DES_INTERLEAVE], const uint32_t ks[32]) {
+    for (int i = 30; i > 0; i -= 4) {
+        for (int b = 0; b < DES_INTERLEAVE; b++) {
+            DES_SP_ROUND(l[b], r[b], ks[i], ks[i + 1]);
+        }
+        for (int b = 0; b < DES_INTERLEAVE; b++) {
+            DES_SP_ROUND(r[b], l[b], ks[i - 2], ks[i - 1]);
+        }
+    }
+}
+
+static void des_ecb_crypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                          const des_key_schedule *ks, int decrypt) {
+    uint32_t l[DES_INTERLEAVE], r[DES_INTERLEAVE];
+    size_t i = 0;
+
+    for (; i + DES_INTERLEAVE <= nblocks; i += DES_INTERLEAVE) {
+        for (int b = 0; b < DES_INTERLEAVE; b++) {
+            des_initial_permutation(input + (i + b) * DES_BLOCK_SIZE, &l[b], &r[b]);
+        }
+        if (decrypt) {
+            des_sp_decrypt_rounds_x4(l, r, ks->ks);
+        } else {
+            des_sp_encrypt_rounds_x4(l, r, ks->ks);
+        }
+        for (int b = 0; b < DES_INTERLEAVE; b++) {
+            des_final_permutation(l[b], r[b], output + (i + b) * DES_BLOCK_SIZE);
+        }
+    }
+
+    // 剩余不足一组的分组逐个处理
+    for (; i < nblocks; i++) {
+        if (decrypt) {
+            des_decrypt_block_ks(input + i * DES_BLOCK_SIZE, ks, output + i * DES_BLOCK_SIZE);
+        } else {
+            des_encrypt_block_ks(input + i * DES_BLOCK_SIZE, ks, output + i * DES_BLOCK_SIZE);
+        }
+    }
+}
+
+void des_ecb_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks, const des_key_schedule *ks) {
+    des_ecb_crypt(input, output, nblocks, ks, 0);
+}
+
+void des_ecb_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks, const des_key_schedule *ks) {
+    des_ecb_crypt(input, output, nblocks, ks, 1);
+}
+
+int des3_make_key_schedule(const unsigned char *key, size_t key_len, des3_key_schedule *ks) {
+    des_key_schedule k1, k2, k3;
+
+    if (key_len != DES3_KEY_SIZE && key_len != DES3_EDE2_KEY_SIZE) {
+        return 1;
+    }
+
+    // EDE2 复用 K1 作为 K3
+    const unsigned char *key3 = (key_len == DES3_KEY_SIZE) ? key + 2 * DES_KEY_SIZE : key;
+    if (des_make_key_schedule(key, &k1) != 0 ||
+        des_make_key_schedule(key + DES_KEY_SIZE, &k2) != 0 ||
+        des_make_key_schedule(key3, &k3) != 0) {
+        return 1;
+    }
+
+    // 按执行顺序连续存放 48 轮子密钥，中间一段为 K2 的解密顺序
+    uint32_t *out = ks->ks;
+    for (int i = 0; i < DES_ROUNDS; i++) {
+        out[2 * i] = k1.ks[2 * i];
+        out[2 * i + 1] = k1.ks[2 * i + 1];
+    }
+    out += 2 * DES_ROUNDS;
+    for (int i = 0; i < DES_ROUNDS; i++) {
+        out[2 * i] = k2.ks[2 * (DES_ROUNDS - 1 - i)];
+        out[2 * i + 1] = k2.ks[2 * (DES_ROUNDS - 1 - i) + 1];
+    }
+    out += 2 * DES_ROUNDS;
+    for (int i = 0; i < DES_ROUNDS; i++) {
+        out[2 * i] = k3.ks[2 * i];
+        out[2 * i + 1] = k3.ks[2 * i + 1];
+    }
+
+    return 0;
+}
+
+// 48 轮迭代：相邻两次 DES 之间的 IP^-1 与 IP 相互抵消，只剩左右交换
+static inline void des3_encrypt_rounds(uint32_t *left, uint32_t *right, const uint32_t ks[96]) {
+    des_sp_encrypt_rounds(left, right, ks);
+    des_sp_encrypt_rounds(right, left, ks + 2 * DES_ROUNDS);
+    des_sp_encrypt_rounds(left, right, ks + 4 * DES_ROUNDS);
+}
+
+// 解密即把整个 48 轮子密钥序列倒序执行
+static inline void des3_decrypt_rounds(uint32_t *left, uint32_t *right, const uint32_t ks[96]) {
+    des_sp_decrypt_rounds(left, right, ks + 4 * DES_ROUNDS);
+    des_sp_decrypt_rounds(right, left, ks + 2 * DES_ROUNDS);
+    des_sp_decrypt_rounds(left, right, ks);
+}
+
+void des3_encrypt_block(const unsigned char *input, const des3_key_schedule *ks, unsigned char *output) {
     uint32_t left, right;
-    SPLIT_BLOCK(permuted, left, right);
+    des_initial_permutation(input, &left, &right);
+    des3_encrypt_rounds(&left, &right, ks->ks);
+    des_final_permutation(left, right, output);
+}
 
-    // 16 轮迭代（子密钥顺序相反）
-    for (int i = 15; i >= 0; i--) {
-        uint32_t temp = right;
-        uint64_t subKey = bytes_to_uint48(subKeys[i]);
-        uint32_t feistel_result = feistel(right, subKey);
-        right = left ^ feistel_result;
-        left = temp;
+void des3_decrypt_block(const unsigned char *input, const des3_key_schedule *ks, unsigned char *output) {
+    uint32_t left, right;
+    des_initial_permutation(input, &left, &right);
+    des3_decrypt_rounds(&left, &right, ks->ks);
+    des_final_permutation(left, right, output);
+}
+
+void des3_ecb_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks, const des3_key_schedule *ks) {
+    for (size_t i = 0; i < nblocks; i++) {
+        des3_encrypt_block(input + i * DES_BLOCK_SIZE, ks, output + i * DES_BLOCK_SIZE);
     }
+}
 
-    // 合并并交换左右部分
-    uint64_t preoutput = COMBINE_BLOCK(right, left);
+void des3_ecb_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks, const des3_key_schedule *ks) {
+    for (size_t i = 0; i < nblocks; i++) {
+        des3_decrypt_block(input + i * DES_BLOCK_SIZE, ks, output + i * DES_BLOCK_SIZE);
+    }
+}
 
-    // 逆初始置换
-    uint64_t final_output = permute(preoutput, 64, IP_INV, 64);
+void des3_cbc_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                      const des3_key_schedule *ks, unsigned char iv[DES_BLOCK_SIZE]) {
+    unsigned char block[DES_BLOCK_SIZE];
+    const unsigned char *prev = iv;
 
-    // 把输出的结果转换为字节
-    for (int i = 0; i < 8; i++) {
-        output[i] = (final_output >> (56 - 8 * i)) & 0xFF;
+    for (size_t i = 0; i < nblocks; i++) {
+        for (int j = 0; j < DES_BLOCK_SIZE; j++) {
+            block[j] = input[i * DES_BLOCK_SIZE + j] ^ prev[j];
+        }
+        des3_encrypt_block(block, ks, output + i * DES_BLOCK_SIZE);
+        prev = output + i * DES_BLOCK_SIZE;
     }
-}
\ No newline at end of file
+
+    if (nblocks > 0) {
+        memcpy(iv, prev, DES_BLOCK_SIZE);
+    }
+}
+
+void des3_cbc_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                      const des3_key_schedule *ks, unsigned char iv[DES_BLOCK_SIZE]) {
+    unsigned char prev[DES_BLOCK_SIZE], next[DES_BLOCK_SIZE], block[DES_BLOCK_SIZE];
+
+    // 先保存密文再写输出，允许 input 与 output 指向同一缓冲区
+    memcpy(prev, iv, DES_BLOCK_SIZE);
+    for (size_t i = 0; i < nblocks; i++) {
+        memcpy(next, input + i * DES_BLOCK_SIZE, DES_BLOCK_SIZE);
+        des3_decrypt_block(next, ks, block);
+        for (int j = 0; j < DES_BLOCK_SIZE; j++) {
+            output[i * DES_BLOCK_SIZE + j] = block[j] ^ prev[j];
+        }
+        memcpy(prev, next, DES_BLOCK_SIZE);
+    }
+    memcpy(iv, prev, DES_BLOCK_SIZE);
+}
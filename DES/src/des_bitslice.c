@@ -0,0 +1,707 @@
+#include "../inc/des.h"
+#include <string.h>
+
+/*
+ * 位切片（bitslice）DES：把 64 * DES_BS_LANES 个分组按位转置，
+ * 第 i 个切片字保存所有分组的第 i 位，S 盒用布尔电路计算，整个过程没有查表。
+ */
+
+// 切片字：每个 64 位通道对应 64 个分组，SSE2/AVX2 下一次处理 128/256 个分组
+#if defined(__AVX2__)
+#define DES_BS_LANES 4
+#elif defined(__SSE2__)
+#define DES_BS_LANES 2
+#else
+#define DES_BS_LANES 1
+#endif
+
+typedef uint64_t bs_word __attribute__((vector_size(8 * DES_BS_LANES)));
+
+#define DES_BS_BLOCKS (64 * DES_BS_LANES)
+
+// S 盒输出位 o 经 P 置换后所在的位置
+static const int DES_BS_P_INV[32] = {
+     8, 16, 22, 30, 12, 27,  1, 17,
+    23, 15, 29,  5, 25, 19,  9,  0,
+     7, 13, 24,  2,  3, 28, 10, 18,
+    31, 11, 21,  6,  4, 26, 14, 20
+};
+
+/*
+ * S 盒布尔电路：由 S_BOXES 按二元决策图分解得到（每个 S 盒选取门数最少的变量顺序）。
+ * a1..a6 为标准顺序的 6 位输入（a1、a6 选行），o1..o4 为 4 位输出（o1 为高位），结果异或到输出上。
+ */
+static inline void des_bs_s1(bs_word a1, bs_word a2, bs_word a3, bs_word a4, bs_word a5, bs_word a6,
+                              bs_word *o1, bs_word *o2, bs_word *o3, bs_word *o4) {
+    bs_word x1 = ~a5;
+    bs_word x2 = a3 ^ x1;
+    bs_word x3 = x2 ^ (a2 & (x2 ^ a5));
+    bs_word x4 = a3 & x1;
+    bs_word x5 = a2 ^ x4;
+    bs_word x6 = x3 ^ (a1 & (x3 ^ x5));
+    bs_word x7 = ~x3;
+    bs_word x8 = ~x4;
+    bs_word x9 = ~x2;
+    bs_word x10 = x8 ^ (a2 & (x8 ^ x9));
+    bs_word x11 = x7 ^ (a1 & (x7 ^ x10));
+    bs_word x12 = x6 ^ (a6 & (x6 ^ x11));
+    bs_word x13 = a3 | x1;
+    bs_word x14 = a2 ^ x13;
+    bs_word x15 = ~a3 & x1;
+    bs_word x16 = x8 ^ (a2 & (x8 ^ x15));
+    bs_word x17 = x14 ^ (a1 & (x14 ^ x16));
+    bs_word x18 = x15 ^ (a2 & (x15 ^ a5));
+    bs_word x19 = x5 ^ (a1 & (x5 ^ x18));
+    bs_word x20 = x17 ^ (a6 & (x17 ^ x19));
+    bs_word x21 = x12 ^ (a4 & (x12 ^ x20));
+    bs_word x22 = ~x5;
+    bs_word x23 = ~a3;
+    bs_word x24 = x13 ^ (a2 & (x13 ^ x23));
+    bs_word x25 = x22 ^ (a1 & (x22 ^ x24));
+    bs_word x26 = x9 ^ (a2 & (x9 ^ a5));
+    bs_word x27 = ~a3 | x1;
+    bs_word x28 = x27 ^ (a2 & (x27 ^ x15));
+    bs_word x29 = x26 ^ (a1 & (x26 ^ x28));
+    bs_word x30 = x25 ^ (a6 & (x25 ^ x29));
+    bs_word x31 = x15 ^ (a2 & (x15 ^ x8));
+    bs_word x32 = x15 ^ (a2 & (x15 ^ x9));
+    bs_word x33 = x31 ^ (a1 & (x31 ^ x32));
+    bs_word x34 = a1 ^ x28;
+    bs_word x35 = x33 ^ (a6 & (x33 ^ x34));
+    bs_word x36 = x30 ^ (a4 & (x30 ^ x35));
+    bs_word x37 = ~x27;
+    bs_word x38 = x37 ^ (a2 & (x37 ^ x13));
+    bs_word x39 = x24 ^ (a1 & (x24 ^ x38));
+    bs_word x40 = ~x15;
+    bs_word x41 = x40 ^ (a2 & (x40 ^ x23));
+    bs_word x42 = x41 ^ (a1 & (x41 ^ x32));
+    bs_word x43 = x39 ^ (a6 & (x39 ^ x42));
+    bs_word x44 = ~x10;
+    bs_word x45 = x44 ^ (a1 & (x44 ^ x14));
+    bs_word x46 = a5 ^ (a2 & (a5 ^ x27));
+    bs_word x47 = x32 ^ (a1 & (x32 ^ x46));
+    bs_word x48 = x45 ^ (a6 & (x45 ^ x47));
+    bs_word x49 = x43 ^ (a4 & (x43 ^ x48));
+    bs_word x50 = x38 ^ (a1 & (x38 ^ x7));
+    bs_word x51 = ~x24;
+    bs_word x52 = x2 ^ (a2 & (x2 ^ x23));
+    bs_word x53 = x51 ^ (a1 & (x51 ^ x52));
+    bs_word x54 = x50 ^ (a6 & (x50 ^ x53));
+    bs_word x55 = a2 ^ x27;
+    bs_word x56 = a1 ^ x55;
+    bs_word x57 = x13 ^ (a2 & (x13 ^ x9));
+    bs_word x58 = a3 ^ (a2 & (a3 ^ x2));
+    bs_word x59 = x57 ^ (a1 & (x57 ^ x58));
+    bs_word x60 = x56 ^ (a6 & (x56 ^ x59));
+    bs_word x61 = x54 ^ (a4 & (x54 ^ x60));
+    *o1 ^= x21;
+    *o2 ^= x36;
+    *o3 ^= x49;
+    *o4 ^= x61;
+}
+
+static inline void des_bs_s2(bs_word a1, bs_word a2, bs_word a3, bs_word a4, bs_word a5, bs_word a6,
+                              bs_word *o1, bs_word *o2, bs_word *o3, bs_word *o4) {
+    bs_word x1 = ~a6;
+    bs_word x2 = a3 ^ x1;
+    bs_word x3 = a1 ^ x2;
+    bs_word x4 = ~x2;
+    bs_word x5 = a4 ^ x4;
+    bs_word x6 = ~a3 | a6;
+    bs_word x7 = ~a3 & x1;
+    bs_word x8 = x6 ^ (a4 & (x6 ^ x7));
+    bs_word x9 = x5 ^ (a1 & (x5 ^ x8));
+    bs_word x10 = x3 ^ (a5 & (x3 ^ x9));
+    bs_word x11 = ~a3 | x1;
+    bs_word x12 = a4 ^ x11;
+    bs_word x13 = x12 ^ (a1 & (x12 ^ x5));
+    bs_word x14 = ~x12;
+    bs_word x15 = a4 ^ x7;
+    bs_word x16 = x14 ^ (a1 & (x14 ^ x15));
+    bs_word x17 = x13 ^ (a5 & (x13 ^ x16));
+    bs_word x18 = x10 ^ (a2 & (x10 ^ x17));
+    bs_word x19 = a3 | x1;
+    bs_word x20 = a4 ^ x19;
+    bs_word x21 = a1 ^ x20;
+    bs_word x22 = ~x19;
+    bs_word x23 = a4 | x22;
+    bs_word x24 = a1 ^ x23;
+    bs_word x25 = x21 ^ (a5 & (x21 ^ x24));
+    bs_word x26 = ~x7;
+    bs_word x27 = ~x6;
+    bs_word x28 = x26 ^ (a4 & (x26 ^ x27));
+    bs_word x29 = a1 ^ x28;
+    bs_word x30 = x7 ^ (a4 & (x7 ^ x2));
+    bs_word x31 = a6 ^ (a4 & (a6 ^ x11));
+    bs_word x32 = x30 ^ (a1 & (x30 ^ x31));
+    bs_word x33 = x29 ^ (a5 & (x29 ^ x32));
+    bs_word x34 = x25 ^ (a2 & (x25 ^ x33));
+    bs_word x35 = ~a4 | x27;
+    bs_word x36 = a4 ^ a3;
+    bs_word x37 = x35 ^ (a1 & (x35 ^ x36));
+    bs_word x38 = a3 ^ (a4 & (a3 ^ x6));
+    bs_word x39 = x38 ^ (a1 & (x38 ^ x2));
+    bs_word x40 = x37 ^ (a5 & (x37 ^ x39));
+    bs_word x41 = ~x11;
+    bs_word x42 = x41 ^ (a4 & (x41 ^ x2));
+    bs_word x43 = x22 ^ (a4 & (x22 ^ x26));
+    bs_word x44 = x42 ^ (a1 & (x42 ^ x43));
+    bs_word x45 = x7 ^ (a4 & (x7 ^ x4));
+    bs_word x46 = x4 ^ (a4 & (x4 ^ x1));
+    bs_word x47 = x45 ^ (a1 & (x45 ^ x46));
+    bs_word x48 = x44 ^ (a5 & (x44 ^ x47));
+    bs_word x49 = x40 ^ (a2 & (x40 ^ x48));
+    bs_word x50 = a4 ^ x6;
+    bs_word x51 = a4 ^ a6;
+    bs_word x52 = x50 ^ (a1 & (x50 ^ x51));
+    bs_word x53 = x11 ^ (a4 & (x11 ^ x22));
+    bs_word x54 = x53 ^ (a1 & (x53 ^ x14));
+    bs_word x55 = x52 ^ (a5 & (x52 ^ x54));
+    bs_word x56 = x15 ^ (a1 & (x15 ^ x53));
+    bs_word x57 = x2 ^ (a1 & (x2 ^ a3));
+    bs_word x58 = x56 ^ (a5 & (x56 ^ x57));
+    bs_word x59 = x55 ^ (a2 & (x55 ^ x58));
+    *o1 ^= x18;
+    *o2 ^= x34;
+    *o3 ^= x49;
+    *o4 ^= x59;
+}
+
+static inline void des_bs_s3(bs_word a1, bs_word a2, bs_word a3, bs_word a4, bs_word a5, bs_word a6,
+                              bs_word *o1, bs_word *o2, bs_word *o3, bs_word *o4) {
+    bs_word x1 = ~a3;
+    bs_word x2 = ~a6;
+    bs_word x3 = x1 ^ (a4 & (x1 ^ x2));
+    bs_word x4 = ~a3 | a6;
+    bs_word x5 = a4 & x4;
+    bs_word x6 = x3 ^ (a5 & (x3 ^ x5));
+    bs_word x7 = a3 ^ x2;
+    bs_word x8 = a3 ^ (a4 & (a3 ^ x7));
+    bs_word x9 = ~x7;
+    bs_word x10 = x4 ^ (a4 & (x4 ^ x9));
+    bs_word x11 = x8 ^ (a5 & (x8 ^ x10));
+    bs_word x12 = x6 ^ (a2 & (x6 ^ x11));
+    bs_word x13 = a4 ^ x2;
+    bs_word x14 = a3 | a6;
+    bs_word x15 = a4 ^ x14;
+    bs_word x16 = x13 ^ (a5 & (x13 ^ x15));
+    bs_word x17 = a4 ^ x7;
+    bs_word x18 = a5 ^ x17;
+    bs_word x19 = x16 ^ (a2 & (x16 ^ x18));
+    bs_word x20 = x12 ^ (a1 & (x12 ^ x19));
+    bs_word x21 = x9 ^ (a4 & (x9 ^ a3));
+    bs_word x22 = ~x13;
+    bs_word x23 = x21 ^ (a5 & (x21 ^ x22));
+    bs_word x24 = a3 & a6;
+    bs_word x25 = x24 ^ (a4 & (x24 ^ x4));
+    bs_word x26 = x2 ^ (a4 & (x2 ^ x1));
+    bs_word x27 = x25 ^ (a5 & (x25 ^ x26));
+    bs_word x28 = x23 ^ (a2 & (x23 ^ x27));
+    bs_word x29 = ~x21;
+    bs_word x30 = x2 ^ (a4 & (x2 ^ x24));
+    bs_word x31 = x29 ^ (a5 & (x29 ^ x30));
+    bs_word x32 = a3 | x2;
+    bs_word x33 = a6 ^ (a4 & (a6 ^ x32));
+    bs_word x34 = x9 ^ (a5 & (x9 ^ x33));
+    bs_word x35 = x31 ^ (a2 & (x31 ^ x34));
+    bs_word x36 = x28 ^ (a1 & (x28 ^ x35));
+    bs_word x37 = x32 ^ (a4 & (x32 ^ a3));
+    bs_word x38 = ~x17;
+    bs_word x39 = x37 ^ (a5 & (x37 ^ x38));
+    bs_word x40 = x24 ^ (a4 & (x24 ^ x1));
+    bs_word x41 = x21 ^ (a5 & (x21 ^ x40));
+    bs_word x42 = x39 ^ (a2 & (x39 ^ x41));
+    bs_word x43 = ~x4;
+    bs_word x44 = x24 ^ (a4 & (x24 ^ x43));
+    bs_word x45 = ~x24;
+    bs_word x46 = a4 ^ x45;
+    bs_word x47 = x44 ^ (a5 & (x44 ^ x46));
+    bs_word x48 = a4 | x7;
+    bs_word x49 = x48 ^ (a5 & (x48 ^ x9));
+    bs_word x50 = x47 ^ (a2 & (x47 ^ x49));
+    bs_word x51 = x42 ^ (a1 & (x42 ^ x50));
+    bs_word x52 = x22 ^ (a5 & (x22 ^ x9));
+    bs_word x53 = a2 ^ x52;
+    bs_word x54 = ~x8;
+    bs_word x55 = a5 ^ x54;
+    bs_word x56 = ~a4 & x32;
+    bs_word x57 = x56 ^ (a5 & (x56 ^ x10));
+    bs_word x58 = x55 ^ (a2 & (x55 ^ x57));
+    bs_word x59 = x53 ^ (a1 & (x53 ^ x58));
+    *o1 ^= x20;
+    *o2 ^= x36;
+    *o3 ^= x51;
+    *o4 ^= x59;
+}
+
+static inline void des_bs_s4(bs_word a1, bs_word a2, bs_word a3, bs_word a4, bs_word a5, bs_word a6,
+                              bs_word *o1, bs_word *o2, bs_word *o3, bs_word *o4) {
+    bs_word x1 = ~a3;
+    bs_word x2 = ~a1 | x1;
+    bs_word x3 = a1 ^ (a4 & (a1 ^ x2));
+    bs_word x4 = a1 ^ x1;
+    bs_word x5 = x4 ^ (a4 & (x4 ^ a3));
+    bs_word x6 = x3 ^ (a5 & (x3 ^ x5));
+    bs_word x7 = ~x4;
+    bs_word x8 = a4 ^ x7;
+    bs_word x9 = ~a1 & a3;
+    bs_word x10 = x9 ^ (a4 & (x9 ^ x7));
+    bs_word x11 = x8 ^ (a5 & (x8 ^ x10));
+    bs_word x12 = x6 ^ (a2 & (x6 ^ x11));
+    bs_word x13 = a4 ^ x2;
+    bs_word x14 = x4 ^ (a5 & (x4 ^ x13));
+    bs_word x15 = a1 ^ (a4 & (a1 ^ x9));
+    bs_word x16 = a4 | x9;
+    bs_word x17 = x15 ^ (a5 & (x15 ^ x16));
+    bs_word x18 = x14 ^ (a2 & (x14 ^ x17));
+    bs_word x19 = x12 ^ (a6 & (x12 ^ x18));
+    bs_word x20 = ~x12;
+    bs_word x21 = x18 ^ (a6 & (x18 ^ x20));
+    bs_word x22 = x1 ^ (a4 & (x1 ^ x4));
+    bs_word x23 = a1 | a3;
+    bs_word x24 = ~a1;
+    bs_word x25 = x23 ^ (a4 & (x23 ^ x24));
+    bs_word x26 = x22 ^ (a5 & (x22 ^ x25));
+    bs_word x27 = a1 & x1;
+    bs_word x28 = x7 ^ (a4 & (x7 ^ x27));
+    bs_word x29 = ~x8;
+    bs_word x30 = x28 ^ (a5 & (x28 ^ x29));
+    bs_word x31 = x26 ^ (a2 & (x26 ^ x30));
+    bs_word x32 = a4 ^ x23;
+    bs_word x33 = x32 ^ (a5 & (x32 ^ x7));
+    bs_word x34 = ~x27;
+    bs_word x35 = a4 & x34;
+    bs_word x36 = x34 ^ (a4 & (x34 ^ a1));
+    bs_word x37 = x35 ^ (a5 & (x35 ^ x36));
+    bs_word x38 = x33 ^ (a2 & (x33 ^ x37));
+    bs_word x39 = x31 ^ (a6 & (x31 ^ x38));
+    bs_word x40 = ~x38;
+    bs_word x41 = x40 ^ (a6 & (x40 ^ x31));
+    *o1 ^= x19;
+    *o2 ^= x21;
+    *o3 ^= x39;
+    *o4 ^= x41;
+}
+
+static inline void des_bs_s5(bs_word a1, bs_word a2, bs_word a3, bs_word a4, bs_word a5, bs_word a6,
+                              bs_word *o1, bs_word *o2, bs_word *o3, bs_word *o4) {
+    bs_word x1 = ~a1;
+    bs_word x2 = a5 & x1;
+    bs_word x3 = a2 ^ x2;
+    bs_word x4 = a5 | a1;
+    bs_word x5 = a2 ^ x4;
+    bs_word x6 = x3 ^ (a3 & (x3 ^ x5));
+    bs_word x7 = a5 & a1;
+    bs_word x8 = ~a2 | x7;
+    bs_word x9 = a5 ^ a1;
+    bs_word x10 = x7 ^ (a2 & (x7 ^ x9));
+    bs_word x11 = x8 ^ (a3 & (x8 ^ x10));
+    bs_word x12 = x6 ^ (a6 & (x6 ^ x11));
+    bs_word x13 = ~x9;
+    bs_word x14 = a5 | x1;
+    bs_word x15 = x13 ^ (a2 & (x13 ^ x14));
+    bs_word x16 = x10 ^ (a3 & (x10 ^ x15));
+    bs_word x17 = x9 ^ (a2 & (x9 ^ x14));
+    bs_word x18 = ~x4;
+    bs_word x19 = x13 ^ (a2 & (x13 ^ x18));
+    bs_word x20 = x17 ^ (a3 & (x17 ^ x19));
+    bs_word x21 = x16 ^ (a6 & (x16 ^ x20));
+    bs_word x22 = x12 ^ (a4 & (x12 ^ x21));
+    bs_word x23 = ~a5;
+    bs_word x24 = x13 ^ (a2 & (x13 ^ x23));
+    bs_word x25 = x9 ^ (a3 & (x9 ^ x24));
+    bs_word x26 = ~x2;
+    bs_word x27 = x18 ^ (a2 & (x18 ^ x26));
+    bs_word x28 = x14 ^ (a2 & (x14 ^ x7));
+    bs_word x29 = x27 ^ (a3 & (x27 ^ x28));
+    bs_word x30 = x25 ^ (a6 & (x25 ^ x29));
+    bs_word x31 = ~x5;
+    bs_word x32 = a2 ^ x9;
+    bs_word x33 = x31 ^ (a3 & (x31 ^ x32));
+    bs_word x34 = a6 ^ x33;
+    bs_word x35 = x30 ^ (a4 & (x30 ^ x34));
+    bs_word x36 = ~x17;
+    bs_word x37 = ~x7;
+    bs_word x38 = x37 ^ (a2 & (x37 ^ a1));
+    bs_word x39 = x36 ^ (a3 & (x36 ^ x38));
+    bs_word x40 = a2 ^ a5;
+    bs_word x41 = x38 ^ (a3 & (x38 ^ x40));
+    bs_word x42 = x39 ^ (a6 & (x39 ^ x41));
+    bs_word x43 = ~x38;
+    bs_word x44 = ~x10;
+    bs_word x45 = x43 ^ (a3 & (x43 ^ x44));
+    bs_word x46 = x13 ^ (a2 & (x13 ^ x1));
+    bs_word x47 = ~x14;
+    bs_word x48 = x47 ^ (a2 & (x47 ^ a5));
+    bs_word x49 = x46 ^ (a3 & (x46 ^ x48));
+    bs_word x50 = x45 ^ (a6 & (x45 ^ x49));
+    bs_word x51 = x42 ^ (a4 & (x42 ^ x50));
+    bs_word x52 = a2 & x4;
+    bs_word x53 = x52 ^ (a3 & (x52 ^ x13));
+    bs_word x54 = x9 ^ (a2 & (x9 ^ x1));
+    bs_word x55 = x32 ^ (a3 & (x32 ^ x54));
+    bs_word x56 = x53 ^ (a6 & (x53 ^ x55));
+    bs_word x57 = x4 ^ (a2 & (x4 ^ x14));
+    bs_word x58 = x23 ^ (a2 & (x23 ^ x2));
+    bs_word x59 = x57 ^ (a3 & (x57 ^ x58));
+    bs_word x60 = x7 ^ (a2 & (x7 ^ x13));
+    bs_word x61 = x14 ^ (a2 & (x14 ^ a1));
+    bs_word x62 = x60 ^ (a3 & (x60 ^ x61));
+    bs_word x63 = x59 ^ (a6 & (x59 ^ x62));
+    bs_word x64 = x56 ^ (a4 & (x56 ^ x63));
+    *o1 ^= x22;
+    *o2 ^= x35;
+    *o3 ^= x51;
+    *o4 ^= x64;
+}
+
+static inline void des_bs_s6(bs_word a1, bs_word a2, bs_word a3, bs_word a4, bs_word a5, bs_word a6,
+                              bs_word *o1, bs_word *o2, bs_word *o3, bs_word *o4) {
+    bs_word x1 = ~a2;
+    bs_word x2 = a6 ^ x1;
+    bs_word x3 = x1 ^ (a1 & (x1 ^ x2));
+    bs_word x4 = ~a6 & x1;
+    bs_word x5 = x2 ^ (a1 & (x2 ^ x4));
+    bs_word x6 = x3 ^ (a4 & (x3 ^ x5));
+    bs_word x7 = ~x2;
+    bs_word x8 = a1 ^ x7;
+    bs_word x9 = a4 ^ x8;
+    bs_word x10 = x6 ^ (a5 & (x6 ^ x9));
+    bs_word x11 = ~a6;
+    bs_word x12 = a6 & x1;
+    bs_word x13 = x11 ^ (a1 & (x11 ^ x12));
+    bs_word x14 = a1 | x12;
+    bs_word x15 = x13 ^ (a4 & (x13 ^ x14));
+    bs_word x16 = a1 ^ a6;
+    bs_word x17 = ~x12;
+    bs_word x18 = x17 ^ (a1 & (x17 ^ a6));
+    bs_word x19 = x16 ^ (a4 & (x16 ^ x18));
+    bs_word x20 = x15 ^ (a5 & (x15 ^ x19));
+    bs_word x21 = x10 ^ (a3 & (x10 ^ x20));
+    bs_word x22 = ~x8;
+    bs_word x23 = x22 ^ (a4 & (x22 ^ x16));
+    bs_word x24 = a6 | x1;
+    bs_word x25 = x17 ^ (a1 & (x17 ^ x24));
+    bs_word x26 = x8 ^ (a4 & (x8 ^ x25));
+    bs_word x27 = x23 ^ (a5 & (x23 ^ x26));
+    bs_word x28 = a6 & a2;
+    bs_word x29 = x7 ^ (a1 & (x7 ^ x28));
+    bs_word x30 = x11 ^ (a1 & (x11 ^ x1));
+    bs_word x31 = x29 ^ (a4 & (x29 ^ x30));
+    bs_word x32 = x12 ^ (a1 & (x12 ^ a2));
+    bs_word x33 = x7 ^ (a4 & (x7 ^ x32));
+    bs_word x34 = x31 ^ (a5 & (x31 ^ x33));
+    bs_word x35 = x27 ^ (a3 & (x27 ^ x34));
+    bs_word x36 = ~x30;
+    bs_word x37 = a4 ^ x36;
+    bs_word x38 = x12 ^ (a1 & (x12 ^ x24));
+    bs_word x39 = x24 ^ (a1 & (x24 ^ a2));
+    bs_word x40 = x38 ^ (a4 & (x38 ^ x39));
+    bs_word x41 = x37 ^ (a5 & (x37 ^ x40));
+    bs_word x42 = ~x14;
+    bs_word x43 = ~x24;
+    bs_word x44 = ~x28;
+    bs_word x45 = x43 ^ (a1 & (x43 ^ x44));
+    bs_word x46 = x42 ^ (a4 & (x42 ^ x45));
+    bs_word x47 = x9 ^ (a5 & (x9 ^ x46));
+    bs_word x48 = x41 ^ (a3 & (x41 ^ x47));
+    bs_word x49 = a1 & x17;
+    bs_word x50 = a2 ^ (a1 & (a2 ^ x2));
+    bs_word x51 = x49 ^ (a4 & (x49 ^ x50));
+    bs_word x52 = ~x49;
+    bs_word x53 = x4 ^ (a1 & (x4 ^ x2));
+    bs_word x54 = x52 ^ (a4 & (x52 ^ x53));
+    bs_word x55 = x51 ^ (a5 & (x51 ^ x54));
+    bs_word x56 = ~x50;
+    bs_word x57 = ~x53;
+    bs_word x58 = x56 ^ (a4 & (x56 ^ x57));
+    bs_word x59 = ~x3;
+    bs_word x60 = x59 ^ (a4 & (x59 ^ x8));
+    bs_word x61 = x58 ^ (a5 & (x58 ^ x60));
+    bs_word x62 = x55 ^ (a3 & (x55 ^ x61));
+    *o1 ^= x21;
+    *o2 ^= x35;
+    *o3 ^= x48;
+    *o4 ^= x62;
+}
+
+static inline void des_bs_s7(bs_word a1, bs_word a2, bs_word a3, bs_word a4, bs_word a5, bs_word a6,
+                              bs_word *o1, bs_word *o2, bs_word *o3, bs_word *o4) {
+    bs_word x1 = a4 & a2;
+    bs_word x2 = a5 ^ x1;
+    bs_word x3 = ~a2;
+    bs_word x4 = a4 ^ a2;
+    bs_word x5 = x3 ^ (a5 & (x3 ^ x4));
+    bs_word x6 = x2 ^ (a3 & (x2 ^ x5));
+    bs_word x7 = a4 | a2;
+    bs_word x8 = x4 ^ (a5 & (x4 ^ x7));
+    bs_word x9 = ~x4;
+    bs_word x10 = a4 & x3;
+    bs_word x11 = x9 ^ (a5 & (x9 ^ x10));
+    bs_word x12 = x8 ^ (a3 & (x8 ^ x11));
+    bs_word x13 = x6 ^ (a1 & (x6 ^ x12));
+    bs_word x14 = ~x2;
+    bs_word x15 = a3 ^ x14;
+    bs_word x16 = a4 | x3;
+    bs_word x17 = x4 ^ (a5 & (x4 ^ x16));
+    bs_word x18 = x4 ^ (a5 & (x4 ^ x1));
+    bs_word x19 = x17 ^ (a3 & (x17 ^ x18));
+    bs_word x20 = x15 ^ (a1 & (x15 ^ x19));
+    bs_word x21 = x13 ^ (a6 & (x13 ^ x20));
+    bs_word x22 = ~x7;
+    bs_word x23 = a5 ^ x22;
+    bs_word x24 = ~x10;
+    bs_word x25 = a5 ^ x24;
+    bs_word x26 = x23 ^ (a3 & (x23 ^ x25));
+    bs_word x27 = x26 ^ (a1 & (x26 ^ x6));
+    bs_word x28 = x24 ^ (a5 & (x24 ^ a4));
+    bs_word x29 = x22 ^ (a5 & (x22 ^ a2));
+    bs_word x30 = x28 ^ (a3 & (x28 ^ x29));
+    bs_word x31 = a5 ^ x3;
+    bs_word x32 = ~x16;
+    bs_word x33 = a5 ^ x32;
+    bs_word x34 = x31 ^ (a3 & (x31 ^ x33));
+    bs_word x35 = x30 ^ (a1 & (x30 ^ x34));
+    bs_word x36 = x27 ^ (a6 & (x27 ^ x35));
+    bs_word x37 = a3 ^ x17;
+    bs_word x38 = x7 ^ (a5 & (x7 ^ x32));
+    bs_word x39 = x10 ^ (a5 & (x10 ^ x16));
+    bs_word x40 = x38 ^ (a3 & (x38 ^ x39));
+    bs_word x41 = x37 ^ (a1 & (x37 ^ x40));
+    bs_word x42 = x32 ^ (a5 & (x32 ^ x7));
+    bs_word x43 = x4 ^ (a3 & (x4 ^ x42));
+    bs_word x44 = x22 ^ (a5 & (x22 ^ x9));
+    bs_word x45 = a3 ^ x44;
+    bs_word x46 = x43 ^ (a1 & (x43 ^ x45));
+    bs_word x47 = x41 ^ (a6 & (x41 ^ x46));
+    bs_word x48 = ~x5;
+    bs_word x49 = ~a4;
+    bs_word x50 = a5 ^ x49;
+    bs_word x51 = x48 ^ (a3 & (x48 ^ x50));
+    bs_word x52 = a1 ^ x51;
+    bs_word x53 = x16 ^ (a5 & (x16 ^ x4));
+    bs_word x54 = ~x28;
+    bs_word x55 = x53 ^ (a3 & (x53 ^ x54));
+    bs_word x56 = ~x11;
+    bs_word x57 = a3 ^ x56;
+    bs_word x58 = x55 ^ (a1 & (x55 ^ x57));
+    bs_word x59 = x52 ^ (a6 & (x52 ^ x58));
+    *o1 ^= x21;
+    *o2 ^= x36;
+    *o3 ^= x47;
+    *o4 ^= x59;
+}
+
+static inline void des_bs_s8(bs_word a1, bs_word a2, bs_word a3, bs_word a4, bs_word a5, bs_word a6,
+                              bs_word *o1, bs_word *o2, bs_word *o3, bs_word *o4) {
+    bs_word x1 = ~a2;
+    bs_word x2 = ~a4 | x1;
+    bs_word x3 = x2 ^ (a3 & (x2 ^ a4));
+    bs_word x4 = ~x2;
+    bs_word x5 = a3 ^ x4;
+    bs_word x6 = x3 ^ (a1 & (x3 ^ x5));
+    bs_word x7 = ~a4 & x1;
+    bs_word x8 = a2 ^ (a3 & (a2 ^ x7));
+    bs_word x9 = a4 ^ x1;
+    bs_word x10 = x8 ^ (a1 & (x8 ^ x9));
+    bs_word x11 = x6 ^ (a5 & (x6 ^ x10));
+    bs_word x12 = ~x9;
+    bs_word x13 = a3 ^ x12;
+    bs_word x14 = ~x7;
+    bs_word x15 = a4 & x1;
+    bs_word x16 = x14 ^ (a3 & (x14 ^ x15));
+    bs_word x17 = x13 ^ (a1 & (x13 ^ x16));
+    bs_word x18 = a4 | x1;
+    bs_word x19 = a3 ^ x18;
+    bs_word x20 = a1 ^ x19;
+    bs_word x21 = x17 ^ (a5 & (x17 ^ x20));
+    bs_word x22 = x11 ^ (a6 & (x11 ^ x21));
+    bs_word x23 = ~x16;
+    bs_word x24 = ~x8;
+    bs_word x25 = x23 ^ (a1 & (x23 ^ x24));
+    bs_word x26 = a4 ^ (a3 & (a4 ^ x9));
+    bs_word x27 = x26 ^ (a1 & (x26 ^ x8));
+    bs_word x28 = x25 ^ (a5 & (x25 ^ x27));
+    bs_word x29 = x16 ^ (a1 & (x16 ^ x13));
+    bs_word x30 = ~x26;
+    bs_word x31 = x30 ^ (a1 & (x30 ^ x12));
+    bs_word x32 = x29 ^ (a5 & (x29 ^ x31));
+    bs_word x33 = x28 ^ (a6 & (x28 ^ x32));
+    bs_word x34 = a3 ^ a2;
+    bs_word x35 = ~x13;
+    bs_word x36 = x34 ^ (a1 & (x34 ^ x35));
+    bs_word x37 = x9 ^ (a1 & (x9 ^ x30));
+    bs_word x38 = x36 ^ (a5 & (x36 ^ x37));
+    bs_word x39 = x4 ^ (a3 & (x4 ^ x1));
+    bs_word x40 = a1 ^ x39;
+    bs_word x41 = ~x15;
+    bs_word x42 = x9 ^ (a3 & (x9 ^ x41));
+    bs_word x43 = x15 ^ (a3 & (x15 ^ x9));
+    bs_word x44 = x42 ^ (a1 & (x42 ^ x43));
+    bs_word x45 = x40 ^ (a5 & (x40 ^ x44));
+    bs_word x46 = x38 ^ (a6 & (x38 ^ x45));
+    bs_word x47 = ~x21;
+    bs_word x48 = x1 ^ (a3 & (x1 ^ a4));
+    bs_word x49 = ~x18;
+    bs_word x50 = a2 ^ (a3 & (a2 ^ x49));
+    bs_word x51 = x48 ^ (a1 & (x48 ^ x50));
+    bs_word x52 = x41 ^ (a3 & (x41 ^ x7));
+    bs_word x53 = x52 ^ (a1 & (x52 ^ x24));
+    bs_word x54 = x51 ^ (a5 & (x51 ^ x53));
+    bs_word x55 = x47 ^ (a6 & (x47 ^ x54));
+    *o1 ^= x22;
+    *o2 ^= x33;
+    *o3 ^= x46;
+    *o4 ^= x55;
+}
+#define DES_BS_SBOX(n, i)                                                       \
+    des_bs_s##n(x[6 * (i)], x[6 * (i) + 1], x[6 * (i) + 2],                     \
+                x[6 * (i) + 3], x[6 * (i) + 4], x[6 * (i) + 5],                 \
+                &l[DES_BS_P_INV[4 * (i)]], &l[DES_BS_P_INV[4 * (i) + 1]],       \
+                &l[DES_BS_P_INV[4 * (i) + 2]], &l[DES_BS_P_INV[4 * (i) + 3]])
+
+// 一轮 Feistel：l ^= P(S(E(r) ^ k))
+static inline void des_bs_round(bs_word *l, const bs_word *r, const uint64_t k[48]) {
+    bs_word x[48];
+    for (int i = 0; i < 48; i++) {
+        x[i] = r[E[i] - 1] ^ k[i];
+    }
+
+    DES_BS_SBOX(1, 0);
+    DES_BS_SBOX(2, 1);
+    DES_BS_SBOX(3, 2);
+    DES_BS_SBOX(4, 3);
+    DES_BS_SBOX(5, 4);
+    DES_BS_SBOX(6, 5);
+    DES_BS_SBOX(7, 6);
+    DES_BS_SBOX(8, 7);
+}
+
+// 从 des_key_schedule 还原每轮 48 位子密钥，展开为全 0 / 全 1 的掩码
+static void des_bs_expand_key(const des_key_schedule *ks, uint64_t k[16][48]) {
+    for (int i = 0; i < DES_ROUNDS; i++) {
+        uint32_t even = ks->ks[2 * i];
+        uint32_t odd = (ks->ks[2 * i + 1] >> 4) | (ks->ks[2 * i + 1] << 28);
+
+        // 第 g 组 6 位逆序存放在对应字的 [8 * (g / 2) + 2, 8 * (g / 2) + 8) 处
+        for (int e = 0; e < 48; e++) {
+            int g = e / 6;
+            uint32_t word = (g & 1) ? odd : even;
+            uint32_t bit = (word >> (8 * (g >> 1) + 2 + e % 6)) & 1;
+            k[i][e] = 0 - (uint64_t)bit;
+        }
+    }
+}
+
+// 64x64 位矩阵转置：a[r] 的第 c 位（自高位起）与 a[c] 的第 r 位交换
+static void des_bs_transpose64(uint64_t a[64]) {
+    uint64_t m = 0x00000000FFFFFFFFULL;
+    for (int j = 32; j != 0; j >>= 1, m ^= m << j) {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            uint64_t t = ((a[k | j] >> j) ^ a[k]) & m;
+            a[k] ^= t;
+            a[k | j] ^= t << j;
+        }
+    }
+}
+
+// 分组（大端）转置为切片，s[i] 为标准编号第 i + 1 位
+static void des_bs_load(const unsigned char *input, size_t nblocks, bs_word s[64]) {
+    uint64_t t[64];
+
+    for (int q = 0; q < DES_BS_LANES; q++) {
+        for (int j = 0; j < 64; j++) {
+            size_t n = (size_t)q * 64 + j;
+            uint64_t v = 0;
+            if (n < nblocks) {
+                for (int b = 0; b < 8; b++) {
+                    v = (v << 8) | input[n * DES_BLOCK_SIZE + b];
+                }
+            }
+            t[j] = v;
+        }
+
+        des_bs_transpose64(t);
+
+        for (int i = 0; i < 64; i++) {
+            s[i][q] = t[i];
+        }
+    }
+}
+
+static void des_bs_store(const bs_word s[64], size_t nblocks, unsigned char *output) {
+    uint64_t t[64];
+
+    for (int q = 0; q < DES_BS_LANES; q++) {
+        for (int i = 0; i < 64; i++) {
+            t[i] = s[i][q];
+        }
+
+        des_bs_transpose64(t);
+
+        for (int j = 0; j < 64; j++) {
+            size_t n = (size_t)q * 64 + j;
+            if (n >= nblocks) {
+                return;
+            }
+            for (int b = 0; b < 8; b++) {
+                output[n * DES_BLOCK_SIZE + b] = (t[j] >> (56 - 8 * b)) & 0xFF;
+            }
+        }
+    }
+}
+
+// 加/解密一批（不超过 DES_BS_BLOCKS 个）分组
+static void des_bs_crypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                         const uint64_t k[16][48], int decrypt) {
+    bs_word s[64], lr[64];
+
+    des_bs_load(input, nblocks, s);
+
+    // 初始置换只是切片的重新编号
+    for (int i = 0; i < 64; i++) {
+        lr[i] = s[IP[i] - 1];
+    }
+
+    bs_word *l = lr, *r = lr + 32;
+    for (int i = 0; i < DES_ROUNDS; i++) {
+        des_bs_round(l, r, k[decrypt ? DES_ROUNDS - 1 - i : i]);
+        bs_word *t = l;
+        l = r;
+        r = t;
+    }
+
+    // 交换左右部分并逆初始置换
+    bs_word pre[64];
+    for (int i = 0; i < 32; i++) {
+        pre[i] = r[i];
+        pre[32 + i] = l[i];
+    }
+    for (int i = 0; i < 64; i++) {
+        s[i] = pre[IP_INV[i] - 1];
+    }
+
+    des_bs_store(s, nblocks, output);
+}
+
+static void des_bs_crypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                                const des_key_schedule *ks, int decrypt) {
+    uint64_t k[16][48];
+    des_bs_expand_key(ks, k);
+
+    while (nblocks > 0) {
+        size_t n = nblocks < DES_BS_BLOCKS ? nblocks : DES_BS_BLOCKS;
+        des_bs_crypt(input, output, n, k, decrypt);
+        input += n * DES_BLOCK_SIZE;
+        output += n * DES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+}
+
+void des_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks, const des_key_schedule *ks) {
+    des_bs_crypt_blocks(input, output, nblocks, ks, 0);
+}
+
+void des_decrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks, const des_key_schedule *ks) {
+    des_bs_crypt_blocks(input, output, nblocks, ks, 1);
+}
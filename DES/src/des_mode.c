@@ -0,0 +1,279 @@
+#include "../inc/des_mode.h"
+#include <string.h>
+
+// 批处理的分组数：CTR 计数器块与 CBC 解密的中间结果先攒满一批，再交给交错执行的 ECB
+#define DES_MODE_BATCH 32
+
+static inline void xor_block(unsigned char *out, const unsigned char *a, const unsigned char *b, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+// 64 位大端计数器加一
+static inline void counter_increment(unsigned char counter[DES_BLOCK_SIZE]) {
+    for (int i = DES_BLOCK_SIZE - 1; i >= 0; i--) {
+        if (++counter[i] != 0) {
+            break;
+        }
+    }
+}
+
+void des_cbc_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                     const des_key_schedule *ks, unsigned char iv[DES_BLOCK_SIZE]) {
+    unsigned char block[DES_BLOCK_SIZE];
+
+    // CBC 加密前后分组相互依赖，只能串行
+    for (size_t i = 0; i < nblocks; i++) {
+        xor_block(block, input + i * DES_BLOCK_SIZE, iv, DES_BLOCK_SIZE);
+        des_encrypt_block_ks(block, ks, output + i * DES_BLOCK_SIZE);
+        memcpy(iv, output + i * DES_BLOCK_SIZE, DES_BLOCK_SIZE);
+    }
+}
+
+void des_cbc_decrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                     const des_key_schedule *ks, unsigned char iv[DES_BLOCK_SIZE]) {
+    unsigned char plain[DES_MODE_BATCH * DES_BLOCK_SIZE];
+    unsigned char last[DES_BLOCK_SIZE];
+
+    while (nblocks > 0) {
+        size_t n = nblocks < DES_MODE_BATCH ? nblocks : DES_MODE_BATCH;
+
+        // 密文全部已知，整批解密后再异或链接
+        des_ecb_decrypt(input, plain, n, ks);
+
+        // 倒序异或，原地解密时前一块密文尚未被覆盖
+        memcpy(last, input + (n - 1) * DES_BLOCK_SIZE, DES_BLOCK_SIZE);
+        for (size_t i = n - 1; i > 0; i--) {
+            xor_block(output + i * DES_BLOCK_SIZE, plain + i * DES_BLOCK_SIZE,
+                      input + (i - 1) * DES_BLOCK_SIZE, DES_BLOCK_SIZE);
+        }
+        xor_block(output, plain, iv, DES_BLOCK_SIZE);
+        memcpy(iv, last, DES_BLOCK_SIZE);
+
+        input += n * DES_BLOCK_SIZE;
+        output += n * DES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+}
+
+void des_ctr_crypt(const unsigned char *input, unsigned char *output, size_t len,
+                   const des_key_schedule *ks, unsigned char counter[DES_BLOCK_SIZE]) {
+    unsigned char stream[DES_MODE_BATCH * DES_BLOCK_SIZE];
+
+    while (len > 0) {
+        size_t bytes = len < sizeof(stream) ? len : sizeof(stream);
+        size_t n = (bytes + DES_BLOCK_SIZE - 1) / DES_BLOCK_SIZE;
+
+        // 先生成一批计数器块，再整批加密得到密钥流
+        for (size_t i = 0; i < n; i++) {
+            memcpy(stream + i * DES_BLOCK_SIZE, counter, DES_BLOCK_SIZE);
+            counter_increment(counter);
+        }
+        des_ecb_encrypt(stream, stream, n, ks);
+
+        xor_block(output, input, stream, bytes);
+
+        input += bytes;
+        output += bytes;
+        len -= bytes;
+    }
+}
+
+int des_mode_init(des_mode_ctx *ctx, des_mode mode, int decrypt,
+                  const unsigned char key[DES_KEY_SIZE], const unsigned char iv[DES_BLOCK_SIZE]) {
+    if (mode < DES_MODE_ECB || mode > DES_MODE_CTR) {
+        return 1;
+    }
+
+    if (des_make_key_schedule(key, &ctx->ks) != 0) {
+        return 1;
+    }
+
+    ctx->mode = mode;
+    ctx->decrypt = decrypt ? 1 : 0;
+    ctx->num = 0;
+    if (mode == DES_MODE_ECB) {
+        memset(ctx->iv, 0, DES_BLOCK_SIZE);
+    } else {
+        memcpy(ctx->iv, iv, DES_BLOCK_SIZE);
+    }
+
+    return 0;
+}
+
+// ECB/CBC 处理整块
+static void des_mode_blocks(des_mode_ctx *ctx, const unsigned char *input, unsigned char *output, size_t nblocks) {
+    if (ctx->mode == DES_MODE_ECB) {
+        if (ctx->decrypt) {
+            des_ecb_decrypt(input, output, nblocks, &ctx->ks);
+        } else {
+            des_ecb_encrypt(input, output, nblocks, &ctx->ks);
+        }
+    } else {
+        if (ctx->decrypt) {
+            des_cbc_decrypt(input, output, nblocks, &ctx->ks, ctx->iv);
+        } else {
+            des_cbc_encrypt(input, output, nblocks, &ctx->ks, ctx->iv);
+        }
+    }
+}
+
+// ECB/CBC：不足一块的输入缓存在 buf 中；解密时保留最后一整块，留待 final 去除填充
+static size_t des_mode_update_block(des_mode_ctx *ctx, const unsigned char *input, size_t input_len,
+                                    unsigned char *output) {
+    size_t total = ctx->num + input_len;
+    size_t nblocks = ctx->decrypt ? (total > 0 ? (total - 1) / DES_BLOCK_SIZE : 0) : total / DES_BLOCK_SIZE;
+    size_t written = 0;
+
+    if (nblocks > 0 && ctx->num > 0) {
+        size_t fill = DES_BLOCK_SIZE - ctx->num;
+        memcpy(ctx->buf + ctx->num, input, fill);
+        input += fill;
+        input_len -= fill;
+        ctx->num = 0;
+
+        des_mode_blocks(ctx, ctx->buf, output, 1);
+        written += DES_BLOCK_SIZE;
+        nblocks--;
+    }
+
+    if (nblocks > 0) {
+        des_mode_blocks(ctx, input, output + written, nblocks);
+        input += nblocks * DES_BLOCK_SIZE;
+        input_len -= nblocks * DES_BLOCK_SIZE;
+        written += nblocks * DES_BLOCK_SIZE;
+    }
+
+    memcpy(ctx->buf + ctx->num, input, input_len);
+    ctx->num += input_len;
+
+    return written;
+}
+
+// CFB-64：iv 中保存 E(反馈寄存器)，已用过的字节被替换为密文，用满一块即成为下一个反馈值
+static void des_mode_update_cfb(des_mode_ctx *ctx, const unsigned char *input, size_t input_len,
+                                unsigned char *output) {
+    size_t n = ctx->num;
+
+    for (size_t i = 0; i < input_len; i++) {
+        if (n == 0) {
+            des_encrypt_block_ks(ctx->iv, &ctx->ks, ctx->iv);
+        }
+        unsigned char c = input[i];
+        if (ctx->decrypt) {
+            output[i] = ctx->iv[n] ^ c;
+            ctx->iv[n] = c;
+        } else {
+            ctx->iv[n] ^= c;
+            output[i] = ctx->iv[n];
+        }
+        n = (n + 1) % DES_BLOCK_SIZE;
+    }
+
+    ctx->num = n;
+}
+
+// OFB：iv 即为当前密钥流分组
+static void des_mode_update_ofb(des_mode_ctx *ctx, const unsigned char *input, size_t input_len,
+                                unsigned char *output) {
+    size_t n = ctx->num;
+
+    for (size_t i = 0; i < input_len; i++) {
+        if (n == 0) {
+            des_encrypt_block_ks(ctx->iv, &ctx->ks, ctx->iv);
+        }
+        output[i] = input[i] ^ ctx->iv[n];
+        n = (n + 1) % DES_BLOCK_SIZE;
+    }
+
+    ctx->num = n;
+}
+
+// CTR：先用完 buf 中剩余的密钥流，整块部分批量处理，尾部再生成一块密钥流
+static void des_mode_update_ctr(des_mode_ctx *ctx, const unsigned char *input, size_t input_len,
+                                unsigned char *output) {
+    while (ctx->num != 0 && input_len > 0) {
+        *output++ = *input++ ^ ctx->buf[ctx->num];
+        ctx->num = (ctx->num + 1) % DES_BLOCK_SIZE;
+        input_len--;
+    }
+
+    size_t bulk = input_len - input_len % DES_BLOCK_SIZE;
+    des_ctr_crypt(input, output, bulk, &ctx->ks, ctx->iv);
+    input += bulk;
+    output += bulk;
+    input_len -= bulk;
+
+    if (input_len > 0) {
+        des_encrypt_block_ks(ctx->iv, &ctx->ks, ctx->buf);
+        counter_increment(ctx->iv);
+        xor_block(output, input, ctx->buf, input_len);
+        ctx->num = input_len;
+    }
+}
+
+int des_mode_update(des_mode_ctx *ctx, const unsigned char *input, size_t input_len,
+                    unsigned char *output, size_t *output_len) {
+    switch (ctx->mode) {
+    case DES_MODE_ECB:
+    case DES_MODE_CBC:
+        *output_len = des_mode_update_block(ctx, input, input_len, output);
+        return 0;
+    case DES_MODE_CFB:
+        des_mode_update_cfb(ctx, input, input_len, output);
+        break;
+    case DES_MODE_OFB:
+        des_mode_update_ofb(ctx, input, input_len, output);
+        break;
+    case DES_MODE_CTR:
+        des_mode_update_ctr(ctx, input, input_len, output);
+        break;
+    default:
+        return 1;
+    }
+
+    *output_len = input_len;
+    return 0;
+}
+
+int des_mode_final(des_mode_ctx *ctx, unsigned char *output, size_t *output_len) {
+    *output_len = 0;
+
+    // 流模式没有填充
+    if (ctx->mode != DES_MODE_ECB && ctx->mode != DES_MODE_CBC) {
+        return 0;
+    }
+
+    if (!ctx->decrypt) {
+        // PKCS#7：填充 1~8 个值等于填充长度的字节，整块时补一整块
+        unsigned char pad = (unsigned char)(DES_BLOCK_SIZE - ctx->num);
+        memset(ctx->buf + ctx->num, pad, pad);
+        des_mode_blocks(ctx, ctx->buf, output, 1);
+        ctx->num = 0;
+        *output_len = DES_BLOCK_SIZE;
+        return 0;
+    }
+
+    if (ctx->num != DES_BLOCK_SIZE) {
+        return 1;
+    }
+
+    unsigned char block[DES_BLOCK_SIZE];
+    des_mode_blocks(ctx, ctx->buf, block, 1);
+    ctx->num = 0;
+
+    unsigned char pad = block[DES_BLOCK_SIZE - 1];
+    if (pad == 0 || pad > DES_BLOCK_SIZE) {
+        return 1;
+    }
+    for (int i = DES_BLOCK_SIZE - pad; i < DES_BLOCK_SIZE; i++) {
+        if (block[i] != pad) {
+            return 1;
+        }
+    }
+
+    memcpy(output, block, DES_BLOCK_SIZE - pad);
+    *output_len = DES_BLOCK_SIZE - pad;
+    return 0;
+}
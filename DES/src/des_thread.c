@@ -0,0 +1,356 @@
+#include "../inc/des_thread.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 分片内每批交给位切片引擎的分组数，与其最宽的 256 路并行对齐
+#define DES_THREAD_BATCH 256
+
+// 一次批量调用被拆成 nchunks 个分片，工作线程与调用线程从 next_chunk 依次领取
+typedef void (*des_chunk_fn)(void *arg, size_t chunk);
+
+struct des_thread_pool {
+    pthread_t *threads;
+    int nworkers;                 /* 不含调用线程 */
+    size_t chunk_blocks;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+
+    des_chunk_fn fn;
+    void *arg;
+    size_t nchunks;
+    size_t next_chunk;
+    size_t done_chunks;
+    int shutdown;
+};
+
+// 领取并执行分片直到没有剩余，调用时须持有锁
+static void des_pool_drain(des_thread_pool *pool) {
+    while (pool->next_chunk < pool->nchunks) {
+        size_t chunk = pool->next_chunk++;
+        des_chunk_fn fn = pool->fn;
+        void *arg = pool->arg;
+
+        pthread_mutex_unlock(&pool->lock);
+        fn(arg, chunk);
+        pthread_mutex_lock(&pool->lock);
+
+        if (++pool->done_chunks == pool->nchunks) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+}
+
+static void *des_pool_worker(void *p) {
+    des_thread_pool *pool = (des_thread_pool *)p;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->next_chunk >= pool->nchunks) {
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        des_pool_drain(pool);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+// 分发一次任务并等待全部分片完成，调用线程同样参与计算
+static void des_pool_run(des_thread_pool *pool, des_chunk_fn fn, void *arg, size_t nchunks) {
+    if (nchunks == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->arg = arg;
+    pool->nchunks = nchunks;
+    pool->next_chunk = 0;
+    pool->done_chunks = 0;
+    if (pool->nworkers > 0 && nchunks > 1) {
+        pthread_cond_broadcast(&pool->work_cond);
+    }
+
+    des_pool_drain(pool);
+    while (pool->done_chunks < pool->nchunks) {
+        pthread_cond_wait(&pool->done_cond, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+des_thread_pool *des_thread_pool_create(int nthreads, size_t chunk_blocks) {
+    if (nthreads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cpus > 0 ? (int)cpus : 1;
+    }
+
+    des_thread_pool *pool = calloc(1, sizeof(*pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    pool->chunk_blocks = chunk_blocks ? chunk_blocks : DES_THREAD_DEFAULT_CHUNK;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    if (nthreads > 1) {
+        pool->threads = calloc((size_t)nthreads - 1, sizeof(pthread_t));
+        if (pool->threads == NULL) {
+            des_thread_pool_destroy(pool);
+            return NULL;
+        }
+        for (int i = 0; i < nthreads - 1; i++) {
+            if (pthread_create(&pool->threads[i], NULL, des_pool_worker, pool) != 0) {
+                des_thread_pool_destroy(pool);
+                return NULL;
+            }
+            pool->nworkers++;
+        }
+    }
+
+    return pool;
+}
+
+void des_thread_pool_destroy(des_thread_pool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->nworkers; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
+
+// 各模式的分片任务参数
+typedef struct {
+    const unsigned char *input;
+    unsigned char *output;
+    size_t nblocks;               /* ECB/CBC 为分组数，CTR 为字节数对应的分组数 */
+    size_t len;                   /* CTR 字节数 */
+    size_t chunk_blocks;
+    const des_key_schedule *ks;
+    const unsigned char *counter; /* CTR 起始计数器 */
+    const unsigned char *ivs;     /* CBC 每个分片的 IV */
+    int decrypt;
+} des_mt_job;
+
+static size_t des_chunk_count(size_t nblocks, size_t chunk_blocks) {
+    return (nblocks + chunk_blocks - 1) / chunk_blocks;
+}
+
+static void des_ecb_chunk(void *arg, size_t chunk) {
+    const des_mt_job *job = (const des_mt_job *)arg;
+    size_t first = chunk * job->chunk_blocks;
+    size_t n = job->nblocks - first < job->chunk_blocks ? job->nblocks - first : job->chunk_blocks;
+    const unsigned char *in = job->input + first * DES_BLOCK_SIZE;
+    unsigned char *out = job->output + first * DES_BLOCK_SIZE;
+
+    if (job->decrypt) {
+        des_decrypt_blocks(in, out, n, job->ks);
+    } else {
+        des_encrypt_blocks(in, out, n, job->ks);
+    }
+}
+
+static void des_ecb_crypt_mt(des_thread_pool *pool, const unsigned char *input, unsigned char *output,
+                             size_t nblocks, const des_key_schedule *ks, int decrypt) {
+    des_mt_job job = { input, output, nblocks, 0, pool->chunk_blocks, ks, NULL, NULL, decrypt };
+    des_pool_run(pool, des_ecb_chunk, &job, des_chunk_count(nblocks, pool->chunk_blocks));
+}
+
+void des_ecb_encrypt_mt(des_thread_pool *pool, const unsigned char *input, unsigned char *output,
+                        size_t nblocks, const des_key_schedule *ks) {
+    des_ecb_crypt_mt(pool, input, output, nblocks, ks, 0);
+}
+
+void des_ecb_decrypt_mt(des_thread_pool *pool, const unsigned char *input, unsigned char *output,
+                        size_t nblocks, const des_key_schedule *ks) {
+    des_ecb_crypt_mt(pool, input, output, nblocks, ks, 1);
+}
+
+// 64 位大端计数器加上 n
+static void counter_add(unsigned char counter[DES_BLOCK_SIZE], uint64_t n) {
+    uint64_t c = 0;
+    for (int i = 0; i < DES_BLOCK_SIZE; i++) {
+        c = (c << 8) | counter[i];
+    }
+    c += n;
+    for (int i = DES_BLOCK_SIZE - 1; i >= 0; i--) {
+        counter[i] = c & 0xFF;
+        c >>= 8;
+    }
+}
+
+static void des_ctr_chunk(void *arg, size_t chunk) {
+    const des_mt_job *job = (const des_mt_job *)arg;
+    size_t first = chunk * job->chunk_blocks * DES_BLOCK_SIZE;
+    size_t bytes = job->chunk_blocks * DES_BLOCK_SIZE;
+    unsigned char counter[DES_BLOCK_SIZE];
+    unsigned char stream[DES_THREAD_BATCH * DES_BLOCK_SIZE];
+
+    if (bytes > job->len - first) {
+        bytes = job->len - first;
+    }
+
+    // 每个分片从自己的计数器位置开始，互不依赖
+    memcpy(counter, job->counter, DES_BLOCK_SIZE);
+    counter_add(counter, (uint64_t)chunk * job->chunk_blocks);
+
+    const unsigned char *in = job->input + first;
+    unsigned char *out = job->output + first;
+    while (bytes > 0) {
+        size_t len = bytes < sizeof(stream) ? bytes : sizeof(stream);
+        size_t n = (len + DES_BLOCK_SIZE - 1) / DES_BLOCK_SIZE;
+
+        for (size_t i = 0; i < n; i++) {
+            memcpy(stream + i * DES_BLOCK_SIZE, counter, DES_BLOCK_SIZE);
+            counter_add(counter, 1);
+        }
+        des_encrypt_blocks(stream, stream, n, job->ks);
+
+        for (size_t i = 0; i < len; i++) {
+            out[i] = in[i] ^ stream[i];
+        }
+
+        in += len;
+        out += len;
+        bytes -= len;
+    }
+}
+
+void des_ctr_crypt_mt(des_thread_pool *pool, const unsigned char *input, unsigned char *output,
+                      size_t len, const des_key_schedule *ks, unsigned char counter[DES_BLOCK_SIZE]) {
+    size_t nblocks = (len + DES_BLOCK_SIZE - 1) / DES_BLOCK_SIZE;
+    des_mt_job job = { input, output, nblocks, len, pool->chunk_blocks, ks, counter, NULL, 0 };
+
+    des_pool_run(pool, des_ctr_chunk, &job, des_chunk_count(nblocks, pool->chunk_blocks));
+    counter_add(counter, nblocks);
+}
+
+static void des_cbc_chunk(void *arg, size_t chunk) {
+    const des_mt_job *job = (const des_mt_job *)arg;
+    size_t first = chunk * job->chunk_blocks;
+    size_t nblocks = job->nblocks - first < job->chunk_blocks ? job->nblocks - first : job->chunk_blocks;
+    const unsigned char *in = job->input + first * DES_BLOCK_SIZE;
+    unsigned char *out = job->output + first * DES_BLOCK_SIZE;
+    const unsigned char *prev = job->ivs + chunk * DES_BLOCK_SIZE;
+    unsigned char plain[DES_THREAD_BATCH * DES_BLOCK_SIZE];
+    unsigned char last[DES_BLOCK_SIZE];
+    unsigned char iv[DES_BLOCK_SIZE];
+
+    memcpy(iv, prev, DES_BLOCK_SIZE);
+    while (nblocks > 0) {
+        size_t n = nblocks < DES_THREAD_BATCH ? nblocks : DES_THREAD_BATCH;
+
+        des_decrypt_blocks(in, plain, n, job->ks);
+
+        // 倒序异或，原地解密时前一块密文尚未被覆盖
+        memcpy(last, in + (n - 1) * DES_BLOCK_SIZE, DES_BLOCK_SIZE);
+        for (size_t i = n * DES_BLOCK_SIZE; i-- > DES_BLOCK_SIZE;) {
+            out[i] = plain[i] ^ in[i - DES_BLOCK_SIZE];
+        }
+        for (size_t i = 0; i < DES_BLOCK_SIZE; i++) {
+            out[i] = plain[i] ^ iv[i];
+        }
+        memcpy(iv, last, DES_BLOCK_SIZE);
+
+        in += n * DES_BLOCK_SIZE;
+        out += n * DES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+}
+
+int des_cbc_decrypt_mt(des_thread_pool *pool, const unsigned char *input, unsigned char *output,
+                       size_t nblocks, const des_key_schedule *ks, unsigned char iv[DES_BLOCK_SIZE]) {
+    if (nblocks == 0) {
+        return 0;
+    }
+
+    // 分片的 IV 是前一分片的最后一块密文，原地解密时会被覆盖，需事先取出
+    size_t nchunks = des_chunk_count(nblocks, pool->chunk_blocks);
+    unsigned char *ivs = malloc(nchunks * DES_BLOCK_SIZE);
+    if (ivs == NULL) {
+        return 1;
+    }
+
+    memcpy(ivs, iv, DES_BLOCK_SIZE);
+    for (size_t c = 1; c < nchunks; c++) {
+        memcpy(ivs + c * DES_BLOCK_SIZE, input + (c * pool->chunk_blocks - 1) * DES_BLOCK_SIZE, DES_BLOCK_SIZE);
+    }
+    memcpy(iv, input + (nblocks - 1) * DES_BLOCK_SIZE, DES_BLOCK_SIZE);
+
+    des_mt_job job = { input, output, nblocks, 0, pool->chunk_blocks, ks, NULL, ivs, 1 };
+    des_pool_run(pool, des_cbc_chunk, &job, nchunks);
+
+    free(ivs);
+    return 0;
+}
+
+// 密钥搜索的分片任务参数
+typedef struct {
+    const unsigned char *plaintext;
+    const unsigned char *ciphertext;
+    const des_key_deltas *deltas;
+    uint64_t first;
+    uint64_t count;
+    uint64_t chunk_keys;
+    int found;                    /* 任一分片命中后置 1，其余分片跳过 */
+    uint64_t key;
+} des_search_job;
+
+static void des_search_chunk(void *arg, size_t chunk) {
+    des_search_job *job = (des_search_job *)arg;
+    uint64_t offset = (uint64_t)chunk * job->chunk_keys;
+    uint64_t count = job->count - offset < job->chunk_keys ? job->count - offset : job->chunk_keys;
+    uint64_t key;
+
+    if (__atomic_load_n(&job->found, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    if (des_key_search(job->plaintext, job->ciphertext, job->deltas, job->first + offset, count, &key) == 0) {
+        __atomic_store_n(&job->key, key, __ATOMIC_RELAXED);
+        __atomic_store_n(&job->found, 1, __ATOMIC_RELEASE);
+    }
+}
+
+int des_key_search_mt(des_thread_pool *pool, const unsigned char plaintext[DES_BLOCK_SIZE],
+                      const unsigned char ciphertext[DES_BLOCK_SIZE], const des_key_deltas *deltas,
+                      uint64_t first, uint64_t count, uint64_t *found) {
+    const uint64_t limit = (uint64_t)1 << DES_KEY_BITS;
+
+    if (first >= limit || count == 0) {
+        return 1;
+    }
+    if (count > limit - first) {
+        count = limit - first;
+    }
+
+    des_search_job job = { plaintext, ciphertext, deltas, first, count, pool->chunk_blocks, 0, 0 };
+    des_pool_run(pool, des_search_chunk, &job, (size_t)((count + job.chunk_keys - 1) / job.chunk_keys));
+
+    if (!job.found) {
+        return 1;
+    }
+    *found = job.key;
+    return 0;
+}
@@ -1,9 +1,17 @@
 #include "../inc/des.h"
+#include "../inc/des_mode.h"
+#include "../inc/des_thread.h"
 #include "../inc/benchmark.h"
 
 #define BENCHS 10
 #define ROUNDS 10000
 // #define ROUNDS 1
+#define BULK_BLOCKS 1024
+#define BULK_ROUNDS 100
+#define MT_BLOCKS 16384
+#define MT_ROUNDS 10
+#define SEARCH_KEYS (1 << 19) /* keys per timed call */
+#define SETUP_KEYS (1 << 17)
 
 // Print bytes in hexadecimal format
 void print_bytes(const unsigned char *data, size_t size)
@@ -50,9 +58,12 @@ void test_des_correctness()
 
     // Decrypt
     des_decrypt_block(ciphertext, subKeys, decrypted);
+    printf("Decrypted plaintext: ");
+    print_bytes(decrypted, DES_BLOCK_SIZE);
 
-    // Verify encryption result
-    if (memcmp(ciphertext, correctResult, DES_BLOCK_SIZE) == 0)
+    // Verify encryption and decryption result
+    if (memcmp(ciphertext, correctResult, DES_BLOCK_SIZE) == 0 &&
+        memcmp(decrypted, plaintext, DES_BLOCK_SIZE) == 0)
     {
         printf(">> Correctness test passed.\n\n");
     }
@@ -61,7 +72,467 @@ void test_des_correctness()
         printf(">> Correctness test failed.\n\n");
     }
 
+    // Same check through the prepared key schedule
+    des_key_schedule ks;
+    if (des_make_key_schedule(key, &ks) != 0)
+    {
+        printf("Failed to generate key schedule.\n");
+        return;
+    }
+
+    des_encrypt_block_ks(plaintext, &ks, ciphertext);
+    des_decrypt_block_ks(ciphertext, &ks, decrypted);
+    printf("Encrypted ciphertext (key schedule): ");
+    print_bytes(ciphertext, DES_BLOCK_SIZE);
+
+    if (memcmp(ciphertext, correctResult, DES_BLOCK_SIZE) == 0 &&
+        memcmp(decrypted, plaintext, DES_BLOCK_SIZE) == 0)
+    {
+        printf(">> Key schedule correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Key schedule correctness test failed.\n\n");
+    }
+
+}
+
+// Fill buffer with a fixed pseudo-random pattern
+void fill_bytes(unsigned char *data, size_t size, unsigned int seed)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (seed >> 16) & 0xFF;
+    }
+}
+
+// Bitsliced multi-block engine must match the single-block engine
+void test_des_blocks_correctness()
+{
+    unsigned char key[DES_KEY_SIZE] = { 0x4b,0x41,0x53,0x48,0x49,0x53,0x41,0x42 };
+    // Odd block counts exercise the partial last batch
+    size_t counts[] = { 1, 63, 64, 65, 257, BULK_BLOCKS };
+    static unsigned char plaintext[BULK_BLOCKS * DES_BLOCK_SIZE];
+    static unsigned char ciphertext[BULK_BLOCKS * DES_BLOCK_SIZE];
+    static unsigned char expected[BULK_BLOCKS * DES_BLOCK_SIZE];
+    static unsigned char decrypted[BULK_BLOCKS * DES_BLOCK_SIZE];
+    des_key_schedule ks;
+    int failed = 0;
+
+    if (des_make_key_schedule(key, &ks) != 0)
+    {
+        printf("Failed to generate key schedule.\n");
+        return;
+    }
+
+    fill_bytes(plaintext, sizeof(plaintext), 1);
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        size_t n = counts[c];
+
+        for (size_t i = 0; i < n; i++)
+        {
+            des_encrypt_block_ks(plaintext + i * DES_BLOCK_SIZE, &ks, expected + i * DES_BLOCK_SIZE);
+        }
+
+        des_encrypt_blocks(plaintext, ciphertext, n, &ks);
+        des_decrypt_blocks(ciphertext, decrypted, n, &ks);
+
+        if (memcmp(ciphertext, expected, n * DES_BLOCK_SIZE) != 0 ||
+            memcmp(decrypted, plaintext, n * DES_BLOCK_SIZE) != 0)
+        {
+            printf("Bitsliced engine mismatch for %zu blocks.\n", n);
+            failed = 1;
+        }
+    }
+
+    if (!failed)
+    {
+        printf(">> Bitsliced correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Bitsliced correctness test failed.\n\n");
+    }
+}
+
+// Thread pool entry points must match the single-threaded ones
+void test_des_thread_correctness()
+{
+    unsigned char key[DES_KEY_SIZE] = { 0x4b,0x41,0x53,0x48,0x49,0x53,0x41,0x42 };
+    const unsigned char iv0[DES_BLOCK_SIZE] = { 0x12,0x34,0x56,0x78,0x90,0xab,0xcd,0xef };
+    // A small chunk size splits every case into several chunks with a partial last one
+    size_t counts[] = { 1, 7, 8, 50, BULK_BLOCKS };
+    static unsigned char plaintext[BULK_BLOCKS * DES_BLOCK_SIZE];
+    static unsigned char expected[BULK_BLOCKS * DES_BLOCK_SIZE];
+    static unsigned char output[BULK_BLOCKS * DES_BLOCK_SIZE];
+    unsigned char iv[DES_BLOCK_SIZE], iv_mt[DES_BLOCK_SIZE];
+    des_key_schedule ks;
+    des_thread_pool *pool;
+    int failed = 0;
+
+    if (des_make_key_schedule(key, &ks) != 0)
+    {
+        printf("Failed to generate key schedule.\n");
+        return;
+    }
+
+    pool = des_thread_pool_create(4, 7);
+    if (pool == NULL)
+    {
+        printf("Failed to create thread pool.\n");
+        return;
+    }
+
+    fill_bytes(plaintext, sizeof(plaintext), 2);
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        size_t n = counts[c];
+        size_t len = n * DES_BLOCK_SIZE - (n > 1 ? 3 : 0);
+
+        des_ecb_encrypt(plaintext, expected, n, &ks);
+        des_ecb_encrypt_mt(pool, plaintext, output, n, &ks);
+        if (memcmp(output, expected, n * DES_BLOCK_SIZE) != 0)
+        {
+            printf("Multithreaded ECB encryption mismatch for %zu blocks.\n", n);
+            failed = 1;
+        }
+
+        // In place
+        des_ecb_decrypt_mt(pool, output, output, n, &ks);
+        if (memcmp(output, plaintext, n * DES_BLOCK_SIZE) != 0)
+        {
+            printf("Multithreaded ECB decryption mismatch for %zu blocks.\n", n);
+            failed = 1;
+        }
+
+        memcpy(iv, iv0, DES_BLOCK_SIZE);
+        memcpy(iv_mt, iv0, DES_BLOCK_SIZE);
+        des_ctr_crypt(plaintext, expected, len, &ks, iv);
+        des_ctr_crypt_mt(pool, plaintext, output, len, &ks, iv_mt);
+        if (memcmp(output, expected, len) != 0 || memcmp(iv, iv_mt, DES_BLOCK_SIZE) != 0)
+        {
+            printf("Multithreaded CTR mismatch for %zu bytes.\n", len);
+            failed = 1;
+        }
+
+        memcpy(iv, iv0, DES_BLOCK_SIZE);
+        des_cbc_encrypt(plaintext, expected, n, &ks, iv);
+        memcpy(output, expected, n * DES_BLOCK_SIZE);
+        memcpy(iv_mt, iv0, DES_BLOCK_SIZE);
+        // In place, every chunk IV must be taken before it is overwritten
+        if (des_cbc_decrypt_mt(pool, output, output, n, &ks, iv_mt) != 0 ||
+            memcmp(output, plaintext, n * DES_BLOCK_SIZE) != 0 ||
+            memcmp(iv, iv_mt, DES_BLOCK_SIZE) != 0)
+        {
+            printf("Multithreaded CBC decryption mismatch for %zu blocks.\n", n);
+            failed = 1;
+        }
+    }
+
+    des_thread_pool_destroy(pool);
+
+    if (!failed)
+    {
+        printf(">> Multithreaded correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Multithreaded correctness test failed.\n\n");
+    }
+}
+
+// Key search must find a planted key, single-threaded and with the thread pool
+void test_des_key_search_correctness()
+{
+    unsigned char plaintext[DES_BLOCK_SIZE] = { 0x4E,0x45,0x56,0x52,0x51,0x55,0x49,0x54 };
+    unsigned char ciphertext[DES_BLOCK_SIZE];
+    unsigned char key[DES_KEY_SIZE];
+    unsigned char expected[DES_BLOCK_SIZE];
+    // Gray-code position of the planted key, past several chunk boundaries
+    const uint64_t first = 0x123456789A0ULL, position = first + 5000;
+    static des_key_deltas deltas;
+    des_key_schedule ks, ks_inc;
+    des_thread_pool *pool;
+    uint64_t found = 0;
+    int failed = 0;
+
+    if (des_make_key_deltas(&deltas) != 0)
+    {
+        printf("Failed to generate key schedule differences.\n");
+        return;
+    }
+
+    // Walking the Gray code with des_key_schedule_flip must reproduce the full schedule
+    des_key_from_index(0, key);
+    des_make_key_schedule(key, &ks_inc);
+    for (uint64_t n = 1; n <= 300; n++)
+    {
+        des_key_schedule_flip(&ks_inc, &deltas, __builtin_ctzll(n));
+        des_key_from_index(n ^ (n >> 1), key);
+        des_make_key_schedule(key, &ks);
+        if (memcmp(&ks, &ks_inc, sizeof(ks)) != 0)
+        {
+            printf("Incremental key schedule mismatch at position %llu.\n", (unsigned long long)n);
+            failed = 1;
+            break;
+        }
+    }
+
+    des_key_from_index(position ^ (position >> 1), key);
+    des_make_key_schedule(key, &ks);
+    des_encrypt_block_ks(plaintext, &ks, ciphertext);
+
+    if (des_key_search(plaintext, ciphertext, &deltas, first, 10000, &found) != 0 ||
+        found != (position ^ (position >> 1)))
+    {
+        printf("Key search did not find the planted key.\n");
+        failed = 1;
+    }
+
+    if (des_key_search(plaintext, ciphertext, &deltas, first, 5000, &found) == 0)
+    {
+        printf("Key search reported a key outside the range.\n");
+        failed = 1;
+    }
+
+    pool = des_thread_pool_create(4, 700);
+    if (pool == NULL)
+    {
+        printf("Failed to create thread pool.\n");
+        return;
+    }
+
+    found = 0;
+    if (des_key_search_mt(pool, plaintext, ciphertext, &deltas, first, 10000, &found) != 0)
+    {
+        printf("Multithreaded key search did not find the planted key.\n");
+        failed = 1;
+    }
+    else
+    {
+        des_key_from_index(found, key);
+        des_make_key_schedule(key, &ks);
+        des_encrypt_block_ks(plaintext, &ks, expected);
+        if (memcmp(expected, ciphertext, DES_BLOCK_SIZE) != 0)
+        {
+            printf("Multithreaded key search returned a wrong key.\n");
+            failed = 1;
+        }
+    }
+
+    des_thread_pool_destroy(pool);
+
+    if (!failed)
+    {
+        printf(">> Key search correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Key search correctness test failed.\n\n");
+    }
+}
+
+// Print labelled bytes and compare them with the expected value
+int check_bytes(const char *label, const unsigned char *data, const unsigned char *expected, size_t size)
+{
+    printf("%s: ", label);
+    print_bytes(data, size);
+    return memcmp(data, expected, size) == 0;
+}
+
+// Triple-DES known-answer test (NIST SP 800-67 example, plus CBC / EDE2 variants)
+void test_des3_correctness()
+{
+    unsigned char key[DES3_KEY_SIZE] = {
+        0x01,0x23,0x45,0x67,0x89,0xab,0xcd,0xef,
+        0x23,0x45,0x67,0x89,0xab,0xcd,0xef,0x01,
+        0x45,0x67,0x89,0xab,0xcd,0xef,0x01,0x23
+    };
+    // "The qufck brown fox jump"
+    unsigned char plaintext[3 * DES_BLOCK_SIZE] = {
+        0x54,0x68,0x65,0x20,0x71,0x75,0x66,0x63,
+        0x6b,0x20,0x62,0x72,0x6f,0x77,0x6e,0x20,
+        0x66,0x6f,0x78,0x20,0x6a,0x75,0x6d,0x70
+    };
+    unsigned char ecbResult[3 * DES_BLOCK_SIZE] = {
+        0xa8,0x26,0xfd,0x8c,0xe5,0x3b,0x85,0x5f,
+        0xcc,0xe2,0x1c,0x81,0x12,0x25,0x6f,0xe6,
+        0x68,0xd5,0xc0,0x5d,0xd9,0xb6,0xb9,0x00
+    };
+    unsigned char iv[DES_BLOCK_SIZE] = { 0xf6,0x9f,0x24,0x45,0xdf,0x4f,0x9b,0x17 };
+    unsigned char cbcResult[3 * DES_BLOCK_SIZE] = {
+        0xa5,0xc2,0x82,0xba,0xd0,0xde,0x37,0x74,
+        0xbe,0xcd,0x2e,0x04,0x38,0x6b,0x58,0x9f,
+        0xb5,0x05,0x7d,0x85,0x52,0xfc,0x43,0x36
+    };
+    unsigned char ede2Result[3 * DES_BLOCK_SIZE] = {
+        0xc4,0x48,0x62,0xf7,0x0c,0xf2,0xfb,0xdc,
+        0x90,0x77,0xd0,0x90,0x9f,0xa9,0x1b,0x88,
+        0x4c,0xab,0xd6,0x1f,0xc5,0x8e,0x0c,0xbb
+    };
+    unsigned char ciphertext[3 * DES_BLOCK_SIZE];
+    unsigned char decrypted[3 * DES_BLOCK_SIZE];
+    unsigned char chain[DES_BLOCK_SIZE];
+    des3_key_schedule ks;
+    int passed = 1;
+
+    if (des3_make_key_schedule(key, DES3_KEY_SIZE, &ks) != 0)
+    {
+        printf("Failed to generate Triple-DES key schedule.\n");
+        return;
+    }
+
+    des3_ecb_encrypt(plaintext, ciphertext, 3, &ks);
+    des3_ecb_decrypt(ciphertext, decrypted, 3, &ks);
+    passed &= check_bytes("3DES-ECB ciphertext", ciphertext, ecbResult, sizeof(ciphertext));
+    passed &= memcmp(decrypted, plaintext, sizeof(plaintext)) == 0;
+
+    memcpy(chain, iv, DES_BLOCK_SIZE);
+    des3_cbc_encrypt(plaintext, ciphertext, 3, &ks, chain);
+    memcpy(chain, iv, DES_BLOCK_SIZE);
+    des3_cbc_decrypt(ciphertext, decrypted, 3, &ks, chain);
+    passed &= check_bytes("3DES-CBC ciphertext", ciphertext, cbcResult, sizeof(ciphertext));
+    passed &= memcmp(decrypted, plaintext, sizeof(plaintext)) == 0;
+
+    if (des3_make_key_schedule(key, DES3_EDE2_KEY_SIZE, &ks) != 0)
+    {
+        printf("Failed to generate Triple-DES key schedule.\n");
+        return;
+    }
+
+    des3_ecb_encrypt(plaintext, ciphertext, 3, &ks);
+    des3_ecb_decrypt(ciphertext, decrypted, 3, &ks);
+    passed &= check_bytes("3DES-EDE2 ciphertext", ciphertext, ede2Result, sizeof(ciphertext));
+    passed &= memcmp(decrypted, plaintext, sizeof(plaintext)) == 0;
+
+    if (passed)
+    {
+        printf(">> Triple-DES correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Triple-DES correctness test failed.\n\n");
+    }
+}
+
+// Run one mode through init/update/final, feeding the input in uneven pieces
+int run_des_mode(des_mode mode, int decrypt, const unsigned char *key, const unsigned char *iv,
+                 const unsigned char *input, size_t input_len, unsigned char *output, size_t *output_len)
+{
+    size_t pieces[] = { 1, 7, 13 };
+    size_t offset = 0, total = 0, written;
+    des_mode_ctx ctx;
+
+    if (des_mode_init(&ctx, mode, decrypt, key, iv) != 0)
+    {
+        return 1;
+    }
+
+    for (int i = 0; offset < input_len; i++)
+    {
+        size_t n = i < 3 ? pieces[i] : input_len - offset;
+        if (n > input_len - offset)
+        {
+            n = input_len - offset;
+        }
+        if (des_mode_update(&ctx, input + offset, n, output + total, &written) != 0)
+        {
+            return 1;
+        }
+        offset += n;
+        total += written;
+    }
+
+    if (des_mode_final(&ctx, output + total, &written) != 0)
+    {
+        return 1;
+    }
+    *output_len = total + written;
+    return 0;
+}
+
+// Mode layer known-answer test (ECB/CBC/CFB/OFB cross-checked with OpenSSL)
+void test_des_mode_correctness()
+{
+    unsigned char key[DES_KEY_SIZE] = { 0x01,0x23,0x45,0x67,0x89,0xab,0xcd,0xef };
+    unsigned char iv[DES_BLOCK_SIZE] = { 0x12,0x34,0x56,0x78,0x90,0xab,0xcd,0xef };
+    // "Now is the time for all good "
+    unsigned char plaintext[29] = {
+        0x4e,0x6f,0x77,0x20,0x69,0x73,0x20,0x74,0x68,0x65,0x20,0x74,
+        0x69,0x6d,0x65,0x20,0x66,0x6f,0x72,0x20,0x61,0x6c,0x6c,0x20,
+        0x67,0x6f,0x6f,0x64,0x20
+    };
+    unsigned char ecbResult[32] = {
+        0x3f,0xa4,0x0e,0x8a,0x98,0x4d,0x48,0x15,0x6a,0x27,0x17,0x87,0xab,0x88,0x83,0xf9,
+        0x89,0x3d,0x51,0xec,0x4b,0x56,0x3b,0x53,0xb0,0x6c,0xf2,0xf8,0xba,0xf0,0xfc,0x7a
+    };
+    unsigned char cbcResult[32] = {
+        0xe5,0xc7,0xcd,0xde,0x87,0x2b,0xf2,0x7c,0x43,0xe9,0x34,0x00,0x8c,0x38,0x9c,0x0f,
+        0x68,0x37,0x88,0x49,0x9a,0x7c,0x05,0xf6,0xa5,0x8e,0x94,0xdf,0xf9,0x5a,0x0f,0xba
+    };
+    unsigned char cfbResult[29] = {
+        0xf3,0x09,0x62,0x49,0xc7,0xf4,0x6e,0x51,0xa6,0x9e,0x83,0x9b,0x1a,0x92,0xf7,0x84,
+        0x03,0x46,0x71,0x33,0x89,0x8e,0xa6,0x22,0x93,0x2c,0x4d,0xda,0xa0
+    };
+    unsigned char ofbResult[29] = {
+        0xf3,0x09,0x62,0x49,0xc7,0xf4,0x6e,0x51,0x35,0xf2,0x4a,0x24,0x2e,0xeb,0x3d,0x3f,
+        0x3d,0x6d,0x5b,0xe3,0x25,0x5a,0xf8,0xc3,0x1f,0x97,0x15,0xe9,0x4d
+    };
+    unsigned char ctrResult[29] = {
+        0xf3,0x09,0x62,0x49,0xc7,0xf4,0x6e,0x51,0x16,0x3a,0x8c,0xa0,0xff,0xc9,0x4c,0x27,
+        0xfa,0x2f,0x80,0xf4,0x80,0xb8,0x6f,0x75,0x58,0xcd,0x8c,0x1a,0x8a
+    };
+    struct {
+        const char *label;
+        des_mode mode;
+        const unsigned char *expected;
+        size_t expected_len;
+    } cases[] = {
+        { "DES-ECB ciphertext", DES_MODE_ECB, ecbResult, sizeof(ecbResult) },
+        { "DES-CBC ciphertext", DES_MODE_CBC, cbcResult, sizeof(cbcResult) },
+        { "DES-CFB ciphertext", DES_MODE_CFB, cfbResult, sizeof(cfbResult) },
+        { "DES-OFB ciphertext", DES_MODE_OFB, ofbResult, sizeof(ofbResult) },
+        { "DES-CTR ciphertext", DES_MODE_CTR, ctrResult, sizeof(ctrResult) },
+    };
+    unsigned char ciphertext[64], decrypted[64];
+    size_t ciphertext_len, decrypted_len;
+    int passed = 1;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        if (run_des_mode(cases[i].mode, 0, key, iv, plaintext, sizeof(plaintext), ciphertext, &ciphertext_len) != 0 ||
+            run_des_mode(cases[i].mode, 1, key, iv, ciphertext, ciphertext_len, decrypted, &decrypted_len) != 0)
+        {
+            printf("%s: mode layer returned an error.\n", cases[i].label);
+            passed = 0;
+            continue;
+        }
+
+        passed &= ciphertext_len == cases[i].expected_len;
+        passed &= check_bytes(cases[i].label, ciphertext, cases[i].expected, cases[i].expected_len);
+        passed &= decrypted_len == sizeof(plaintext) && memcmp(decrypted, plaintext, sizeof(plaintext)) == 0;
+    }
+
+    // A truncated or corrupted last block must be rejected
+    memcpy(ciphertext, ecbResult, sizeof(ecbResult));
+    ciphertext[sizeof(ecbResult) - 1] ^= 0x01;
+    passed &= run_des_mode(DES_MODE_ECB, 1, key, iv, ecbResult, sizeof(ecbResult) - 1,
+                           decrypted, &decrypted_len) != 0;
+    passed &= run_des_mode(DES_MODE_ECB, 1, key, iv, ciphertext, sizeof(ecbResult),
+                           decrypted, &decrypted_len) != 0;
 
+    if (passed)
+    {
+        printf(">> Mode layer correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Mode layer correctness test failed.\n\n");
+    }
 }
 
 // Performance test function
@@ -91,6 +562,219 @@ void test_des_performance()
     BPS_BENCH_START("DES decryption", BENCHS);
     BPS_BENCH_ITEM(des_decrypt_block(ciphertext, subKeys, decrypted), ROUNDS);
     BPS_BENCH_FINAL(DES_BLOCK_BITS);
+
+    des_key_schedule ks;
+    if (des_make_key_schedule(key, &ks) != 0)
+    {
+        printf("Failed to generate key schedule.\n");
+        return;
+    }
+
+    BPS_BENCH_START("DES encryption (key schedule)", BENCHS);
+    BPS_BENCH_ITEM(des_encrypt_block_ks(plaintext, &ks, ciphertext), ROUNDS);
+    BPS_BENCH_FINAL(DES_BLOCK_BITS);
+
+    BPS_BENCH_START("DES decryption (key schedule)", BENCHS);
+    BPS_BENCH_ITEM(des_decrypt_block_ks(ciphertext, &ks, decrypted), ROUNDS);
+    BPS_BENCH_FINAL(DES_BLOCK_BITS);
+}
+
+// Step to the next key so every key setup works on a different key
+static void next_key(unsigned char key[DES_KEY_SIZE])
+{
+    for (int i = DES_KEY_SIZE - 1; i >= 0 && ++key[i] == 0; i--)
+    {
+    }
+}
+
+// Key setup throughput (key schedules per second), each key is different
+void test_des_key_setup_performance()
+{
+    unsigned char key[DES_KEY_SIZE] = { 0x4b,0x41,0x53,0x48,0x49,0x53,0x41,0x42 };
+    unsigned char subKeys[16][6];
+    des_key_schedule ks;
+
+    BPS_BENCH_START("des_make_key_schedule", BENCHS);
+    BPS_BENCH_ITEM((next_key(key), des_make_key_schedule(key, &ks)), SETUP_KEYS);
+    OPS_BENCH_FINAL(1);
+
+    BPS_BENCH_START("des_make_subkeys", BENCHS);
+    BPS_BENCH_ITEM((next_key(key), des_make_subkeys(key, subKeys)), SETUP_KEYS);
+    OPS_BENCH_FINAL(1);
+}
+
+// Known-plaintext key search throughput (keys/s)
+void test_des_key_search_performance()
+{
+    unsigned char plaintext[DES_BLOCK_SIZE] = { 0x4E,0x45,0x56,0x52,0x51,0x55,0x49,0x54 };
+    // No key in the swept range maps plaintext to this value, so every key is tested
+    unsigned char ciphertext[DES_BLOCK_SIZE] = { 0x76,0x35,0x49,0xD3,0x8B,0x57,0x0C,0x0E };
+    static des_key_deltas deltas;
+    des_thread_pool *pool;
+    uint64_t found;
+
+    if (des_make_key_deltas(&deltas) != 0)
+    {
+        printf("Failed to generate key schedule differences.\n");
+        return;
+    }
+
+    BPS_BENCH_START("DES known plaintext key search (single thread)", BENCHS);
+    BPS_BENCH_ITEM(des_key_search(plaintext, ciphertext, &deltas, 0, SEARCH_KEYS, &found), 1);
+    OPS_BENCH_FINAL(SEARCH_KEYS);
+
+    // One thread per online CPU
+    pool = des_thread_pool_create(0, 1 << 16);
+    if (pool == NULL)
+    {
+        printf("Failed to create thread pool.\n");
+        return;
+    }
+
+    BPS_BENCH_START("DES known plaintext key search (thread pool)", BENCHS);
+    BPS_BENCH_ITEM(des_key_search_mt(pool, plaintext, ciphertext, &deltas, 0, SEARCH_KEYS, &found), 1);
+    OPS_BENCH_FINAL(SEARCH_KEYS);
+
+    des_thread_pool_destroy(pool);
+}
+
+// Bulk performance test function
+void test_des_blocks_performance()
+{
+    unsigned char key[DES_KEY_SIZE] = { 0x4b,0x41,0x53,0x48,0x49,0x53,0x41,0x42 };
+    static unsigned char plaintext[BULK_BLOCKS * DES_BLOCK_SIZE];
+    static unsigned char ciphertext[BULK_BLOCKS * DES_BLOCK_SIZE];
+    static unsigned char decrypted[BULK_BLOCKS * DES_BLOCK_SIZE];
+    des_key_schedule ks;
+
+    if (des_make_key_schedule(key, &ks) != 0)
+    {
+        printf("Failed to generate key schedule.\n");
+        return;
+    }
+
+    fill_bytes(plaintext, sizeof(plaintext), 1);
+
+    BPS_BENCH_START("DES bitsliced encryption", BENCHS);
+    BPS_BENCH_ITEM(des_encrypt_blocks(plaintext, ciphertext, BULK_BLOCKS, &ks), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * DES_BLOCK_BITS);
+
+    BPS_BENCH_START("DES bitsliced decryption", BENCHS);
+    BPS_BENCH_ITEM(des_decrypt_blocks(ciphertext, decrypted, BULK_BLOCKS, &ks), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * DES_BLOCK_BITS);
+}
+
+// Mode layer performance test function
+void test_des_mode_performance()
+{
+    unsigned char key[DES_KEY_SIZE] = { 0x4b,0x41,0x53,0x48,0x49,0x53,0x41,0x42 };
+    unsigned char iv[DES_BLOCK_SIZE] = { 0 };
+    static unsigned char plaintext[BULK_BLOCKS * DES_BLOCK_SIZE];
+    static unsigned char ciphertext[BULK_BLOCKS * DES_BLOCK_SIZE];
+    des_key_schedule ks;
+
+    if (des_make_key_schedule(key, &ks) != 0)
+    {
+        printf("Failed to generate key schedule.\n");
+        return;
+    }
+
+    fill_bytes(plaintext, sizeof(plaintext), 1);
+
+    BPS_BENCH_START("DES-ECB encryption (interleaved)", BENCHS);
+    BPS_BENCH_ITEM(des_ecb_encrypt(plaintext, ciphertext, BULK_BLOCKS, &ks), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * DES_BLOCK_BITS);
+
+    BPS_BENCH_START("DES-CBC encryption", BENCHS);
+    BPS_BENCH_ITEM(des_cbc_encrypt(plaintext, ciphertext, BULK_BLOCKS, &ks, iv), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * DES_BLOCK_BITS);
+
+    BPS_BENCH_START("DES-CBC decryption", BENCHS);
+    BPS_BENCH_ITEM(des_cbc_decrypt(ciphertext, plaintext, BULK_BLOCKS, &ks, iv), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * DES_BLOCK_BITS);
+
+    BPS_BENCH_START("DES-CTR encryption", BENCHS);
+    BPS_BENCH_ITEM(des_ctr_crypt(plaintext, ciphertext, sizeof(plaintext), &ks, iv), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * DES_BLOCK_BITS);
+}
+
+// Multithreaded bulk performance test function
+void test_des_thread_performance()
+{
+    unsigned char key[DES_KEY_SIZE] = { 0x4b,0x41,0x53,0x48,0x49,0x53,0x41,0x42 };
+    unsigned char iv[DES_BLOCK_SIZE] = { 0 };
+    static unsigned char plaintext[MT_BLOCKS * DES_BLOCK_SIZE];
+    static unsigned char ciphertext[MT_BLOCKS * DES_BLOCK_SIZE];
+    des_key_schedule ks;
+    des_thread_pool *pool;
+
+    if (des_make_key_schedule(key, &ks) != 0)
+    {
+        printf("Failed to generate key schedule.\n");
+        return;
+    }
+
+    // One thread per online CPU
+    pool = des_thread_pool_create(0, 1024);
+    if (pool == NULL)
+    {
+        printf("Failed to create thread pool.\n");
+        return;
+    }
+
+    fill_bytes(plaintext, sizeof(plaintext), 1);
+
+    BPS_BENCH_START("DES-ECB encryption (single thread)", BENCHS);
+    BPS_BENCH_ITEM(des_encrypt_blocks(plaintext, ciphertext, MT_BLOCKS, &ks), MT_ROUNDS);
+    BPS_BENCH_FINAL(MT_BLOCKS * DES_BLOCK_BITS);
+
+    BPS_BENCH_START("DES-ECB encryption (thread pool)", BENCHS);
+    BPS_BENCH_ITEM(des_ecb_encrypt_mt(pool, plaintext, ciphertext, MT_BLOCKS, &ks), MT_ROUNDS);
+    BPS_BENCH_FINAL(MT_BLOCKS * DES_BLOCK_BITS);
+
+    BPS_BENCH_START("DES-CTR encryption (thread pool)", BENCHS);
+    BPS_BENCH_ITEM(des_ctr_crypt_mt(pool, plaintext, ciphertext, sizeof(plaintext), &ks, iv), MT_ROUNDS);
+    BPS_BENCH_FINAL(MT_BLOCKS * DES_BLOCK_BITS);
+
+    BPS_BENCH_START("DES-CBC decryption (thread pool)", BENCHS);
+    BPS_BENCH_ITEM(des_cbc_decrypt_mt(pool, ciphertext, plaintext, MT_BLOCKS, &ks, iv), MT_ROUNDS);
+    BPS_BENCH_FINAL(MT_BLOCKS * DES_BLOCK_BITS);
+
+    des_thread_pool_destroy(pool);
+}
+
+// Triple-DES performance test function
+void test_des3_performance()
+{
+    unsigned char key[DES3_KEY_SIZE] = {
+        0x01,0x23,0x45,0x67,0x89,0xab,0xcd,0xef,
+        0x23,0x45,0x67,0x89,0xab,0xcd,0xef,0x01,
+        0x45,0x67,0x89,0xab,0xcd,0xef,0x01,0x23
+    };
+    static unsigned char plaintext[BULK_BLOCKS * DES_BLOCK_SIZE];
+    static unsigned char ciphertext[BULK_BLOCKS * DES_BLOCK_SIZE];
+    unsigned char iv[DES_BLOCK_SIZE] = { 0 };
+    des3_key_schedule ks;
+
+    if (des3_make_key_schedule(key, DES3_KEY_SIZE, &ks) != 0)
+    {
+        printf("Failed to generate Triple-DES key schedule.\n");
+        return;
+    }
+
+    fill_bytes(plaintext, sizeof(plaintext), 1);
+
+    BPS_BENCH_START("3DES-ECB encryption", BENCHS);
+    BPS_BENCH_ITEM(des3_ecb_encrypt(plaintext, ciphertext, BULK_BLOCKS, &ks), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * DES_BLOCK_BITS);
+
+    BPS_BENCH_START("3DES-CBC encryption", BENCHS);
+    BPS_BENCH_ITEM(des3_cbc_encrypt(plaintext, ciphertext, BULK_BLOCKS, &ks, iv), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * DES_BLOCK_BITS);
+
+    BPS_BENCH_START("3DES-CBC decryption", BENCHS);
+    BPS_BENCH_ITEM(des3_cbc_decrypt(ciphertext, plaintext, BULK_BLOCKS, &ks, iv), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * DES_BLOCK_BITS);
 }
 
 
@@ -99,10 +783,21 @@ int main()
     // Perform correctness test
     printf(">> Performing correctness test...\n");
     test_des_correctness();
+    test_des_blocks_correctness();
+    test_des3_correctness();
+    test_des_mode_correctness();
+    test_des_thread_correctness();
+    test_des_key_search_correctness();
 
     // Perform performance test
     printf(">> Performing performance test...\n");
     test_des_performance();
+    test_des_key_setup_performance();
+    test_des_key_search_performance();
+    test_des_blocks_performance();
+    test_des_mode_performance();
+    test_des_thread_performance();
+    test_des3_performance();
 
     return 0;
 }
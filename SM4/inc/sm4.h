@@ -6,6 +6,7 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define SM4_BLOCK_BITS 128 /* bits of SM4 algorithm block */
@@ -13,6 +14,58 @@ extern "C"
 #define SM4_KEY_SIZE 16    /* bytes of SM4 algorithm key */
 #define SM4_ROUNDS 32 /* SM4 requires 32 round keys */
 
+    /**
+     * @brief Block cipher implementation behind the SM4 entry points
+     */
+    typedef enum {
+        SM4_IMPL_AUTO,      /* T-table for single blocks, AES-NI for 4+ blocks per call when the CPU supports it */
+        SM4_IMPL_TABLE,     /* 4 x 256 T-table C code, S-box and L fused */
+        SM4_IMPL_AESNI,     /* S-box through AESENCLAST and affine maps, 4 / 8 / 16 blocks per register */
+        SM4_IMPL_BITSLICE,  /* bitsliced C code, constant time, 64 blocks per pass */
+        SM4_IMPL_REFERENCE, /* S-box lookups followed by L, for cross-checking */
+        SM4_IMPL_COUNT      /* number of entries, not an implementation */
+    } sm4_impl;
+
+    /**
+     * @brief Check the CPU for AES-NI and SSSE3 (CPUID)
+     * @return 1 supported
+     * @return 0 not supported
+     */
+    int sm4_has_aesni(void);
+
+    /**
+     * @brief Select the implementation used by all SM4 entry points
+     * Without a call, SM4_IMPL_AUTO is selected on first use, which is safe from several threads.
+     * Switching implementations while other threads use SM4 is not supported, call this first
+     * SM4_IMPL_AUTO reports SM4_IMPL_AESNI when it uses the AES-NI kernels; select SM4_IMPL_AESNI
+     * explicitly for table-free single blocks, at about half the T-table speed in serial modes
+     * @param[in] impl implementation, SM4_IMPL_AUTO picks the fastest supported one per call
+     * @return 0 OK
+     * @return 1 Failed (not supported by this CPU)
+     */
+    int sm4_set_impl(sm4_impl impl);
+
+    /**
+     * @brief Check whether an implementation is built in and supported by this CPU
+     * @param[in] impl implementation
+     * @return 1 supported
+     * @return 0 not supported
+     */
+    int sm4_impl_supported(sm4_impl impl);
+
+    /**
+     * @brief Name of an implementation, e.g. for benchmark output
+     * @param[in] impl implementation
+     * @return name
+     */
+    const char *sm4_impl_name(sm4_impl impl);
+
+    /**
+     * @brief Get the implementation in use (never SM4_IMPL_AUTO)
+     * @return implementation
+     */
+    sm4_impl sm4_get_impl(void);
+
     /**
      * @brief Generate encryption subkeys
      * @param[in] key original key
@@ -48,12 +101,30 @@ extern "C"
      */
     void sm4_decrypt_block(const unsigned char *input, const uint32_t decSubKeys[SM4_ROUNDS], unsigned char *output);
 
+    /**
+     * @brief SM4 encrypt independent blocks (ECB), SIMD backends process many blocks per instruction
+     * @param[in] input plaintext, [length = nblocks * SM4_BLOCK_SIZE]
+     * @param[out] output ciphertext, [length = nblocks * SM4_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] encSubKeys encryption subKeys
+     */
+    void sm4_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const uint32_t encSubKeys[SM4_ROUNDS]);
+
+    /**
+     * @brief SM4 decrypt independent blocks (ECB)
+     * @param[in] input ciphertext, [length = nblocks * SM4_BLOCK_SIZE]
+     * @param[out] output plaintext, [length = nblocks * SM4_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] decSubKeys decryption subKeys
+     */
+    void sm4_decrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const uint32_t decSubKeys[SM4_ROUNDS]);
+
 #ifdef __cplusplus
 }
 #endif
 
-#endif // SM4_H
-
 #include <string.h>
 
 static const uint32_t FK[4] = {0xa3b1bac6, 0x56aa3350, 0x677d9197, 0xb27022dc};
@@ -116,3 +187,7 @@ static uint32_t T_prime(uint32_t x) {
     // 线性变换 L'(t)
     return t ^ ((t << 13) | (t >> 19)) ^ ((t << 23) | (t >> 9));
 }
+
+#include "table.h"
+
+#endif // SM4_H
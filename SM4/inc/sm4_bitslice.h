@@ -0,0 +1,45 @@
+#ifndef SM4_BITSLICE_H
+#define SM4_BITSLICE_H
+
+#include "sm4.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Bitsliced constant-time backend, round keys from sm4_make_enc_subkeys
+     * No table lookups and no secret-dependent branches, in the key schedule too;
+     * 64 blocks per pass on 64-bit targets and 32 on 32-bit targets, shorter inputs are padded to a full pass
+     */
+
+    /**
+     * @brief Constant-time key schedule, the S-box in T' is the bitsliced circuit
+     * @param[in] key original key
+     * @param[out] encSubKeys encryption round keys
+     */
+    void sm4_bs_make_enc_subkeys(const unsigned char key[SM4_KEY_SIZE], uint32_t encSubKeys[SM4_ROUNDS]);
+
+    /**
+     * @brief Bitsliced encrypt independent blocks (decrypt with reversed round keys)
+     * @param[in] input plaintext, [length = nblocks * SM4_BLOCK_SIZE]
+     * @param[out] output ciphertext, [length = nblocks * SM4_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] encSubKeys round keys from sm4_make_enc_subkeys
+     */
+    void sm4_bs_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                               const uint32_t encSubKeys[SM4_ROUNDS]);
+
+    /**
+     * @brief Bitsliced encrypt single block, costs a full pass
+     * @param[in] input plaintext, [length = SM4_BLOCK_SIZE]
+     * @param[in] encSubKeys round keys from sm4_make_enc_subkeys
+     * @param[out] output ciphertext, [length = SM4_BLOCK_SIZE]
+     */
+    void sm4_bs_encrypt_block(const unsigned char *input, const uint32_t encSubKeys[SM4_ROUNDS], unsigned char *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM4_BITSLICE_H
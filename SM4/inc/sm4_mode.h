@@ -0,0 +1,101 @@
+#ifndef SM4_MODE_H
+#define SM4_MODE_H
+
+#include "sm4.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define SM4_MODE_BATCH 32 /* blocks handed to sm4_encrypt_blocks at once by the parallel modes */
+
+    /**
+     * @brief Block cipher mode of a sm4_mode_ctx
+     * ECB / CBC: no padding, every update must be a multiple of SM4_BLOCK_SIZE.
+     * CTR: 128-bit big-endian counter (GB/T 17964), any length.
+     * CFB (CFB-128) / OFB: any length, a partial block is continued by the next update.
+     */
+    typedef enum {
+        SM4_MODE_ECB,
+        SM4_MODE_CBC,
+        SM4_MODE_CTR,
+        SM4_MODE_CFB,
+        SM4_MODE_OFB
+    } sm4_mode;
+
+    /**
+     * @brief Streaming context, the key schedule is computed once in sm4_mode_init
+     */
+    typedef struct {
+        uint32_t rk[SM4_ROUNDS];          /* round keys, reversed for ECB / CBC decryption */
+        unsigned char iv[SM4_BLOCK_SIZE]; /* CBC: last ciphertext block, CTR: next counter block,
+                                             CFB / OFB: feedback register (keystream while num != 0) */
+        unsigned char ks[SM4_BLOCK_SIZE]; /* CTR keystream of the current partial block */
+        size_t num;                       /* bytes of the current partial block already used */
+        sm4_mode mode;
+        int decrypt;
+    } sm4_mode_ctx;
+
+    /**
+     * @brief Initialize a mode context, the caller's IV is copied and never modified
+     * @param[out] ctx context
+     * @param[in] mode block cipher mode
+     * @param[in] key original key
+     * @param[in] iv IV / initial counter block, [length = SM4_BLOCK_SIZE], may be NULL for ECB
+     * @param[in] decrypt 0 encrypt, 1 decrypt (CTR and OFB are the same in both directions)
+     * @return 0 OK
+     * @return 1 Failed (unknown mode or missing IV)
+     */
+    int sm4_mode_init(sm4_mode_ctx *ctx, sm4_mode mode, const unsigned char key[SM4_KEY_SIZE],
+                      const unsigned char iv[SM4_BLOCK_SIZE], int decrypt);
+
+    /**
+     * @brief Process the next part of the message, chaining state is kept across calls
+     * @param[in,out] ctx context
+     * @param[in] input input data, [length = len]
+     * @param[out] output output data, [length = len], may equal input
+     * @param[in] len bytes, a multiple of SM4_BLOCK_SIZE for ECB and CBC
+     * @return 0 OK
+     * @return 1 Failed (bad length)
+     */
+    int sm4_mode_update(sm4_mode_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len);
+
+    /**
+     * @brief Finish: no padding is added or removed, the round keys and chaining state are wiped
+     * @param[in,out] ctx context
+     * @return 0 OK
+     */
+    int sm4_mode_final(sm4_mode_ctx *ctx);
+
+    /**
+     * @brief One-shot SM4-CBC encryption without padding
+     * @param[in] plaintext plaintext, [length = length]
+     * @param[in] length bytes, a multiple of SM4_BLOCK_SIZE
+     * @param[in] key original key
+     * @param[in] iv IV, [length = SM4_BLOCK_SIZE], not modified
+     * @param[out] ciphertext ciphertext, [length = length]
+     * @return 0 OK
+     * @return 1 Failed (bad length)
+     */
+    int sm4_encrypt_cbc(const unsigned char *plaintext, size_t length, const unsigned char key[SM4_KEY_SIZE],
+                        const unsigned char iv[SM4_BLOCK_SIZE], unsigned char *ciphertext);
+
+    /**
+     * @brief One-shot SM4-CBC decryption without padding
+     * @param[in] ciphertext ciphertext, [length = length]
+     * @param[in] length bytes, a multiple of SM4_BLOCK_SIZE
+     * @param[in] key original key
+     * @param[in] iv IV used for encryption, [length = SM4_BLOCK_SIZE], not modified
+     * @param[out] plaintext plaintext, [length = length]
+     * @return 0 OK
+     * @return 1 Failed (bad length)
+     */
+    int sm4_decrypt_cbc(const unsigned char *ciphertext, size_t length, const unsigned char key[SM4_KEY_SIZE],
+                        const unsigned char iv[SM4_BLOCK_SIZE], unsigned char *plaintext);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM4_MODE_H
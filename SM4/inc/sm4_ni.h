@@ -0,0 +1,55 @@
+#ifndef SM4_NI_H
+#define SM4_NI_H
+
+#include "sm4.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief SM4 with AES-NI: the SM4 S-box is affine-equivalent to the AES S-box, so each S-box
+     * layer is a nibble-table affine map, one AESENCLAST and a second affine map.
+     * Blocks are transposed so each register holds the same word of 4 blocks per 128-bit lane.
+     * Only call these when sm4_has_aesni() returns 1
+     */
+
+    /**
+     * @brief AES-NI key schedule, the S-box in T' uses the same AESENCLAST + affine maps as the kernels
+     * @param[in] key original key
+     * @param[out] encSubKeys encryption round keys
+     */
+    void sm4_ni_make_enc_subkeys(const unsigned char key[SM4_KEY_SIZE], uint32_t encSubKeys[SM4_ROUNDS]);
+
+    /**
+     * @brief AES-NI encrypt single block (decrypt with reversed round keys)
+     * @param[in] input plaintext, [length = SM4_BLOCK_SIZE]
+     * @param[in] encSubKeys round keys from sm4_make_enc_subkeys
+     * @param[out] output ciphertext, [length = SM4_BLOCK_SIZE]
+     */
+    void sm4_ni_encrypt_block(const unsigned char *input, const uint32_t encSubKeys[SM4_ROUNDS], unsigned char *output);
+
+    /**
+     * @brief AES-NI encrypt independent blocks
+     * 4 blocks per SSE register, 8 per AVX2 register and 16 per AVX-512 register with VAES,
+     * the widest kernel is picked from CPUID on the first call
+     * @param[in] input plaintext, [length = nblocks * SM4_BLOCK_SIZE]
+     * @param[out] output ciphertext, [length = nblocks * SM4_BLOCK_SIZE], may equal input
+     * @param[in] nblocks number of blocks
+     * @param[in] encSubKeys round keys from sm4_make_enc_subkeys
+     */
+    void sm4_ni_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                               const uint32_t encSubKeys[SM4_ROUNDS]);
+
+    /**
+     * @brief Name of the widest kernel sm4_ni_encrypt_blocks uses on this CPU
+     * @return "SSE", "AVX2" or "AVX-512 VAES"
+     */
+    const char *sm4_ni_kernel_name(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM4_NI_H
@@ -1,11 +1,29 @@
 #include "../inc/sm4.h"
+#include "../inc/sm4_bitslice.h"
+#include "../inc/sm4_ni.h"
 
-int sm4_make_enc_subkeys(const unsigned char key[SM4_KEY_SIZE], uint32_t encSubKeys[SM4_ROUNDS]) {
+#define SM4_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+#define SM4_LOAD_BE(p) (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                        ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+
+#define SM4_STORE_BE(p, v)                 \
+    do {                                   \
+        (p)[0] = (unsigned char)((v) >> 24); \
+        (p)[1] = (unsigned char)((v) >> 16); \
+        (p)[2] = (unsigned char)((v) >> 8);  \
+        (p)[3] = (unsigned char)(v);         \
+    } while (0)
+
+static int sm4_always_supported(void) {
+    return 1;
+}
+
+// 参考实现：逐字节查 S 盒后再做线性变换 L / L'，即原来的写法
+static void sm4_make_enc_subkeys_ref(const unsigned char key[SM4_KEY_SIZE], uint32_t encSubKeys[SM4_ROUNDS]) {
     uint32_t K[4];
     for (int i = 0; i < 4; ++i) {
-        K[i] = ((uint32_t)key[4 * i] << 24) | ((uint32_t)key[4 * i + 1] << 16) |
-               ((uint32_t)key[4 * i + 2] << 8) | (uint32_t)key[4 * i + 3];
-        K[i] ^= FK[i];
+        K[i] = SM4_LOAD_BE(key + 4 * i) ^ FK[i];
     }
     for (int i = 0; i < SM4_ROUNDS; ++i) {
         encSubKeys[i] = K[0] ^ T_prime(K[1] ^ K[2] ^ K[3] ^ CK[i]);
@@ -14,55 +32,216 @@ int sm4_make_enc_subkeys(const unsigned char key[SM4_KEY_SIZE], uint32_t encSubK
         K[2] = K[3];
         K[3] = encSubKeys[i];
     }
-
-    // printf("Around Key\n");
-    // for(int i = 0; i < 32; i++) {
-    //     printf("%08x\n", encSubKeys[i] );
-    // }
-
-    return 0;
-}
-
-int sm4_make_dec_subkeys(const unsigned char key[SM4_KEY_SIZE], uint32_t decSubKeys[SM4_ROUNDS]) {
-    uint32_t temp[SM4_ROUNDS];
-    sm4_make_enc_subkeys(key, temp);
-    for (int i = 0; i < SM4_ROUNDS; ++i) {
-        decSubKeys[i] = temp[SM4_ROUNDS - 1 - i];
-    }
-    return 0;
 }
 
-void sm4_encrypt_block(const unsigned char *input, const uint32_t encSubKeys[SM4_ROUNDS], unsigned char *output) {
+static void sm4_encrypt_block_ref(const unsigned char *input, const uint32_t encSubKeys[SM4_ROUNDS], unsigned char *output) {
     uint32_t X[4];
     for (int i = 0; i < 4; ++i) {
-        X[i] = ((uint32_t)input[4 * i] << 24) | ((uint32_t)input[4 * i + 1] << 16) |
-               ((uint32_t)input[4 * i + 2] << 8) | (uint32_t)input[4 * i + 3];
+        X[i] = SM4_LOAD_BE(input + 4 * i);
     }
-
-    // for(int i = 0; i < 4; i++) {
-    //     printf("%08x\n", X[i]);
-    // }
-
     for (int i = 0; i < SM4_ROUNDS; ++i) {
         uint32_t temp = X[0] ^ T(X[1] ^ X[2] ^ X[3] ^ encSubKeys[i]);
         X[0] = X[1];
         X[1] = X[2];
         X[2] = X[3];
         X[3] = temp;
+    }
+    for (int i = 0; i < 4; ++i) {
+        SM4_STORE_BE(output + 4 * i, X[3 - i]);
+    }
+}
+
+// T 表实现：SM4_T0..T3 已合并 S 盒与 L，一次轮函数只需 4 次查表和 3 次异或
+static inline uint32_t sm4_t_table(uint32_t x) {
+    return SM4_T0[x >> 24] ^ SM4_T1[(x >> 16) & 0xFF] ^ SM4_T2[(x >> 8) & 0xFF] ^ SM4_T3[x & 0xFF];
+}
+
+// L' 与循环移位可交换，密钥扩展只用一张 SM4_KT 表，其余字节位置靠循环右移得到
+static inline uint32_t sm4_t_prime_table(uint32_t x) {
+    return SM4_KT[x >> 24] ^ SM4_ROTR(SM4_KT[(x >> 16) & 0xFF], 8) ^
+           SM4_ROTR(SM4_KT[(x >> 8) & 0xFF], 16) ^ SM4_ROTR(SM4_KT[x & 0xFF], 24);
+}
 
-    // printf("Round %d\n", i);
-    // printf("%08x\n", X[3]); // 只打印 X[3]
+static void sm4_make_enc_subkeys_table(const unsigned char key[SM4_KEY_SIZE], uint32_t encSubKeys[SM4_ROUNDS]) {
+    uint32_t k0 = SM4_LOAD_BE(key) ^ FK[0];
+    uint32_t k1 = SM4_LOAD_BE(key + 4) ^ FK[1];
+    uint32_t k2 = SM4_LOAD_BE(key + 8) ^ FK[2];
+    uint32_t k3 = SM4_LOAD_BE(key + 12) ^ FK[3];
 
+    // 四轮一组轮换寄存器角色，省去每轮的移位赋值
+    for (int i = 0; i < SM4_ROUNDS; i += 4) {
+        k0 ^= sm4_t_prime_table(k1 ^ k2 ^ k3 ^ CK[i]);
+        k1 ^= sm4_t_prime_table(k2 ^ k3 ^ k0 ^ CK[i + 1]);
+        k2 ^= sm4_t_prime_table(k3 ^ k0 ^ k1 ^ CK[i + 2]);
+        k3 ^= sm4_t_prime_table(k0 ^ k1 ^ k2 ^ CK[i + 3]);
+        encSubKeys[i] = k0;
+        encSubKeys[i + 1] = k1;
+        encSubKeys[i + 2] = k2;
+        encSubKeys[i + 3] = k3;
     }
-    for (int i = 0; i < 4; ++i) {
-        output[4 * i]     = (X[3 - i] >> 24) & 0xFF;
-        output[4 * i + 1] = (X[3 - i] >> 16) & 0xFF;
-        output[4 * i + 2] = (X[3 - i] >> 8)  & 0xFF;
-        output[4 * i + 3] = X[3 - i] & 0xFF;
+}
+
+static void sm4_encrypt_block_table(const unsigned char *input, const uint32_t encSubKeys[SM4_ROUNDS], unsigned char *output) {
+    uint32_t x0 = SM4_LOAD_BE(input);
+    uint32_t x1 = SM4_LOAD_BE(input + 4);
+    uint32_t x2 = SM4_LOAD_BE(input + 8);
+    uint32_t x3 = SM4_LOAD_BE(input + 12);
+
+    for (int i = 0; i < SM4_ROUNDS; i += 4) {
+        x0 ^= sm4_t_table(x1 ^ x2 ^ x3 ^ encSubKeys[i]);
+        x1 ^= sm4_t_table(x2 ^ x3 ^ x0 ^ encSubKeys[i + 1]);
+        x2 ^= sm4_t_table(x3 ^ x0 ^ x1 ^ encSubKeys[i + 2]);
+        x3 ^= sm4_t_table(x0 ^ x1 ^ x2 ^ encSubKeys[i + 3]);
+    }
+
+    // 反序变换 R
+    SM4_STORE_BE(output, x3);
+    SM4_STORE_BE(output + 4, x2);
+    SM4_STORE_BE(output + 8, x1);
+    SM4_STORE_BE(output + 12, x0);
+}
+
+// 单分组后端逐块处理
+static void sm4_encrypt_blocks_ref(const unsigned char *input, unsigned char *output, size_t nblocks,
+                                   const uint32_t encSubKeys[SM4_ROUNDS]) {
+    for (size_t i = 0; i < nblocks; i++) {
+        sm4_encrypt_block_ref(input + i * SM4_BLOCK_SIZE, encSubKeys, output + i * SM4_BLOCK_SIZE);
+    }
+}
+
+static void sm4_encrypt_blocks_table(const unsigned char *input, unsigned char *output, size_t nblocks,
+                                     const uint32_t encSubKeys[SM4_ROUNDS]) {
+    for (size_t i = 0; i < nblocks; i++) {
+        sm4_encrypt_block_table(input + i * SM4_BLOCK_SIZE, encSubKeys, output + i * SM4_BLOCK_SIZE);
     }
 }
 
+int sm4_has_aesni(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") && __builtin_cpu_supports("ssse3") ? 1 : 0;
+}
+
+// 后端注册表：每个实现提供同一组入口，sm4_set_impl 只切换当前表项
+typedef struct {
+    sm4_impl impl;
+    const char *name;
+    int (*supported)(void);
+    void (*make_enc_subkeys)(const unsigned char key[SM4_KEY_SIZE], uint32_t encSubKeys[SM4_ROUNDS]);
+    void (*encrypt_block)(const unsigned char *input, const uint32_t encSubKeys[SM4_ROUNDS], unsigned char *output);
+    void (*encrypt_blocks)(const unsigned char *input, unsigned char *output, size_t nblocks,
+                           const uint32_t encSubKeys[SM4_ROUNDS]);
+} sm4_backend;
+
+static const sm4_backend sm4_backends[] = {
+    { SM4_IMPL_TABLE, "T-table", sm4_always_supported,
+      sm4_make_enc_subkeys_table, sm4_encrypt_block_table, sm4_encrypt_blocks_table },
+    { SM4_IMPL_AESNI, "AES-NI", sm4_has_aesni,
+      sm4_ni_make_enc_subkeys, sm4_ni_encrypt_block, sm4_ni_encrypt_blocks },
+    { SM4_IMPL_BITSLICE, "Bitsliced", sm4_always_supported,
+      sm4_bs_make_enc_subkeys, sm4_bs_encrypt_block, sm4_bs_encrypt_blocks },
+    { SM4_IMPL_REFERENCE, "Reference", sm4_always_supported,
+      sm4_make_enc_subkeys_ref, sm4_encrypt_block_ref, sm4_encrypt_blocks_ref },
+};
+
+// AUTO 在有 AES-NI 时的表项：单分组 AES-NI 要先广播再逐轮做仿射与 AESENCLAST，只有查表的一半快，
+// 所以单分组与密钥编排走 T 表，成批分组交给 AES-NI 内核；显式选择 SM4_IMPL_AESNI 仍是全程 AES-NI
+static void sm4_encrypt_blocks_auto(const unsigned char *input, unsigned char *output, size_t nblocks,
+                                    const uint32_t encSubKeys[SM4_ROUNDS]) {
+    if (nblocks < 4) {
+        sm4_encrypt_blocks_table(input, output, nblocks, encSubKeys);
+    } else {
+        sm4_ni_encrypt_blocks(input, output, nblocks, encSubKeys);
+    }
+}
+
+static const sm4_backend sm4_auto_aesni = {
+    SM4_IMPL_AESNI, "AES-NI", sm4_has_aesni,
+    sm4_make_enc_subkeys_table, sm4_encrypt_block_table, sm4_encrypt_blocks_auto
+};
+
+// 当前使用的实现，首次调用时确定
+static const sm4_backend *sm4_active = NULL;
+
+static const sm4_backend *sm4_find_backend(sm4_impl impl) {
+    for (size_t i = 0; i < sizeof(sm4_backends) / sizeof(sm4_backends[0]); i++) {
+        if (sm4_backends[i].impl == impl) {
+            return &sm4_backends[i];
+        }
+    }
+    return NULL;
+}
+
+// 首次调用可能同时来自多个线程：指针原子读写，几个线程并发解析 AUTO 得到的是同一表项
+static inline const sm4_backend *sm4_backend_active(void) {
+    const sm4_backend *backend = __atomic_load_n(&sm4_active, __ATOMIC_ACQUIRE);
+    if (backend == NULL) {
+        sm4_set_impl(SM4_IMPL_AUTO);
+        backend = __atomic_load_n(&sm4_active, __ATOMIC_ACQUIRE);
+    }
+    return backend;
+}
+
+int sm4_impl_supported(sm4_impl impl) {
+    const sm4_backend *backend = sm4_find_backend(impl);
+    return backend != NULL && backend->supported();
+}
+
+const char *sm4_impl_name(sm4_impl impl) {
+    const sm4_backend *backend = sm4_find_backend(impl);
+    return backend != NULL ? backend->name : "Auto";
+}
+
+int sm4_set_impl(sm4_impl impl) {
+    if (impl == SM4_IMPL_AUTO) {
+        // 位切片实现单个分组也要算满一批，只在批量场景下显式选择
+        if (sm4_has_aesni()) {
+            __atomic_store_n(&sm4_active, &sm4_auto_aesni, __ATOMIC_RELEASE);
+            return 0;
+        }
+        impl = SM4_IMPL_TABLE;
+    }
+    if (!sm4_impl_supported(impl)) {
+        return 1;
+    }
+
+    __atomic_store_n(&sm4_active, sm4_find_backend(impl), __ATOMIC_RELEASE);
+    return 0;
+}
+
+sm4_impl sm4_get_impl(void) {
+    return sm4_backend_active()->impl;
+}
+
+int sm4_make_enc_subkeys(const unsigned char key[SM4_KEY_SIZE], uint32_t encSubKeys[SM4_ROUNDS]) {
+    sm4_backend_active()->make_enc_subkeys(key, encSubKeys);
+    return 0;
+}
+
+int sm4_make_dec_subkeys(const unsigned char key[SM4_KEY_SIZE], uint32_t decSubKeys[SM4_ROUNDS]) {
+    // 解密轮密钥即加密轮密钥逆序，原地对调
+    sm4_make_enc_subkeys(key, decSubKeys);
+    for (int i = 0; i < SM4_ROUNDS / 2; ++i) {
+        uint32_t t = decSubKeys[i];
+        decSubKeys[i] = decSubKeys[SM4_ROUNDS - 1 - i];
+        decSubKeys[SM4_ROUNDS - 1 - i] = t;
+    }
+    return 0;
+}
+
+void sm4_encrypt_block(const unsigned char *input, const uint32_t encSubKeys[SM4_ROUNDS], unsigned char *output) {
+    sm4_backend_active()->encrypt_block(input, encSubKeys, output);
+}
+
 void sm4_decrypt_block(const unsigned char *input, const uint32_t decSubKeys[SM4_ROUNDS], unsigned char *output) {
-    sm4_encrypt_block(input, decSubKeys, output);
+    sm4_backend_active()->encrypt_block(input, decSubKeys, output);
+}
+
+void sm4_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const uint32_t encSubKeys[SM4_ROUNDS]) {
+    sm4_backend_active()->encrypt_blocks(input, output, nblocks, encSubKeys);
 }
 
+void sm4_decrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const uint32_t decSubKeys[SM4_ROUNDS]) {
+    sm4_backend_active()->encrypt_blocks(input, output, nblocks, decSubKeys);
+}
@@ -0,0 +1,319 @@
+#include "../inc/sm4_bitslice.h"
+
+/*
+ * 位切片（bitslice）SM4：切片字的每一位属于一个分组，64 位平台一次处理 64 个分组，32 位平台 32 个。
+ * 一个字的 32 个切片按 S 盒字节分组：向量 X[w][i] 的第 k 个元素是第 w 个字第 k 个字节（大端）的第 7 - i 位，
+ * 于是 4 个 S 盒共用一次电路求值，L 中的循环移位变成切片下标与向量元素的轮换。
+ * 整个过程没有查表，也没有依赖密钥或数据的分支。
+ */
+
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t sm4_bs_word;
+#else
+typedef uint32_t sm4_bs_word;
+#endif
+
+#define SM4_BS_BLOCKS ((int)(8 * sizeof(sm4_bs_word)))
+
+// 同一位在 4 个字节上的切片字，AVX2 下为一个 256 位寄存器
+typedef sm4_bs_word sm4_bs_vec __attribute__((vector_size(4 * sizeof(sm4_bs_word))));
+
+// 向量元素循环左移 s 个位置：结果第 k 个元素取自第 k + s 个
+#define SM4_BS_ROT(V, S) __builtin_shuffle(V, (sm4_bs_vec){ (S) & 3, ((S) + 1) & 3, ((S) + 2) & 3, ((S) + 3) & 3 })
+
+/*
+ * S 盒电路：SM4 的 S 盒与 AES 的 S 盒仿射等价，S(x) = A2 * S_aes(A1 * x + c1) + c2。
+ * 中间的求逆部分沿用 Boyar-Peralta 的 AES 电路，两侧的仿射变换并入其顶层与底层线性层，共约 135 个门。
+ * q[0..7] 依次为字节的第 7..0 位，向量的 4 个元素是 4 个独立的字节
+ */
+static inline void sm4_bs_sbox(sm4_bs_vec *q) {
+    sm4_bs_vec u7 = q[0], u6 = q[1], u5 = q[2], u4 = q[3];
+    sm4_bs_vec u3 = q[4], u2 = q[5], u1 = q[6], u0 = q[7];
+
+    // 输入仿射变换与 AES 电路的顶层线性层合并
+    sm4_bs_vec c0 = u1 ^ u4;
+    sm4_bs_vec c1 = u2 ^ u5;
+    sm4_bs_vec c2 = u0 ^ u6;
+    sm4_bs_vec c3 = u3 ^ u7;
+    sm4_bs_vec c4 = u1 ^ c2;
+    sm4_bs_vec c5 = u2 ^ u6;
+    sm4_bs_vec c6 = c0 ^ c3;
+    sm4_bs_vec c7 = u4 ^ c1;
+    sm4_bs_vec c8 = u5 ^ c6;
+    sm4_bs_vec c9 = u7 ^ c0;
+    sm4_bs_vec c10 = c0 ^ c1;
+    sm4_bs_vec x7 = u3 ^ c5;
+    sm4_bs_vec y1 = ~(u3 ^ c10);
+    sm4_bs_vec y2 = ~(u5 ^ c4);
+    sm4_bs_vec y3 = ~c10;
+    sm4_bs_vec y4 = c1;
+    sm4_bs_vec y5 = u2 ^ c0;
+    sm4_bs_vec y6 = ~c6;
+    sm4_bs_vec y7 = ~(u4 ^ u5 ^ u6 ^ u7);
+    sm4_bs_vec y8 = ~u5;
+    sm4_bs_vec y9 = ~(u2 ^ c4);
+    sm4_bs_vec y10 = u7 ^ c1;
+    sm4_bs_vec y11 = ~(c3 ^ c7);
+    sm4_bs_vec y12 = ~c0;
+    sm4_bs_vec y13 = ~(c2 ^ c7);
+    sm4_bs_vec y14 = c1 ^ c4;
+    sm4_bs_vec y15 = ~(c5 ^ c9);
+    sm4_bs_vec y16 = u1 ^ c3 ^ c5;
+    sm4_bs_vec y17 = ~(u3 ^ u4);
+    sm4_bs_vec y18 = u0 ^ c9;
+    sm4_bs_vec y19 = ~(u2 ^ u7);
+    sm4_bs_vec y20 = c2 ^ c8;
+    sm4_bs_vec y21 = ~(u0 ^ c8);
+
+    // GF(2^8) 求逆的非线性部分，与 AES 电路相同
+    sm4_bs_vec t2 = y12 & y15;
+    sm4_bs_vec t3 = y3 & y6;
+    sm4_bs_vec t4 = t3 ^ t2;
+    sm4_bs_vec t5 = y4 & x7;
+    sm4_bs_vec t6 = t5 ^ t2;
+    sm4_bs_vec t7 = y13 & y16;
+    sm4_bs_vec t8 = y5 & y1;
+    sm4_bs_vec t9 = t8 ^ t7;
+    sm4_bs_vec t10 = y2 & y7;
+    sm4_bs_vec t11 = t10 ^ t7;
+    sm4_bs_vec t12 = y9 & y11;
+    sm4_bs_vec t13 = y14 & y17;
+    sm4_bs_vec t14 = t13 ^ t12;
+    sm4_bs_vec t15 = y8 & y10;
+    sm4_bs_vec t16 = t15 ^ t12;
+    sm4_bs_vec t17 = t4 ^ t14;
+    sm4_bs_vec t18 = t6 ^ t16;
+    sm4_bs_vec t19 = t9 ^ t14;
+    sm4_bs_vec t20 = t11 ^ t16;
+    sm4_bs_vec t21 = t17 ^ y20;
+    sm4_bs_vec t22 = t18 ^ y19;
+    sm4_bs_vec t23 = t19 ^ y21;
+    sm4_bs_vec t24 = t20 ^ y18;
+    sm4_bs_vec t25 = t21 ^ t22;
+    sm4_bs_vec t26 = t21 & t23;
+    sm4_bs_vec t27 = t24 ^ t26;
+    sm4_bs_vec t28 = t25 & t27;
+    sm4_bs_vec t29 = t28 ^ t22;
+    sm4_bs_vec t30 = t23 ^ t24;
+    sm4_bs_vec t31 = t22 ^ t26;
+    sm4_bs_vec t32 = t31 & t30;
+    sm4_bs_vec t33 = t32 ^ t24;
+    sm4_bs_vec t34 = t23 ^ t33;
+    sm4_bs_vec t35 = t27 ^ t33;
+    sm4_bs_vec t36 = t24 & t35;
+    sm4_bs_vec t37 = t36 ^ t34;
+    sm4_bs_vec t38 = t27 ^ t36;
+    sm4_bs_vec t39 = t29 & t38;
+    sm4_bs_vec t40 = t25 ^ t39;
+    sm4_bs_vec t41 = t40 ^ t37;
+    sm4_bs_vec t42 = t29 ^ t33;
+    sm4_bs_vec t43 = t29 ^ t40;
+    sm4_bs_vec t44 = t33 ^ t37;
+    sm4_bs_vec t45 = t42 ^ t41;
+    sm4_bs_vec z0 = t44 & y15;
+    sm4_bs_vec z1 = t37 & y6;
+    sm4_bs_vec z2 = t33 & x7;
+    sm4_bs_vec z3 = t43 & y16;
+    sm4_bs_vec z4 = t40 & y1;
+    sm4_bs_vec z5 = t29 & y7;
+    sm4_bs_vec z6 = t42 & y11;
+    sm4_bs_vec z7 = t45 & y17;
+    sm4_bs_vec z8 = t41 & y10;
+    sm4_bs_vec z9 = t44 & y12;
+    sm4_bs_vec z10 = t37 & y3;
+    sm4_bs_vec z11 = t33 & y4;
+    sm4_bs_vec z12 = t43 & y13;
+    sm4_bs_vec z13 = t40 & y5;
+    sm4_bs_vec z14 = t29 & y2;
+    sm4_bs_vec z15 = t42 & y9;
+    sm4_bs_vec z16 = t45 & y14;
+    sm4_bs_vec z17 = t41 & y8;
+
+    // AES 电路的底层线性层与输出仿射变换合并
+    sm4_bs_vec d0 = z0 ^ z4;
+    sm4_bs_vec d1 = z11 ^ z14;
+    sm4_bs_vec d2 = z1 ^ z9;
+    sm4_bs_vec d3 = z2 ^ z7;
+    sm4_bs_vec d4 = z3 ^ z8;
+    sm4_bs_vec d5 = z10 ^ z15;
+    sm4_bs_vec d6 = d0 ^ d3;
+    sm4_bs_vec d7 = z5 ^ z6;
+    sm4_bs_vec d8 = z9 ^ d5;
+    sm4_bs_vec d9 = z12 ^ z16;
+    sm4_bs_vec d10 = z13 ^ z17;
+    sm4_bs_vec d11 = z13 ^ d1;
+    sm4_bs_vec d12 = d4 ^ d6;
+    q[0] = ~(z16 ^ d8 ^ d12);
+    q[1] = ~(z14 ^ d8 ^ d10);
+    q[2] = z10 ^ d11 ^ d12;
+    q[3] = ~(z2 ^ z4 ^ z5 ^ z11 ^ d2 ^ d9 ^ d10);
+    q[4] = z0 ^ z6 ^ z7 ^ z12 ^ d1 ^ d2;
+    q[5] = d1 ^ d4 ^ d5 ^ d7 ^ d9;
+    q[6] = ~(z3 ^ z15 ^ z16 ^ d0 ^ d2 ^ d11);
+    q[7] = ~(d6 ^ d7);
+}
+
+/*
+ * 位矩阵转置：第 j 行为第 j 个分组的一个（64 位平台为两个相邻的）大端字。
+ * 每一级交换行号的第 x 位与位号的第 y 位（两者同时取反），y 取 x 的一个排列，
+ * 使转置后第 p 行恰为向量 X[w][i] 的第 e 个元素（p = 32k + 4i + e，k 为字偏移），载入后无需再重排。
+ * 各级作用在互不相交的位上，整个变换是自身的逆
+ */
+static inline __attribute__((always_inline)) void sm4_bs_swap_step(sm4_bs_word *a, int j, int s, sm4_bs_word m) {
+    for (int base = 0; base < SM4_BS_BLOCKS; base += 2 * j) {
+        for (int k = base; k < base + j; k++) {
+            sm4_bs_word t = (a[k] ^ (a[k + j] >> s)) & m;
+            a[k] ^= t;
+            a[k + j] ^= t << s;
+        }
+    }
+}
+
+static void sm4_bs_transpose(sm4_bs_word *a) {
+#if UINTPTR_MAX > 0xFFFFFFFFu
+    sm4_bs_swap_step(a, 32, 32, 0x00000000FFFFFFFFULL); // k <- 字
+    sm4_bs_swap_step(a, 16, 4, 0x0F0F0F0F0F0F0F0FULL);  // i <- 字节内的位
+    sm4_bs_swap_step(a, 8, 2, 0x3333333333333333ULL);
+    sm4_bs_swap_step(a, 4, 1, 0x5555555555555555ULL);
+    sm4_bs_swap_step(a, 2, 16, 0x0000FFFF0000FFFFULL);  // e <- 字节
+    sm4_bs_swap_step(a, 1, 8, 0x00FF00FF00FF00FFULL);
+#else
+    sm4_bs_swap_step(a, 16, 4, 0x0F0F0F0Fu);
+    sm4_bs_swap_step(a, 8, 2, 0x33333333u);
+    sm4_bs_swap_step(a, 4, 1, 0x55555555u);
+    sm4_bs_swap_step(a, 2, 16, 0x0000FFFFu);
+    sm4_bs_swap_step(a, 1, 8, 0x00FF00FFu);
+#endif
+}
+
+static inline uint32_t sm4_bs_load_be32(const unsigned char *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void sm4_bs_store_be32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)v;
+}
+
+// 每行装一个分组的 SM4_BS_BLOCKS / 32 个字，直接在 X 的存储上转置；不足一批时其余行补零。
+// 移 32 位拆成两次 16 位，32 位切片字上也不越界
+#define SM4_BS_WORDS_PER_ROW (SM4_BS_BLOCKS / 32)
+
+static void sm4_bs_load(sm4_bs_vec (*X)[8], const unsigned char *input, size_t nblocks) {
+    for (int w = 0; w < 4; w += SM4_BS_WORDS_PER_ROW) {
+        sm4_bs_word *a = (sm4_bs_word *)X[w];
+        for (int j = 0; j < SM4_BS_BLOCKS; j++) {
+            sm4_bs_word row = 0;
+            if ((size_t)j < nblocks) {
+                for (int k = 0; k < SM4_BS_WORDS_PER_ROW; k++) {
+                    row = (row << 16 << 16) | sm4_bs_load_be32(input + j * SM4_BLOCK_SIZE + 4 * (w + k));
+                }
+            }
+            a[j] = row;
+        }
+        sm4_bs_transpose(a);
+    }
+}
+
+// 反序变换 R：输出第 i 个字为状态的第 3 - i 个字
+static void sm4_bs_store(unsigned char *output, sm4_bs_vec (*X)[8], size_t nblocks) {
+    for (int w = 0; w < 4; w += SM4_BS_WORDS_PER_ROW) {
+        sm4_bs_word *a = (sm4_bs_word *)X[w];
+        sm4_bs_transpose(a);
+        for (size_t j = 0; j < nblocks; j++) {
+            sm4_bs_word row = a[j];
+            for (int k = SM4_BS_WORDS_PER_ROW - 1; k >= 0; k--) {
+                sm4_bs_store_be32(output + j * SM4_BLOCK_SIZE + 4 * (3 - w - k), (uint32_t)row);
+                row = row >> 16 >> 16;
+            }
+        }
+    }
+}
+
+// X0 ^= L(tau(X1 ^ X2 ^ X3 ^ rk))：轮密钥的每一位扩展为全 0 / 全 1 的切片字。
+// 切片 c = 8k + i 在 T[i] 的第 k 个元素，循环左移 n 位即取切片 c + n：
+// L(B) = B ^ (B <<< 24) ^ ((B ^ (B <<< 8) ^ (B <<< 16)) <<< 2)，跨过字节边界时多轮换一个元素
+static inline void sm4_bs_round(sm4_bs_vec *x0, const sm4_bs_vec *x1, const sm4_bs_vec *x2,
+                                const sm4_bs_vec *x3, uint32_t rk) {
+    const sm4_bs_vec one = { 1, 1, 1, 1 };
+    sm4_bs_vec key = { rk, rk, rk, rk };
+    sm4_bs_vec t[8], u[8];
+
+    for (int i = 0; i < 8; i++) {
+        sm4_bs_vec bit = (key >> (sm4_bs_vec){ 31 - i, 23 - i, 15 - i, 7 - i }) & one;
+        t[i] = x1[i] ^ x2[i] ^ x3[i] ^ -bit;
+    }
+    sm4_bs_sbox(t);
+    for (int i = 0; i < 8; i++) {
+        u[i] = t[i] ^ SM4_BS_ROT(t[i], 1) ^ SM4_BS_ROT(t[i], 2);
+    }
+    for (int i = 0; i < 6; i++) {
+        x0[i] ^= t[i] ^ SM4_BS_ROT(t[i], 3) ^ u[i + 2];
+    }
+    for (int i = 6; i < 8; i++) {
+        x0[i] ^= t[i] ^ SM4_BS_ROT(t[i], 3) ^ SM4_BS_ROT(u[i - 6], 1);
+    }
+}
+
+void sm4_bs_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                           const uint32_t encSubKeys[SM4_ROUNDS]) {
+    sm4_bs_vec X[4][8];
+
+    while (nblocks > 0) {
+        size_t n = nblocks < (size_t)SM4_BS_BLOCKS ? nblocks : (size_t)SM4_BS_BLOCKS;
+
+        sm4_bs_load(X, input, n);
+        for (int i = 0; i < SM4_ROUNDS; i += 4) {
+            sm4_bs_round(X[0], X[1], X[2], X[3], encSubKeys[i]);
+            sm4_bs_round(X[1], X[2], X[3], X[0], encSubKeys[i + 1]);
+            sm4_bs_round(X[2], X[3], X[0], X[1], encSubKeys[i + 2]);
+            sm4_bs_round(X[3], X[0], X[1], X[2], encSubKeys[i + 3]);
+        }
+        sm4_bs_store(output, X, n);
+
+        input += n * SM4_BLOCK_SIZE;
+        output += n * SM4_BLOCK_SIZE;
+        nblocks -= n;
+    }
+}
+
+void sm4_bs_encrypt_block(const unsigned char *input, const uint32_t encSubKeys[SM4_ROUNDS], unsigned char *output) {
+    sm4_bs_encrypt_blocks(input, output, 1, encSubKeys);
+}
+
+// 单个字的 tau：不做转置，只用各切片字的第 0 位，向量第 k 个元素为第 k 个字节（大端）
+static uint32_t sm4_bs_tau(uint32_t x) {
+    sm4_bs_vec q[8];
+    uint32_t r = 0;
+
+    for (int i = 0; i < 8; i++) {
+        q[i] = (sm4_bs_vec){ (x >> (31 - i)) & 1, (x >> (23 - i)) & 1, (x >> (15 - i)) & 1, (x >> (7 - i)) & 1 };
+    }
+    sm4_bs_sbox(q);
+    for (int i = 0; i < 8; i++) {
+        for (int k = 0; k < 4; k++) {
+            r |= (uint32_t)(q[i][k] & 1) << (31 - 8 * k - i);
+        }
+    }
+    return r;
+}
+
+void sm4_bs_make_enc_subkeys(const unsigned char key[SM4_KEY_SIZE], uint32_t encSubKeys[SM4_ROUNDS]) {
+    uint32_t k0 = sm4_bs_load_be32(key) ^ FK[0];
+    uint32_t k1 = sm4_bs_load_be32(key + 4) ^ FK[1];
+    uint32_t k2 = sm4_bs_load_be32(key + 8) ^ FK[2];
+    uint32_t k3 = sm4_bs_load_be32(key + 12) ^ FK[3];
+
+    // T' = L'(tau(.))，L'(B) = B ^ (B <<< 13) ^ (B <<< 23)；S 盒走同一电路，密钥编排同样不查表
+    for (int i = 0; i < SM4_ROUNDS; i++) {
+        uint32_t b = sm4_bs_tau(k1 ^ k2 ^ k3 ^ CK[i]);
+        uint32_t k = k0 ^ b ^ ((b << 13) | (b >> 19)) ^ ((b << 23) | (b >> 9));
+        encSubKeys[i] = k;
+        k0 = k1;
+        k1 = k2;
+        k2 = k3;
+        k3 = k;
+    }
+}
@@ -0,0 +1,232 @@
+#include "../inc/sm4_mode.h"
+#include <string.h>
+
+static inline void sm4_xor_block(unsigned char *out, const unsigned char *a, const unsigned char *b) {
+    for (int i = 0; i < SM4_BLOCK_SIZE; i++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+// 128 位大端计数器加一
+static inline void sm4_ctr_increment(unsigned char counter[SM4_BLOCK_SIZE]) {
+    for (int i = SM4_BLOCK_SIZE - 1; i >= 0; i--) {
+        if (++counter[i] != 0) {
+            break;
+        }
+    }
+}
+
+int sm4_mode_init(sm4_mode_ctx *ctx, sm4_mode mode, const unsigned char key[SM4_KEY_SIZE],
+                  const unsigned char iv[SM4_BLOCK_SIZE], int decrypt) {
+    if (mode < SM4_MODE_ECB || mode > SM4_MODE_OFB || (mode != SM4_MODE_ECB && iv == NULL)) {
+        return 1;
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->mode = mode;
+    ctx->decrypt = decrypt ? 1 : 0;
+    // 只有 ECB / CBC 解密用到解密方向，其余模式都只加密
+    if (ctx->decrypt && (mode == SM4_MODE_ECB || mode == SM4_MODE_CBC)) {
+        sm4_make_dec_subkeys(key, ctx->rk);
+    } else {
+        sm4_make_enc_subkeys(key, ctx->rk);
+    }
+    if (iv != NULL) {
+        memcpy(ctx->iv, iv, SM4_BLOCK_SIZE);
+    }
+    return 0;
+}
+
+static void sm4_cbc_encrypt_update(sm4_mode_ctx *ctx, const unsigned char *input, unsigned char *output, size_t nblocks) {
+    unsigned char block[SM4_BLOCK_SIZE];
+
+    // 加密方向是串行链，逐块处理
+    for (size_t i = 0; i < nblocks; i++) {
+        sm4_xor_block(block, input + i * SM4_BLOCK_SIZE, ctx->iv);
+        sm4_encrypt_block(block, ctx->rk, ctx->iv);
+        memcpy(output + i * SM4_BLOCK_SIZE, ctx->iv, SM4_BLOCK_SIZE);
+    }
+}
+
+static void sm4_cbc_decrypt_update(sm4_mode_ctx *ctx, const unsigned char *input, unsigned char *output, size_t nblocks) {
+    unsigned char plain[SM4_MODE_BATCH * SM4_BLOCK_SIZE];
+    unsigned char last[SM4_BLOCK_SIZE];
+
+    // 解密方向可并行：先成批解密，再与前一个密文分组异或
+    while (nblocks > 0) {
+        size_t n = nblocks < SM4_MODE_BATCH ? nblocks : SM4_MODE_BATCH;
+
+        sm4_decrypt_blocks(input, plain, n, ctx->rk);
+        memcpy(last, input + (n - 1) * SM4_BLOCK_SIZE, SM4_BLOCK_SIZE);
+        // 从后往前写，原地解密时前一个密文分组仍未被覆盖
+        for (size_t i = n - 1; i > 0; i--) {
+            sm4_xor_block(output + i * SM4_BLOCK_SIZE, plain + i * SM4_BLOCK_SIZE, input + (i - 1) * SM4_BLOCK_SIZE);
+        }
+        sm4_xor_block(output, plain, ctx->iv);
+        memcpy(ctx->iv, last, SM4_BLOCK_SIZE);
+
+        input += n * SM4_BLOCK_SIZE;
+        output += n * SM4_BLOCK_SIZE;
+        nblocks -= n;
+    }
+}
+
+static void sm4_ctr_update(sm4_mode_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len) {
+    unsigned char stream[SM4_MODE_BATCH * SM4_BLOCK_SIZE];
+
+    // 先用完上次剩下的密钥流
+    while (ctx->num != 0 && len > 0) {
+        *output++ = *input++ ^ ctx->ks[ctx->num];
+        ctx->num = (ctx->num + 1) % SM4_BLOCK_SIZE;
+        len--;
+    }
+
+    // 整块部分：一次生成一批计数器分组
+    while (len >= SM4_BLOCK_SIZE) {
+        size_t n = len / SM4_BLOCK_SIZE < SM4_MODE_BATCH ? len / SM4_BLOCK_SIZE : SM4_MODE_BATCH;
+
+        for (size_t i = 0; i < n; i++) {
+            memcpy(stream + i * SM4_BLOCK_SIZE, ctx->iv, SM4_BLOCK_SIZE);
+            sm4_ctr_increment(ctx->iv);
+        }
+        sm4_encrypt_blocks(stream, stream, n, ctx->rk);
+        for (size_t i = 0; i < n * SM4_BLOCK_SIZE; i++) {
+            output[i] = input[i] ^ stream[i];
+        }
+
+        input += n * SM4_BLOCK_SIZE;
+        output += n * SM4_BLOCK_SIZE;
+        len -= n * SM4_BLOCK_SIZE;
+    }
+
+    if (len > 0) {
+        sm4_encrypt_block(ctx->iv, ctx->rk, ctx->ks);
+        sm4_ctr_increment(ctx->iv);
+        for (size_t i = 0; i < len; i++) {
+            output[i] = input[i] ^ ctx->ks[i];
+        }
+        ctx->num = len;
+    }
+}
+
+// 逐字节：num 为 0 时加密反馈寄存器，之后 iv 中逐字节换成密文
+static void sm4_cfb_bytes(sm4_mode_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (ctx->num == 0) {
+            sm4_encrypt_block(ctx->iv, ctx->rk, ctx->iv);
+        }
+        unsigned char c = ctx->decrypt ? input[i] : (unsigned char)(input[i] ^ ctx->iv[ctx->num]);
+        output[i] = input[i] ^ ctx->iv[ctx->num];
+        ctx->iv[ctx->num] = c;
+        ctx->num = (ctx->num + 1) % SM4_BLOCK_SIZE;
+    }
+}
+
+static void sm4_cfb_update(sm4_mode_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len) {
+    unsigned char stream[SM4_MODE_BATCH * SM4_BLOCK_SIZE];
+    size_t head = ctx->num != 0 ? SM4_BLOCK_SIZE - ctx->num : 0;
+
+    // 先补齐上次剩下的不完整分组，之后就位于分组边界
+    if (head > len) {
+        head = len;
+    }
+    sm4_cfb_bytes(ctx, input, output, head);
+    input += head;
+    output += head;
+    len -= head;
+
+    // 解密时各分组的密钥流只依赖已知密文，可成批计算：E(IV), E(C0), E(C1), ...
+    if (ctx->decrypt) {
+        while (len >= SM4_BLOCK_SIZE) {
+            size_t n = len / SM4_BLOCK_SIZE < SM4_MODE_BATCH ? len / SM4_BLOCK_SIZE : SM4_MODE_BATCH;
+
+            memcpy(stream, ctx->iv, SM4_BLOCK_SIZE);
+            memcpy(stream + SM4_BLOCK_SIZE, input, (n - 1) * SM4_BLOCK_SIZE);
+            memcpy(ctx->iv, input + (n - 1) * SM4_BLOCK_SIZE, SM4_BLOCK_SIZE);
+            sm4_encrypt_blocks(stream, stream, n, ctx->rk);
+            for (size_t i = 0; i < n * SM4_BLOCK_SIZE; i++) {
+                output[i] = input[i] ^ stream[i];
+            }
+
+            input += n * SM4_BLOCK_SIZE;
+            output += n * SM4_BLOCK_SIZE;
+            len -= n * SM4_BLOCK_SIZE;
+        }
+    }
+
+    sm4_cfb_bytes(ctx, input, output, len);
+}
+
+static void sm4_ofb_update(sm4_mode_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len) {
+    // 输出反馈与数据无关但前后相依，只能串行
+    for (size_t i = 0; i < len; i++) {
+        if (ctx->num == 0) {
+            sm4_encrypt_block(ctx->iv, ctx->rk, ctx->iv);
+        }
+        output[i] = input[i] ^ ctx->iv[ctx->num];
+        ctx->num = (ctx->num + 1) % SM4_BLOCK_SIZE;
+    }
+}
+
+int sm4_mode_update(sm4_mode_ctx *ctx, const unsigned char *input, unsigned char *output, size_t len) {
+    switch (ctx->mode) {
+    case SM4_MODE_ECB:
+        if (len % SM4_BLOCK_SIZE != 0) {
+            return 1;
+        }
+        sm4_encrypt_blocks(input, output, len / SM4_BLOCK_SIZE, ctx->rk);
+        return 0;
+    case SM4_MODE_CBC:
+        if (len % SM4_BLOCK_SIZE != 0) {
+            return 1;
+        }
+        if (ctx->decrypt) {
+            sm4_cbc_decrypt_update(ctx, input, output, len / SM4_BLOCK_SIZE);
+        } else {
+            sm4_cbc_encrypt_update(ctx, input, output, len / SM4_BLOCK_SIZE);
+        }
+        return 0;
+    case SM4_MODE_CTR:
+        sm4_ctr_update(ctx, input, output, len);
+        return 0;
+    case SM4_MODE_CFB:
+        sm4_cfb_update(ctx, input, output, len);
+        return 0;
+    case SM4_MODE_OFB:
+        sm4_ofb_update(ctx, input, output, len);
+        return 0;
+    }
+    return 1;
+}
+
+int sm4_mode_final(sm4_mode_ctx *ctx) {
+    // 不留下轮密钥与链接状态
+    memset(ctx, 0, sizeof(*ctx));
+    return 0;
+}
+
+int sm4_encrypt_cbc(const unsigned char *plaintext, size_t length, const unsigned char key[SM4_KEY_SIZE],
+                    const unsigned char iv[SM4_BLOCK_SIZE], unsigned char *ciphertext) {
+    sm4_mode_ctx ctx;
+    int ret;
+
+    if (length % SM4_BLOCK_SIZE != 0 || sm4_mode_init(&ctx, SM4_MODE_CBC, key, iv, 0) != 0) {
+        return 1;
+    }
+    ret = sm4_mode_update(&ctx, plaintext, ciphertext, length);
+    sm4_mode_final(&ctx);
+    return ret;
+}
+
+int sm4_decrypt_cbc(const unsigned char *ciphertext, size_t length, const unsigned char key[SM4_KEY_SIZE],
+                    const unsigned char iv[SM4_BLOCK_SIZE], unsigned char *plaintext) {
+    sm4_mode_ctx ctx;
+    int ret;
+
+    if (length % SM4_BLOCK_SIZE != 0 || sm4_mode_init(&ctx, SM4_MODE_CBC, key, iv, 1) != 0) {
+        return 1;
+    }
+    ret = sm4_mode_update(&ctx, ciphertext, plaintext, length);
+    sm4_mode_final(&ctx);
+    return ret;
+}
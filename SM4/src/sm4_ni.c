@@ -0,0 +1,387 @@
+#include "../inc/sm4_ni.h"
+#include <immintrin.h>
+#include <string.h>
+
+// 仅这些函数使用 SIMD 指令，其余代码不依赖编译选项；是否调用由 CPUID 检测决定
+#define SM4_NI_TARGET __attribute__((target("aes,ssse3")))
+#define SM4_NI_AVX2_TARGET __attribute__((target("aes,avx2")))
+#define SM4_NI_AVX512_TARGET __attribute__((target("aes,vaes,avx512f,avx512bw")))
+#define SM4_NI_INLINE static inline __attribute__((always_inline))
+
+// SM4 S 盒与 AES S 盒仿射等价：S_sm4(x) = A2 * S_aes(A1 * x + c1) + c2。
+// 两个仿射变换按高低半字节拆成两次 PSHUFB 查表；AESENCLAST 的轮密钥取 0x0f 掩码以省一个寄存器，
+// 其异或已并入 SM4_NI_POST_LO（下标低 4 位取反）
+static const unsigned char SM4_NI_PRE_LO[16] __attribute__((aligned(16))) = {
+    0x3e, 0xb2, 0x0e, 0x82, 0xbb, 0x37, 0x8b, 0x07,
+    0xa1, 0x2d, 0x91, 0x1d, 0x24, 0xa8, 0x14, 0x98};
+static const unsigned char SM4_NI_PRE_HI[16] __attribute__((aligned(16))) = {
+    0x00, 0xdc, 0x2e, 0xf2, 0xc5, 0x19, 0xeb, 0x37,
+    0x08, 0xd4, 0x26, 0xfa, 0xcd, 0x11, 0xe3, 0x3f};
+static const unsigned char SM4_NI_POST_LO[16] __attribute__((aligned(16))) = {
+    0x47, 0xff, 0x8d, 0x35, 0x79, 0xc1, 0xb3, 0x0b,
+    0x20, 0x98, 0xea, 0x52, 0x1e, 0xa6, 0xd4, 0x6c};
+static const unsigned char SM4_NI_POST_HI[16] __attribute__((aligned(16))) = {
+    0x00, 0xe0, 0x50, 0xb0, 0x9d, 0x7d, 0xcd, 0x2d,
+    0xc0, 0x20, 0x90, 0x70, 0x5d, 0xbd, 0x0d, 0xed};
+
+// AESENCLAST 先做行移位，S 盒之后按逆行移位取回字节，同时完成 L 所需的循环左移 0 / 8 / 16 / 24 位
+static const unsigned char SM4_NI_ROL0[16] __attribute__((aligned(16))) = {
+    0x00, 0x0d, 0x0a, 0x07, 0x04, 0x01, 0x0e, 0x0b, 0x08, 0x05, 0x02, 0x0f, 0x0c, 0x09, 0x06, 0x03};
+static const unsigned char SM4_NI_ROL8[16] __attribute__((aligned(16))) = {
+    0x07, 0x00, 0x0d, 0x0a, 0x0b, 0x04, 0x01, 0x0e, 0x0f, 0x08, 0x05, 0x02, 0x03, 0x0c, 0x09, 0x06};
+static const unsigned char SM4_NI_ROL16[16] __attribute__((aligned(16))) = {
+    0x0a, 0x07, 0x00, 0x0d, 0x0e, 0x0b, 0x04, 0x01, 0x02, 0x0f, 0x08, 0x05, 0x06, 0x03, 0x0c, 0x09};
+static const unsigned char SM4_NI_ROL24[16] __attribute__((aligned(16))) = {
+    0x0d, 0x0a, 0x07, 0x00, 0x01, 0x0e, 0x0b, 0x04, 0x05, 0x02, 0x0f, 0x08, 0x09, 0x06, 0x03, 0x0c};
+
+// 大端字 <-> 小端字
+static const unsigned char SM4_NI_BSWAP32[16] __attribute__((aligned(16))) = {
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+
+#define SM4_NI_CONST(T) _mm_load_si128((const __m128i *)(T))
+
+// 4x4 的 32 位转置：4 个分组 <-> 每个寄存器存 4 个分组的同一个字，对 256 / 512 位寄存器按 128 位通道进行
+#define SM4_NI_TRANSPOSE(V, P, R0, R1, R2, R3) {                                  \
+    V t0_ = P##_unpacklo_epi32(R0, R1), t1_ = P##_unpackhi_epi32(R0, R1);       \
+    V t2_ = P##_unpacklo_epi32(R2, R3), t3_ = P##_unpackhi_epi32(R2, R3);       \
+    R0 = P##_unpacklo_epi64(t0_, t2_);                                          \
+    R1 = P##_unpackhi_epi64(t0_, t2_);                                          \
+    R2 = P##_unpacklo_epi64(t1_, t3_);                                          \
+    R3 = P##_unpackhi_epi64(t1_, t3_); }
+
+// ---------------------------------------------------------------- SSE：每个寄存器 4 个分组
+
+// 非线性变换 tau，结果各字节仍处在 AESENCLAST 行移位后的位置
+SM4_NI_INLINE SM4_NI_TARGET __m128i sm4_ni_sbox_128(__m128i x) {
+    const __m128i mask = _mm_set1_epi32(0x0f0f0f0f);
+    __m128i lo = _mm_and_si128(x, mask);
+    __m128i hi = _mm_and_si128(_mm_srli_epi32(x, 4), mask);
+    x = _mm_xor_si128(_mm_shuffle_epi8(SM4_NI_CONST(SM4_NI_PRE_LO), lo),
+                      _mm_shuffle_epi8(SM4_NI_CONST(SM4_NI_PRE_HI), hi));
+    x = _mm_aesenclast_si128(x, mask);
+    lo = _mm_and_si128(x, mask);
+    hi = _mm_and_si128(_mm_srli_epi32(x, 4), mask);
+    return _mm_xor_si128(_mm_shuffle_epi8(SM4_NI_CONST(SM4_NI_POST_LO), lo),
+                         _mm_shuffle_epi8(SM4_NI_CONST(SM4_NI_POST_HI), hi));
+}
+
+// 合成置换 T = L(tau(x))：L(B) = B ^ (B <<< 24) ^ ((B ^ (B <<< 8) ^ (B <<< 16)) <<< 2)
+SM4_NI_INLINE SM4_NI_TARGET __m128i sm4_ni_t_128(__m128i x) {
+    x = sm4_ni_sbox_128(x);
+
+    __m128i r0 = _mm_shuffle_epi8(x, SM4_NI_CONST(SM4_NI_ROL0));
+    __m128i t = _mm_xor_si128(_mm_xor_si128(r0, _mm_shuffle_epi8(x, SM4_NI_CONST(SM4_NI_ROL8))),
+                              _mm_shuffle_epi8(x, SM4_NI_CONST(SM4_NI_ROL16)));
+    r0 = _mm_xor_si128(r0, _mm_shuffle_epi8(x, SM4_NI_CONST(SM4_NI_ROL24)));
+    return _mm_xor_si128(r0, _mm_xor_si128(_mm_slli_epi32(t, 2), _mm_srli_epi32(t, 30)));
+}
+
+#define SM4_NI_ROUND_128(X0, X1, X2, X3, K) \
+    X0 = _mm_xor_si128(X0, sm4_ni_t_128(_mm_xor_si128(_mm_xor_si128(X1, X2), _mm_xor_si128(X3, K))))
+
+SM4_NI_INLINE SM4_NI_TARGET void sm4_ni_load_128(const unsigned char *input, __m128i x[4]) {
+    const __m128i bswap = SM4_NI_CONST(SM4_NI_BSWAP32);
+    for (int i = 0; i < 4; i++) {
+        x[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(input + 16 * i)), bswap);
+    }
+    SM4_NI_TRANSPOSE(__m128i, _mm, x[0], x[1], x[2], x[3]);
+}
+
+// 反序变换 R 与逆转置合并
+SM4_NI_INLINE SM4_NI_TARGET void sm4_ni_store_128(unsigned char *output, __m128i x[4]) {
+    const __m128i bswap = SM4_NI_CONST(SM4_NI_BSWAP32);
+    SM4_NI_TRANSPOSE(__m128i, _mm, x[3], x[2], x[1], x[0]);
+    for (int i = 0; i < 4; i++) {
+        _mm_storeu_si128((__m128i *)(output + 16 * i), _mm_shuffle_epi8(x[3 - i], bswap));
+    }
+}
+
+static SM4_NI_TARGET void sm4_ni_encrypt4(const unsigned char *input, unsigned char *output,
+                                          const uint32_t rk[SM4_ROUNDS]) {
+    __m128i a[4];
+
+    sm4_ni_load_128(input, a);
+    for (int i = 0; i < SM4_ROUNDS; i += 4) {
+        SM4_NI_ROUND_128(a[0], a[1], a[2], a[3], _mm_set1_epi32(rk[i]));
+        SM4_NI_ROUND_128(a[1], a[2], a[3], a[0], _mm_set1_epi32(rk[i + 1]));
+        SM4_NI_ROUND_128(a[2], a[3], a[0], a[1], _mm_set1_epi32(rk[i + 2]));
+        SM4_NI_ROUND_128(a[3], a[0], a[1], a[2], _mm_set1_epi32(rk[i + 3]));
+    }
+    sm4_ni_store_128(output, a);
+}
+
+// 密钥扩展 T' = L'(tau(x))：S 盒同样由 AESENCLAST 与仿射变换完成，不查内存中的表；
+// 4 个通道放同一个字，ROL0 只用来取回行移位前的字节位置。L'(B) = B ^ (B <<< 13) ^ (B <<< 23)
+SM4_NI_TARGET void sm4_ni_make_enc_subkeys(const unsigned char key[SM4_KEY_SIZE], uint32_t encSubKeys[SM4_ROUNDS]) {
+    uint32_t k[4];
+
+    for (int i = 0; i < 4; i++) {
+        k[i] = (((uint32_t)key[4 * i] << 24) | ((uint32_t)key[4 * i + 1] << 16) |
+                ((uint32_t)key[4 * i + 2] << 8) | (uint32_t)key[4 * i + 3]) ^ FK[i];
+    }
+    for (int i = 0; i < SM4_ROUNDS; i++) {
+        __m128i x = sm4_ni_sbox_128(_mm_set1_epi32((int)(k[(i + 1) & 3] ^ k[(i + 2) & 3] ^ k[(i + 3) & 3] ^ CK[i])));
+        uint32_t b = (uint32_t)_mm_cvtsi128_si32(_mm_shuffle_epi8(x, SM4_NI_CONST(SM4_NI_ROL0)));
+        k[i & 3] ^= b ^ ((b << 13) | (b >> 19)) ^ ((b << 23) | (b >> 9));
+        encSubKeys[i] = k[i & 3];
+    }
+}
+
+// 两组寄存器交错，隐藏 AESENCLAST 与 PSHUFB 的延迟
+static SM4_NI_TARGET void sm4_ni_encrypt8(const unsigned char *input, unsigned char *output,
+                                          const uint32_t rk[SM4_ROUNDS]) {
+    __m128i a[4], b[4];
+
+    sm4_ni_load_128(input, a);
+    sm4_ni_load_128(input + 4 * SM4_BLOCK_SIZE, b);
+    for (int i = 0; i < SM4_ROUNDS; i += 4) {
+        __m128i k0 = _mm_set1_epi32(rk[i]), k1 = _mm_set1_epi32(rk[i + 1]);
+        __m128i k2 = _mm_set1_epi32(rk[i + 2]), k3 = _mm_set1_epi32(rk[i + 3]);
+        SM4_NI_ROUND_128(a[0], a[1], a[2], a[3], k0);
+        SM4_NI_ROUND_128(b[0], b[1], b[2], b[3], k0);
+        SM4_NI_ROUND_128(a[1], a[2], a[3], a[0], k1);
+        SM4_NI_ROUND_128(b[1], b[2], b[3], b[0], k1);
+        SM4_NI_ROUND_128(a[2], a[3], a[0], a[1], k2);
+        SM4_NI_ROUND_128(b[2], b[3], b[0], b[1], k2);
+        SM4_NI_ROUND_128(a[3], a[0], a[1], a[2], k3);
+        SM4_NI_ROUND_128(b[3], b[0], b[1], b[2], k3);
+    }
+    sm4_ni_store_128(output, a);
+    sm4_ni_store_128(output + 4 * SM4_BLOCK_SIZE, b);
+}
+
+// ---------------------------------------------------------------- AVX2：每个寄存器 8 个分组
+
+#define SM4_NI_CONST_256(T) _mm256_broadcastsi128_si256(SM4_NI_CONST(T))
+
+SM4_NI_INLINE SM4_NI_AVX2_TARGET __m256i sm4_ni_t_256(__m256i x) {
+    const __m256i mask = _mm256_set1_epi32(0x0f0f0f0f);
+    __m256i lo = _mm256_and_si256(x, mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi32(x, 4), mask);
+    x = _mm256_xor_si256(_mm256_shuffle_epi8(SM4_NI_CONST_256(SM4_NI_PRE_LO), lo),
+                         _mm256_shuffle_epi8(SM4_NI_CONST_256(SM4_NI_PRE_HI), hi));
+    // 无 VAES 时 AESENCLAST 只能处理 128 位，两个通道分别计算
+    __m128i x0 = _mm_aesenclast_si128(_mm256_castsi256_si128(x), _mm256_castsi256_si128(mask));
+    __m128i x1 = _mm_aesenclast_si128(_mm256_extracti128_si256(x, 1), _mm256_castsi256_si128(mask));
+    x = _mm256_inserti128_si256(_mm256_castsi128_si256(x0), x1, 1);
+    lo = _mm256_and_si256(x, mask);
+    hi = _mm256_and_si256(_mm256_srli_epi32(x, 4), mask);
+    x = _mm256_xor_si256(_mm256_shuffle_epi8(SM4_NI_CONST_256(SM4_NI_POST_LO), lo),
+                         _mm256_shuffle_epi8(SM4_NI_CONST_256(SM4_NI_POST_HI), hi));
+
+    __m256i r0 = _mm256_shuffle_epi8(x, SM4_NI_CONST_256(SM4_NI_ROL0));
+    __m256i t = _mm256_xor_si256(_mm256_xor_si256(r0, _mm256_shuffle_epi8(x, SM4_NI_CONST_256(SM4_NI_ROL8))),
+                                 _mm256_shuffle_epi8(x, SM4_NI_CONST_256(SM4_NI_ROL16)));
+    r0 = _mm256_xor_si256(r0, _mm256_shuffle_epi8(x, SM4_NI_CONST_256(SM4_NI_ROL24)));
+    return _mm256_xor_si256(r0, _mm256_xor_si256(_mm256_slli_epi32(t, 2), _mm256_srli_epi32(t, 30)));
+}
+
+#define SM4_NI_ROUND_256(X0, X1, X2, X3, K) \
+    X0 = _mm256_xor_si256(X0, sm4_ni_t_256(_mm256_xor_si256(_mm256_xor_si256(X1, X2), _mm256_xor_si256(X3, K))))
+
+// 每个 256 位载入含 2 个分组，转置后低通道为偶数号分组、高通道为奇数号分组，逆转置后按原顺序写回
+SM4_NI_INLINE SM4_NI_AVX2_TARGET void sm4_ni_load_256(const unsigned char *input, __m256i x[4]) {
+    const __m256i bswap = SM4_NI_CONST_256(SM4_NI_BSWAP32);
+    for (int i = 0; i < 4; i++) {
+        x[i] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(input + 32 * i)), bswap);
+    }
+    SM4_NI_TRANSPOSE(__m256i, _mm256, x[0], x[1], x[2], x[3]);
+}
+
+SM4_NI_INLINE SM4_NI_AVX2_TARGET void sm4_ni_store_256(unsigned char *output, __m256i x[4]) {
+    const __m256i bswap = SM4_NI_CONST_256(SM4_NI_BSWAP32);
+    SM4_NI_TRANSPOSE(__m256i, _mm256, x[3], x[2], x[1], x[0]);
+    for (int i = 0; i < 4; i++) {
+        _mm256_storeu_si256((__m256i *)(output + 32 * i), _mm256_shuffle_epi8(x[3 - i], bswap));
+    }
+}
+
+static SM4_NI_AVX2_TARGET void sm4_ni_encrypt16_avx2(const unsigned char *input, unsigned char *output,
+                                                     const uint32_t rk[SM4_ROUNDS]) {
+    __m256i a[4], b[4];
+
+    sm4_ni_load_256(input, a);
+    sm4_ni_load_256(input + 8 * SM4_BLOCK_SIZE, b);
+    for (int i = 0; i < SM4_ROUNDS; i += 4) {
+        __m256i k0 = _mm256_set1_epi32(rk[i]), k1 = _mm256_set1_epi32(rk[i + 1]);
+        __m256i k2 = _mm256_set1_epi32(rk[i + 2]), k3 = _mm256_set1_epi32(rk[i + 3]);
+        SM4_NI_ROUND_256(a[0], a[1], a[2], a[3], k0);
+        SM4_NI_ROUND_256(b[0], b[1], b[2], b[3], k0);
+        SM4_NI_ROUND_256(a[1], a[2], a[3], a[0], k1);
+        SM4_NI_ROUND_256(b[1], b[2], b[3], b[0], k1);
+        SM4_NI_ROUND_256(a[2], a[3], a[0], a[1], k2);
+        SM4_NI_ROUND_256(b[2], b[3], b[0], b[1], k2);
+        SM4_NI_ROUND_256(a[3], a[0], a[1], a[2], k3);
+        SM4_NI_ROUND_256(b[3], b[0], b[1], b[2], k3);
+    }
+    sm4_ni_store_256(output, a);
+    sm4_ni_store_256(output + 8 * SM4_BLOCK_SIZE, b);
+}
+
+// ---------------------------------------------------------------- AVX-512 + VAES：每个寄存器 16 个分组
+
+#define SM4_NI_CONST_512(T) _mm512_broadcast_i32x4(SM4_NI_CONST(T))
+#define SM4_NI_XOR3_512(A, B, C) _mm512_ternarylogic_epi32(A, B, C, 0x96)
+
+SM4_NI_INLINE SM4_NI_AVX512_TARGET __m512i sm4_ni_t_512(__m512i x) {
+    const __m512i mask = _mm512_set1_epi32(0x0f0f0f0f);
+    __m512i lo = _mm512_and_si512(x, mask);
+    __m512i hi = _mm512_and_si512(_mm512_srli_epi32(x, 4), mask);
+    x = _mm512_xor_si512(_mm512_shuffle_epi8(SM4_NI_CONST_512(SM4_NI_PRE_LO), lo),
+                         _mm512_shuffle_epi8(SM4_NI_CONST_512(SM4_NI_PRE_HI), hi));
+    x = _mm512_aesenclast_epi128(x, mask);
+    lo = _mm512_and_si512(x, mask);
+    hi = _mm512_and_si512(_mm512_srli_epi32(x, 4), mask);
+    x = _mm512_xor_si512(_mm512_shuffle_epi8(SM4_NI_CONST_512(SM4_NI_POST_LO), lo),
+                         _mm512_shuffle_epi8(SM4_NI_CONST_512(SM4_NI_POST_HI), hi));
+
+    __m512i r0 = _mm512_shuffle_epi8(x, SM4_NI_CONST_512(SM4_NI_ROL0));
+    __m512i t = SM4_NI_XOR3_512(r0, _mm512_shuffle_epi8(x, SM4_NI_CONST_512(SM4_NI_ROL8)),
+                                _mm512_shuffle_epi8(x, SM4_NI_CONST_512(SM4_NI_ROL16)));
+    r0 = _mm512_xor_si512(r0, _mm512_shuffle_epi8(x, SM4_NI_CONST_512(SM4_NI_ROL24)));
+    return _mm512_xor_si512(r0, _mm512_rol_epi32(t, 2));
+}
+
+#define SM4_NI_ROUND_512(X0, X1, X2, X3, K) \
+    X0 = _mm512_xor_si512(X0, sm4_ni_t_512(_mm512_xor_si512(SM4_NI_XOR3_512(X1, X2, X3), K)))
+
+SM4_NI_INLINE SM4_NI_AVX512_TARGET void sm4_ni_load_512(const unsigned char *input, __m512i x[4]) {
+    const __m512i bswap = SM4_NI_CONST_512(SM4_NI_BSWAP32);
+    for (int i = 0; i < 4; i++) {
+        x[i] = _mm512_shuffle_epi8(_mm512_loadu_si512((const void *)(input + 64 * i)), bswap);
+    }
+    SM4_NI_TRANSPOSE(__m512i, _mm512, x[0], x[1], x[2], x[3]);
+}
+
+SM4_NI_INLINE SM4_NI_AVX512_TARGET void sm4_ni_store_512(unsigned char *output, __m512i x[4]) {
+    const __m512i bswap = SM4_NI_CONST_512(SM4_NI_BSWAP32);
+    SM4_NI_TRANSPOSE(__m512i, _mm512, x[3], x[2], x[1], x[0]);
+    for (int i = 0; i < 4; i++) {
+        _mm512_storeu_si512((void *)(output + 64 * i), _mm512_shuffle_epi8(x[3 - i], bswap));
+    }
+}
+
+static SM4_NI_AVX512_TARGET void sm4_ni_encrypt32_avx512(const unsigned char *input, unsigned char *output,
+                                                         const uint32_t rk[SM4_ROUNDS]) {
+    __m512i a[4], b[4];
+
+    sm4_ni_load_512(input, a);
+    sm4_ni_load_512(input + 16 * SM4_BLOCK_SIZE, b);
+    for (int i = 0; i < SM4_ROUNDS; i += 4) {
+        __m512i k0 = _mm512_set1_epi32(rk[i]), k1 = _mm512_set1_epi32(rk[i + 1]);
+        __m512i k2 = _mm512_set1_epi32(rk[i + 2]), k3 = _mm512_set1_epi32(rk[i + 3]);
+        SM4_NI_ROUND_512(a[0], a[1], a[2], a[3], k0);
+        SM4_NI_ROUND_512(b[0], b[1], b[2], b[3], k0);
+        SM4_NI_ROUND_512(a[1], a[2], a[3], a[0], k1);
+        SM4_NI_ROUND_512(b[1], b[2], b[3], b[0], k1);
+        SM4_NI_ROUND_512(a[2], a[3], a[0], a[1], k2);
+        SM4_NI_ROUND_512(b[2], b[3], b[0], b[1], k2);
+        SM4_NI_ROUND_512(a[3], a[0], a[1], a[2], k3);
+        SM4_NI_ROUND_512(b[3], b[0], b[1], b[2], k3);
+    }
+    sm4_ni_store_512(output, a);
+    sm4_ni_store_512(output + 16 * SM4_BLOCK_SIZE, b);
+}
+
+// ---------------------------------------------------------------- 调度
+
+typedef enum {
+    SM4_NI_LEVEL_UNKNOWN,
+    SM4_NI_LEVEL_SSE,
+    SM4_NI_LEVEL_AVX2,
+    SM4_NI_LEVEL_AVX512
+} sm4_ni_level;
+
+static sm4_ni_level sm4_ni_detected = SM4_NI_LEVEL_UNKNOWN;
+
+// 首次调用可能同时来自多个线程：各线程检测结果相同，原子读写即可，重复检测无妨
+static sm4_ni_level sm4_ni_get_level(void) {
+    sm4_ni_level level = __atomic_load_n(&sm4_ni_detected, __ATOMIC_RELAXED);
+    if (level == SM4_NI_LEVEL_UNKNOWN) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+            __builtin_cpu_supports("vaes")) {
+            level = SM4_NI_LEVEL_AVX512;
+        } else if (__builtin_cpu_supports("avx2")) {
+            level = SM4_NI_LEVEL_AVX2;
+        } else {
+            level = SM4_NI_LEVEL_SSE;
+        }
+        __atomic_store_n(&sm4_ni_detected, level, __ATOMIC_RELAXED);
+    }
+    return level;
+}
+
+const char *sm4_ni_kernel_name(void) {
+    switch (sm4_ni_get_level()) {
+    case SM4_NI_LEVEL_AVX512:
+        return "AVX-512 VAES";
+    case SM4_NI_LEVEL_AVX2:
+        return "AVX2";
+    default:
+        return "SSE";
+    }
+}
+
+// 不足 4 个分组时补齐到一个寄存器
+static void sm4_ni_encrypt_tail(const unsigned char *input, unsigned char *output, size_t nblocks,
+                                const uint32_t rk[SM4_ROUNDS]) {
+    unsigned char buf[4 * SM4_BLOCK_SIZE] = {0};
+
+    memcpy(buf, input, nblocks * SM4_BLOCK_SIZE);
+    sm4_ni_encrypt4(buf, buf, rk);
+    memcpy(output, buf, nblocks * SM4_BLOCK_SIZE);
+}
+
+// 单个分组无需转置：每个字广播到 4 个 32 位通道，只取通道 0 写回
+SM4_NI_TARGET
+void sm4_ni_encrypt_block(const unsigned char *input, const uint32_t encSubKeys[SM4_ROUNDS], unsigned char *output) {
+    const __m128i bswap = SM4_NI_CONST(SM4_NI_BSWAP32);
+    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)input), bswap);
+    __m128i a0 = _mm_shuffle_epi32(b, 0x00), a1 = _mm_shuffle_epi32(b, 0x55);
+    __m128i a2 = _mm_shuffle_epi32(b, 0xAA), a3 = _mm_shuffle_epi32(b, 0xFF);
+
+    for (int i = 0; i < SM4_ROUNDS; i += 4) {
+        SM4_NI_ROUND_128(a0, a1, a2, a3, _mm_set1_epi32(encSubKeys[i]));
+        SM4_NI_ROUND_128(a1, a2, a3, a0, _mm_set1_epi32(encSubKeys[i + 1]));
+        SM4_NI_ROUND_128(a2, a3, a0, a1, _mm_set1_epi32(encSubKeys[i + 2]));
+        SM4_NI_ROUND_128(a3, a0, a1, a2, _mm_set1_epi32(encSubKeys[i + 3]));
+    }
+    b = _mm_unpacklo_epi64(_mm_unpacklo_epi32(a3, a2), _mm_unpacklo_epi32(a1, a0));
+    _mm_storeu_si128((__m128i *)output, _mm_shuffle_epi8(b, bswap));
+}
+
+void sm4_ni_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                           const uint32_t encSubKeys[SM4_ROUNDS]) {
+    sm4_ni_level level = sm4_ni_get_level();
+
+    // 由宽到窄依次处理，尾部交给更窄的内核
+    if (level == SM4_NI_LEVEL_AVX512) {
+        for (; nblocks >= 32; nblocks -= 32) {
+            sm4_ni_encrypt32_avx512(input, output, encSubKeys);
+            input += 32 * SM4_BLOCK_SIZE;
+            output += 32 * SM4_BLOCK_SIZE;
+        }
+    }
+    if (level >= SM4_NI_LEVEL_AVX2) {
+        for (; nblocks >= 16; nblocks -= 16) {
+            sm4_ni_encrypt16_avx2(input, output, encSubKeys);
+            input += 16 * SM4_BLOCK_SIZE;
+            output += 16 * SM4_BLOCK_SIZE;
+        }
+    }
+    for (; nblocks >= 8; nblocks -= 8) {
+        sm4_ni_encrypt8(input, output, encSubKeys);
+        input += 8 * SM4_BLOCK_SIZE;
+        output += 8 * SM4_BLOCK_SIZE;
+    }
+    if (nblocks >= 4) {
+        sm4_ni_encrypt4(input, output, encSubKeys);
+        input += 4 * SM4_BLOCK_SIZE;
+        output += 4 * SM4_BLOCK_SIZE;
+        nblocks -= 4;
+    }
+    if (nblocks > 0) {
+        sm4_ni_encrypt_tail(input, output, nblocks, encSubKeys);
+    }
+}
@@ -1,8 +1,12 @@
 #include "sm4.h"
+#include "sm4_ni.h"
+#include "sm4_mode.h"
 #include "benchmark.h"
 
 #define BENCHS 10
 #define ROUNDS 100000
+#define BULK_BLOCKS 256 /* 4 KiB per call */
+#define BULK_ROUNDS 1000
 // #define BENCHS 2
 // #define ROUNDS 1
 
@@ -77,6 +81,131 @@ void test_sm4_correctness()
     }
 }
 
+// GB/T 32907 example 2: encrypt the plaintext 1,000,000 times with the same key
+void test_sm4_million_correctness()
+{
+    unsigned char key[SM4_KEY_SIZE] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe,
+    0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10};
+    // Corresponding ciphertext 0x595298c7c6fd271f0402f804c33d3f66
+    unsigned char correctResult[SM4_BLOCK_SIZE] = {0x59, 0x52, 0x98, 0xc7, 0xc6, 0xfd, 0x27, 0x1f,
+    0x04, 0x02, 0xf8, 0x04, 0xc3, 0x3d, 0x3f, 0x66};
+    unsigned char block[SM4_BLOCK_SIZE];
+    uint32_t encSubKeys[SM4_ROUNDS];
+    uint32_t decSubKeys[SM4_ROUNDS];
+
+    memcpy(block, key, SM4_BLOCK_SIZE);
+    sm4_make_enc_subkeys(key, encSubKeys);
+    sm4_make_dec_subkeys(key, decSubKeys);
+
+    for (int i = 0; i < 1000000; i++)
+    {
+        sm4_encrypt_block(block, encSubKeys, block);
+    }
+    int encrypted_ok = memcmp(block, correctResult, SM4_BLOCK_SIZE) == 0;
+
+    for (int i = 0; i < 1000000; i++)
+    {
+        sm4_decrypt_block(block, decSubKeys, block);
+    }
+
+    if (encrypted_ok && memcmp(block, key, SM4_BLOCK_SIZE) == 0)
+    {
+        printf(">> 1,000,000 iterations test passed.\n\n");
+    }
+    else
+    {
+        printf(">> 1,000,000 iterations test failed.\n\n");
+    }
+}
+
+// Multi-block entry point against the single-block one, covering every kernel width and tail
+void test_sm4_blocks_correctness()
+{
+    size_t counts[] = { 1, 3, 4, 5, 8, 9, 15, 16, 17, 31, 32, 33, 63, BULK_BLOCKS };
+    static unsigned char plaintext[BULK_BLOCKS * SM4_BLOCK_SIZE];
+    static unsigned char ciphertext[BULK_BLOCKS * SM4_BLOCK_SIZE];
+    static unsigned char expected[BULK_BLOCKS * SM4_BLOCK_SIZE];
+    unsigned char key[SM4_KEY_SIZE];
+    uint32_t encSubKeys[SM4_ROUNDS];
+    uint32_t decSubKeys[SM4_ROUNDS];
+    int failed = 0;
+
+    for (size_t i = 0; i < sizeof(plaintext); i++)
+    {
+        plaintext[i] = rand() & 0xFF;
+    }
+    for (int i = 0; i < SM4_KEY_SIZE; i++)
+    {
+        key[i] = rand() & 0xFF;
+    }
+    sm4_make_enc_subkeys(key, encSubKeys);
+    sm4_make_dec_subkeys(key, decSubKeys);
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        for (size_t i = 0; i < counts[c]; i++)
+        {
+            sm4_encrypt_block(plaintext + i * SM4_BLOCK_SIZE, encSubKeys, expected + i * SM4_BLOCK_SIZE);
+        }
+        sm4_encrypt_blocks(plaintext, ciphertext, counts[c], encSubKeys);
+        if (memcmp(ciphertext, expected, counts[c] * SM4_BLOCK_SIZE) != 0)
+        {
+            failed = 1;
+        }
+
+        // In place
+        sm4_decrypt_blocks(ciphertext, ciphertext, counts[c], decSubKeys);
+        if (memcmp(ciphertext, plaintext, counts[c] * SM4_BLOCK_SIZE) != 0)
+        {
+            failed = 1;
+        }
+    }
+
+    if (!failed)
+    {
+        printf(">> Multi-block correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Multi-block correctness test failed.\n\n");
+    }
+}
+
+// Every backend's key schedule against the reference one (S-box + L' per byte)
+void test_sm4_key_schedule_correctness()
+{
+    sm4_impl impl = sm4_get_impl();
+    unsigned char key[SM4_KEY_SIZE];
+    uint32_t encSubKeys[SM4_ROUNDS];
+    uint32_t expected[SM4_ROUNDS];
+    int failed = 0;
+
+    for (int n = 0; n < 100; n++)
+    {
+        for (int i = 0; i < SM4_KEY_SIZE; i++)
+        {
+            key[i] = rand() & 0xFF;
+        }
+        sm4_set_impl(SM4_IMPL_REFERENCE);
+        sm4_make_enc_subkeys(key, expected);
+        sm4_set_impl(impl);
+        sm4_make_enc_subkeys(key, encSubKeys);
+        if (memcmp(encSubKeys, expected, sizeof(expected)) != 0)
+        {
+            failed = 1;
+        }
+    }
+
+    if (!failed)
+    {
+        printf(">> Key schedule correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Key schedule correctness test failed.\n\n");
+    }
+}
+
 void encInit(unsigned char key[SM4_KEY_SIZE], uint32_t encSubKeys[SM4_ROUNDS])
 {
     srand((unsigned int)time(NULL));
@@ -140,42 +269,229 @@ void test_sm4_performance() {
     BPS_BENCH_FINAL(SM4_BLOCK_BITS);
 }
 
+// Throughput of independent blocks, where SIMD backends fill their registers
+void test_sm4_bulk_performance()
+{
+    static unsigned char plaintext[BULK_BLOCKS * SM4_BLOCK_SIZE];
+    static unsigned char ciphertext[BULK_BLOCKS * SM4_BLOCK_SIZE];
+    unsigned char key[SM4_KEY_SIZE];
+    uint32_t encSubKeys[SM4_ROUNDS];
 
-void sm4_encrypt_cbc(const unsigned char *plaintext, size_t length, const unsigned char *key, unsigned char *iv, unsigned char *ciphertext) {
+    for (size_t i = 0; i < sizeof(plaintext); i++)
+    {
+        plaintext[i] = rand() & 0xFF;
+    }
+    encInit(key, encSubKeys);
+
+    BPS_BENCH_START("SM4 multi-block encryption", BENCHS);
+    BPS_BENCH_ITEM(, sm4_encrypt_blocks(plaintext, ciphertext, BULK_BLOCKS, encSubKeys), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * SM4_BLOCK_BITS);
+}
+
+
+// OpenSSL 3 vectors (RFC 8998 key), 32-byte plaintext, 128-bit big-endian CTR counter
+void test_sm4_modes()
+{
+    unsigned char key[SM4_KEY_SIZE] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe,
+    0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10};
+    unsigned char iv[SM4_BLOCK_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+    0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+    unsigned char plaintext[32] = {0xaa, 0xaa, 0xaa, 0xaa, 0xbb, 0xbb, 0xbb, 0xbb, 0xcc, 0xcc, 0xcc, 0xcc,
+    0xdd, 0xdd, 0xdd, 0xdd, 0xee, 0xee, 0xee, 0xee, 0xff, 0xff, 0xff, 0xff, 0xaa, 0xaa, 0xaa, 0xaa,
+    0xbb, 0xbb, 0xbb, 0xbb};
+    unsigned char correctResult[][32] = {
+        // CBC
+        {0x78, 0xeb, 0xb1, 0x1c, 0xc4, 0x0b, 0x0a, 0x48, 0x31, 0x2a, 0xae, 0xb2, 0x04, 0x02, 0x44, 0xcb,
+         0x4c, 0xb7, 0x01, 0x69, 0x51, 0x90, 0x92, 0x26, 0x97, 0x9b, 0x0d, 0x15, 0xdc, 0x6a, 0x8f, 0x6d},
+        // CTR
+        {0xac, 0x32, 0x36, 0xcb, 0x86, 0x1d, 0xd3, 0x16, 0xe6, 0x41, 0x3b, 0x4e, 0x3c, 0x75, 0x24, 0xb7,
+         0x81, 0xe9, 0xe3, 0xa5, 0xbf, 0x5c, 0x03, 0xfe, 0x70, 0x3b, 0xb9, 0x4f, 0x3a, 0xbb, 0x16, 0xa1},
+        // CFB
+        {0xac, 0x32, 0x36, 0xcb, 0x86, 0x1d, 0xd3, 0x16, 0xe6, 0x41, 0x3b, 0x4e, 0x3c, 0x75, 0x24, 0xb7,
+         0x69, 0xd4, 0xc5, 0x4e, 0xd4, 0x33, 0xb9, 0xa0, 0x34, 0x60, 0x09, 0xbe, 0xb3, 0x7b, 0x2b, 0x3f},
+        // OFB
+        {0xac, 0x32, 0x36, 0xcb, 0x86, 0x1d, 0xd3, 0x16, 0xe6, 0x41, 0x3b, 0x4e, 0x3c, 0x75, 0x24, 0xb7,
+         0x1d, 0x01, 0xac, 0xa2, 0x48, 0x7c, 0xa5, 0x82, 0xcb, 0xf5, 0x46, 0x3e, 0x66, 0x98, 0x53, 0x9b},
+    };
+    sm4_mode modes[] = { SM4_MODE_CBC, SM4_MODE_CTR, SM4_MODE_CFB, SM4_MODE_OFB };
+    // Sizes of consecutive updates, block multiples so CBC can use them too
+    size_t splits[] = { 16, 48, 512, 2048, 1472 };
+    static unsigned char data[4096 + 7];
+    static unsigned char buffer[4096 + 7];
+    static unsigned char expected[4096];
+    unsigned char iv_before[SM4_BLOCK_SIZE];
     uint32_t encSubKeys[SM4_ROUNDS];
-    sm4_make_enc_subkeys(key, encSubKeys);
+    unsigned char ciphertext[32];
+    sm4_mode_ctx ctx;
+    int failed = 0;
 
-    unsigned char block[SM4_BLOCK_SIZE];
-    for (size_t i = 0; i < length; i += SM4_BLOCK_SIZE) {
-        // 当前块与 IV 或前一个密文块异或
-        for (size_t j = 0; j < SM4_BLOCK_SIZE; j++) {
-            block[j] = plaintext[i + j] ^ iv[j];
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = rand() & 0xFF;
+    }
+    memcpy(iv_before, iv, SM4_BLOCK_SIZE);
+
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+    {
+        // Known answer
+        sm4_mode_init(&ctx, modes[m], key, iv, 0);
+        sm4_mode_update(&ctx, plaintext, ciphertext, sizeof(plaintext));
+        sm4_mode_final(&ctx);
+        if (memcmp(ciphertext, correctResult[m], sizeof(ciphertext)) != 0)
+        {
+            failed = 1;
+        }
+
+        // Encrypt 4 KiB in one call, decrypt it in place over several calls
+        sm4_mode_init(&ctx, modes[m], key, iv, 0);
+        sm4_mode_update(&ctx, data, expected, sizeof(expected));
+        sm4_mode_final(&ctx);
+        memcpy(buffer, expected, sizeof(expected));
+        sm4_mode_init(&ctx, modes[m], key, iv, 1);
+        for (size_t i = 0, off = 0; i < sizeof(splits) / sizeof(splits[0]); off += splits[i], i++)
+        {
+            sm4_mode_update(&ctx, buffer + off, buffer + off, splits[i]);
+        }
+        sm4_mode_final(&ctx);
+        if (memcmp(buffer, data, sizeof(expected)) != 0)
+        {
+            failed = 1;
         }
-        // 加密当前块
-        sm4_encrypt_block(block, encSubKeys, ciphertext + i);
-        // 更新 IV 为当前密文块
-        memcpy(iv, ciphertext + i, SM4_BLOCK_SIZE);
+
+        // Stream modes: odd sizes that leave partial blocks between calls
+        if (modes[m] != SM4_MODE_CBC)
+        {
+            sm4_mode_init(&ctx, modes[m], key, iv, 0);
+            sm4_mode_update(&ctx, data, buffer, 1);
+            sm4_mode_update(&ctx, data + 1, buffer + 1, 17);
+            sm4_mode_update(&ctx, data + 18, buffer + 18, sizeof(data) - 18);
+            sm4_mode_final(&ctx);
+            if (memcmp(buffer, expected, sizeof(expected)) != 0)
+            {
+                failed = 1;
+            }
+            sm4_mode_init(&ctx, modes[m], key, iv, 1);
+            sm4_mode_update(&ctx, buffer, buffer, 7);
+            sm4_mode_update(&ctx, buffer + 7, buffer + 7, sizeof(data) - 7);
+            sm4_mode_final(&ctx);
+            if (memcmp(buffer, data, sizeof(data)) != 0)
+            {
+                failed = 1;
+            }
+
+            // Every partial-block length ahead of a large buffer, which must still decrypt in batches
+            for (size_t head = 1; head < SM4_BLOCK_SIZE; head++)
+            {
+                sm4_mode_init(&ctx, modes[m], key, iv, 0);
+                sm4_mode_update(&ctx, data, buffer, sizeof(data));
+                sm4_mode_init(&ctx, modes[m], key, iv, 1);
+                sm4_mode_update(&ctx, buffer, buffer, head);
+                sm4_mode_update(&ctx, buffer + head, buffer + head, sizeof(data) - head);
+                sm4_mode_final(&ctx);
+                if (memcmp(buffer, data, sizeof(data)) != 0)
+                {
+                    failed = 1;
+                }
+            }
+        }
+    }
+
+    // ECB against the single-block entry point
+    sm4_make_enc_subkeys(key, encSubKeys);
+    for (size_t i = 0; i < sizeof(expected); i += SM4_BLOCK_SIZE)
+    {
+        sm4_encrypt_block(data + i, encSubKeys, expected + i);
+    }
+    sm4_mode_init(&ctx, SM4_MODE_ECB, key, NULL, 0);
+    sm4_mode_update(&ctx, data, buffer, sizeof(expected));
+    if (memcmp(buffer, expected, sizeof(expected)) != 0 || sm4_mode_update(&ctx, data, buffer, 7) == 0)
+    {
+        failed = 1;
+    }
+    sm4_mode_init(&ctx, SM4_MODE_ECB, key, NULL, 1);
+    sm4_mode_update(&ctx, buffer, buffer, sizeof(expected));
+    sm4_mode_final(&ctx);
+    if (memcmp(buffer, data, sizeof(expected)) != 0)
+    {
+        failed = 1;
+    }
+
+    // One-shot CBC helpers leave the caller's IV alone
+    sm4_encrypt_cbc(plaintext, sizeof(plaintext), key, iv, ciphertext);
+    if (memcmp(ciphertext, correctResult[0], sizeof(ciphertext)) != 0)
+    {
+        failed = 1;
+    }
+    sm4_decrypt_cbc(ciphertext, sizeof(ciphertext), key, iv, ciphertext);
+    if (memcmp(ciphertext, plaintext, sizeof(plaintext)) != 0 || memcmp(iv, iv_before, SM4_BLOCK_SIZE) != 0)
+    {
+        failed = 1;
+    }
+
+    if (!failed)
+    {
+        printf(">> Mode (ECB/CBC/CTR/CFB/OFB) correctness test passed.\n\n");
+    }
+    else
+    {
+        printf(">> Mode (ECB/CBC/CTR/CFB/OFB) correctness test failed.\n\n");
     }
 }
 
-void sm4_decrypt_cbc(const unsigned char *ciphertext, size_t length, const unsigned char *key, unsigned char *iv, unsigned char *plaintext) {
-    uint32_t decSubKeys[SM4_ROUNDS];
-    sm4_make_dec_subkeys(key, decSubKeys);
+// Mode throughput on 4 KiB messages, the key schedule is done once per context
+void test_sm4_mode_performance()
+{
+    static unsigned char plaintext[BULK_BLOCKS * SM4_BLOCK_SIZE];
+    static unsigned char ciphertext[BULK_BLOCKS * SM4_BLOCK_SIZE];
+    unsigned char key[SM4_KEY_SIZE];
+    unsigned char iv[SM4_BLOCK_SIZE];
+    uint32_t encSubKeys[SM4_ROUNDS];
+    sm4_mode_ctx ctx;
 
-    unsigned char block[SM4_BLOCK_SIZE];
-    for (size_t i = 0; i < length; i += SM4_BLOCK_SIZE) {
-        // 备份当前密文块
-        memcpy(block, ciphertext + i, SM4_BLOCK_SIZE);
-        // 解密当前块
-        sm4_decrypt_block(ciphertext + i, decSubKeys, plaintext + i);
-        // 与 IV 或前一个密文块异或
-        for (size_t j = 0; j < SM4_BLOCK_SIZE; j++) {
-            plaintext[i + j] ^= iv[j];
-        }
-        // 更新 IV 为当前密文块
-        memcpy(iv, block, SM4_BLOCK_SIZE);
+    for (size_t i = 0; i < sizeof(plaintext); i++)
+    {
+        plaintext[i] = rand() & 0xFF;
+    }
+    for (int i = 0; i < SM4_BLOCK_SIZE; i++)
+    {
+        iv[i] = rand() & 0xFF;
     }
+    encInit(key, encSubKeys);
+
+    sm4_mode_init(&ctx, SM4_MODE_CBC, key, iv, 0);
+    BPS_BENCH_START("SM4 CBC encryption (4 KiB)", BENCHS);
+    BPS_BENCH_ITEM(, sm4_mode_update(&ctx, plaintext, ciphertext, sizeof(plaintext)), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * SM4_BLOCK_BITS);
+
+    sm4_mode_init(&ctx, SM4_MODE_CBC, key, iv, 1);
+    BPS_BENCH_START("SM4 CBC decryption (4 KiB)", BENCHS);
+    BPS_BENCH_ITEM(, sm4_mode_update(&ctx, ciphertext, plaintext, sizeof(plaintext)), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * SM4_BLOCK_BITS);
+
+    sm4_mode_init(&ctx, SM4_MODE_CTR, key, iv, 0);
+    BPS_BENCH_START("SM4 CTR (4 KiB)", BENCHS);
+    BPS_BENCH_ITEM(, sm4_mode_update(&ctx, plaintext, ciphertext, sizeof(plaintext)), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * SM4_BLOCK_BITS);
+
+    sm4_mode_init(&ctx, SM4_MODE_CFB, key, iv, 1);
+    BPS_BENCH_START("SM4 CFB decryption (4 KiB)", BENCHS);
+    BPS_BENCH_ITEM(, sm4_mode_update(&ctx, ciphertext, plaintext, sizeof(plaintext)), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * SM4_BLOCK_BITS);
+
+    // Each update starts mid-block, the rest of the call should still be batched
+    sm4_mode_init(&ctx, SM4_MODE_CFB, key, iv, 1);
+    BPS_BENCH_START("SM4 CFB decryption (7 bytes + 4089 bytes)", BENCHS);
+    BPS_BENCH_ITEM(, (sm4_mode_update(&ctx, ciphertext, plaintext, 7),
+                      sm4_mode_update(&ctx, ciphertext + 7, plaintext + 7, sizeof(plaintext) - 7)), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * SM4_BLOCK_BITS);
+
+    sm4_mode_init(&ctx, SM4_MODE_OFB, key, iv, 0);
+    BPS_BENCH_START("SM4 OFB (4 KiB)", BENCHS);
+    BPS_BENCH_ITEM(, sm4_mode_update(&ctx, plaintext, ciphertext, sizeof(plaintext)), BULK_ROUNDS);
+    BPS_BENCH_FINAL(BULK_BLOCKS * SM4_BLOCK_BITS);
+    sm4_mode_final(&ctx);
 }
+
 #define ROUNDS_10M 2
 #define ROUNDS_2K 10000
 void test_sm4_cbc_performance(size_t data_size) {
@@ -184,7 +500,6 @@ void test_sm4_cbc_performance(size_t data_size) {
     unsigned char *decrypted = malloc(data_size);
     unsigned char key[SM4_KEY_SIZE];
     unsigned char iv[SM4_BLOCK_SIZE];
-    unsigned char iv_copy[SM4_BLOCK_SIZE];
 
     // 初始化随机数据
     for (size_t i = 0; i < data_size; i++) {
@@ -201,25 +516,24 @@ void test_sm4_cbc_performance(size_t data_size) {
     if(data_size == 10*1024*1024) {
         BPS_BENCH_START("SM4 CBC Encryption", BENCHS);
         BPS_BENCH_ITEM(
-            memcpy(iv_copy, iv, SM4_BLOCK_SIZE), 
-            sm4_encrypt_cbc(plaintext, data_size, key, iv_copy, ciphertext), 
+            ,
+            sm4_encrypt_cbc(plaintext, data_size, key, iv, ciphertext), 
             ROUNDS_10M
         );
         BPS_BENCH_FINAL(data_size * 8);
     } else if(data_size == 2*1024) {
         BPS_BENCH_START("SM4 CBC Encryption", BENCHS);
         BPS_BENCH_ITEM(
-            memcpy(iv_copy, iv, SM4_BLOCK_SIZE), 
-            sm4_encrypt_cbc(plaintext, data_size, key, iv_copy, ciphertext), 
+            ,
+            sm4_encrypt_cbc(plaintext, data_size, key, iv, ciphertext), 
             ROUNDS_2K
         );
         BPS_BENCH_FINAL(data_size * 8);
     } else {
-        memcpy(iv_copy, iv, SM4_BLOCK_SIZE);
         BPS_BENCH_START("SM4 CBC Encryption", BENCHS);
         BPS_BENCH_ITEM(
-            memcpy(iv_copy, iv, SM4_BLOCK_SIZE), 
-            sm4_encrypt_cbc(plaintext, data_size, key, iv_copy, ciphertext), 
+            ,
+            sm4_encrypt_cbc(plaintext, data_size, key, iv, ciphertext), 
             ROUNDS
         );
         BPS_BENCH_FINAL(data_size * 8);
@@ -229,25 +543,24 @@ void test_sm4_cbc_performance(size_t data_size) {
     if(data_size == 10*1024*1024) {
         BPS_BENCH_START("SM4 CBC Decryption", BENCHS);
         BPS_BENCH_ITEM(
-            memcpy(iv_copy, iv, SM4_BLOCK_SIZE), 
-            sm4_decrypt_cbc(ciphertext, data_size, key, iv_copy, decrypted), 
+            ,
+            sm4_decrypt_cbc(ciphertext, data_size, key, iv, decrypted), 
             ROUNDS_10M
         );
         BPS_BENCH_FINAL(data_size * 8);
     } else if(data_size == 2*1024) {
-        BPS_BENCH_START("SM4 CBC Encryption", BENCHS);
+        BPS_BENCH_START("SM4 CBC Decryption", BENCHS);
         BPS_BENCH_ITEM(
-            memcpy(iv_copy, iv, SM4_BLOCK_SIZE), 
-            sm4_encrypt_cbc(plaintext, data_size, key, iv_copy, ciphertext), 
+            ,
+            sm4_decrypt_cbc(ciphertext, data_size, key, iv, decrypted), 
             ROUNDS_2K
         );
         BPS_BENCH_FINAL(data_size * 8);
     } else {
-        memcpy(iv_copy, iv, SM4_BLOCK_SIZE);
         BPS_BENCH_START("SM4 CBC Decryption", BENCHS);
         BPS_BENCH_ITEM(
-            memcpy(iv_copy, iv, SM4_BLOCK_SIZE), 
-            sm4_decrypt_cbc(ciphertext, data_size, key, iv_copy, decrypted), 
+            ,
+            sm4_decrypt_cbc(ciphertext, data_size, key, iv, decrypted), 
             ROUNDS
         );
         BPS_BENCH_FINAL(data_size * 8);
@@ -273,13 +586,41 @@ void test_sm4_cbc_performance(size_t data_size) {
 //     return 0;
 // }
 int main() {
-    // Correctness test
-    printf(">> Performing correctness test...\n");
-    test_sm4_correctness();
+    for (int impl = SM4_IMPL_AUTO + 1; impl < SM4_IMPL_COUNT; impl++)
+    {
+        if (sm4_set_impl(impl) != 0)
+        {
+            printf(">> %s not supported by this CPU, skipped.\n\n", sm4_impl_name(impl));
+            continue;
+        }
+        printf(">> Implementation: %s\n", sm4_impl_name(impl));
+        if (impl == SM4_IMPL_AESNI)
+        {
+            printf(">> Widest kernel: %s\n", sm4_ni_kernel_name());
+        }
 
-    // Perform performance test
-    printf(">> Performing performance test...\n");
-    test_sm4_performance();
+        // Correctness test
+        printf(">> Performing correctness test...\n");
+        test_sm4_correctness();
+        test_sm4_million_correctness();
+        test_sm4_key_schedule_correctness();
+        test_sm4_blocks_correctness();
+        test_sm4_modes();
+
+        // Perform performance test, the reference backend is the original S-box + L code
+        printf(">> Performing performance test...\n");
+        test_sm4_performance();
+        test_sm4_bulk_performance();
+    }
+
+    // Use the fastest implementation from here on; AUTO may mix backends per call, check it too
+    sm4_set_impl(SM4_IMPL_AUTO);
+    printf(">> Implementation: Auto (%s)\n", sm4_impl_name(sm4_get_impl()));
+    test_sm4_correctness();
+    test_sm4_blocks_correctness();
+    test_sm4_modes();
+    printf(">> Performing mode performance test (%s)...\n", sm4_impl_name(sm4_get_impl()));
+    test_sm4_mode_performance();
 
     // Performance test
     // printf(">> Performing CBC performance test...\n");
@@ -292,5 +633,3 @@ int main() {
 
     return 0;
 }
-
-
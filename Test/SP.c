@@ -1,167 +0,0 @@
-#include <stdio.h>
-
-// DES S-Box 定义
-static const unsigned int S[8][64] = {
-    // S1
-    {
-        14,  4, 13,  1,  2, 15, 11,  8,  3, 10,  6, 12,  5,  9,  0,  7,
-         0, 15,  7,  4, 14,  2, 13,  1, 10,  6, 12, 11,  9,  5,  3,  8,
-         4,  1, 14,  8, 13,  6,  2, 11, 15, 12,  9,  7,  3, 10,  5,  0,
-        15, 12,  8,  2,  4,  9,  1,  7,  5, 11,  3, 14, 10,  0,  6, 13
-    },
-    // S2
-    {
-        15,  1,  8, 14,  6, 11,  3,  4,  9,  7,  2, 13, 12,  0,  5, 10,
-         3, 13,  4,  7, 15,  2,  8, 14, 12,  0,  1, 10,  6,  9, 11,  5,
-         0, 14,  7, 11, 10,  4, 13,  1,  5,  8, 12,  6,  9,  3,  2, 15,
-        13,  8, 10,  1,  3, 15,  4,  2, 11,  6,  7, 12,  0,  5, 14,  9
-    },
-    // S3
-    {
-        10,  0,  9, 14,  6,  3, 15,  5,  1, 13, 12,  7, 11,  4,  2,  8,
-        13,  7,  0,  9,  3,  4,  6, 10,  2,  8,  5, 14, 12, 11, 15,  1,
-        13,  6,  4,  9,  8, 15,  3,  0, 11,  1,  2, 12,  5, 10, 14,  7,
-         1, 10, 13,  0,  6,  9,  8,  7,  4, 15, 14,  3, 11,  5,  2, 12
-    },
-    // S4
-    {
-         7, 13, 14,  3,  0,  6,  9, 10,  1,  2,  8,  5, 11, 12,  4, 15,
-        13,  8, 11,  5,  6, 15,  0,  3,  4,  7,  2, 12,  1, 10, 14,  9,
-        10,  6,  9,  0, 12, 11,  7, 13, 15,  1,  3, 14,  5,  2,  8,  4,
-         3, 15,  0,  6, 10,  1, 13,  8,  9,  4,  5, 11, 12,  7,  2, 14
-    },
-    // S5
-    {
-         2, 12,  4,  1,  7, 10, 11,  6,  8,  5,  3, 15, 13,  0, 14,  9,
-        14, 11,  2, 12,  4,  7, 13,  1,  5,  0, 15, 10,  3,  9,  8,  6,
-         4,  2,  1, 11, 10, 13,  7,  8, 15,  9, 12,  5,  6,  3,  0, 14,
-        11,  8, 12,  7,  1, 14,  2, 13,  6, 15,  0,  9, 10,  4,  5,  3
-    },
-    // S6
-    {
-        12,  1, 10, 15,  9,  2,  6,  8,  0, 13,  3,  4, 14,  7,  5, 11,
-        10, 15,  4,  2,  7, 12,  9,  5,  6,  1, 13, 14,  0, 11,  3,  8,
-         9, 14, 15,  5,  2,  8, 12,  3,  7,  0,  4, 10,  1, 13, 11,  6,
-         4,  3,  2, 12,  9,  5, 15, 10, 11, 14,  1,  7,  6,  0,  8, 13
-    },
-    // S7
-    {
-         4, 11,  2, 14, 15,  0,  8, 13,  3, 12,  9,  7,  5, 10,  6,  1,
-        13,  0, 11,  7,  4,  9,  1, 10, 14,  3,  5, 12,  2, 15,  8,  6,
-         1,  4, 11, 13, 12,  3,  7, 14, 10, 15,  6,  8,  0,  5,  9,  2,
-         6, 11, 13,  8,  1,  4, 10,  7,  9,  5,  0, 15, 14,  2,  3, 12
-    },
-    // S8
-    {
-        13,  2,  8,  4,  6, 15, 11,  1, 10,  9,  3, 14,  5,  0, 12,  7,
-         1, 15, 13,  8, 10,  3,  7,  4, 12,  5,  6, 11,  0, 14,  9,  2,
-         7, 11,  4,  1,  9, 12, 14,  2,  0,  6, 10, 13, 15,  3,  5,  8,
-         2,  1, 14,  7,  4, 10,  8, 13, 15, 12,  9,  0,  3,  5,  6, 11
-    }
-};
-
-// P-Box 的置换表
-static const int P[32] = {
-    16,  7, 20, 21,
-    29, 12, 28, 17,
-     1, 15, 23, 26,
-     5, 18, 31, 10,
-     2,  8, 24, 14,
-    32, 27,  3,  9,
-    19, 13, 30,  6,
-    22, 11,  4, 25
-}; // 按照 DES 标准定义的 P-Box 表
-
-// 扩展置换表
-static const int E[48] = {
-    32,  1,  2,  3,  4,  5,
-     4,  5,  6,  7,  8,  9,
-     8,  9, 10, 11, 12, 13,
-    12, 13, 14, 15, 16, 17,
-    16, 17, 18, 19, 20, 21,
-    20, 21, 22, 23, 24, 25,
-    24, 25, 26, 27, 28, 29,
-    28, 29, 30, 31, 32,  1
-};
-
-
-void generate_DES_E(unsigned long E[48]) {
-    for (int i = 0; i < 4; i++) {
-        for(int j = 0; j < 256; j++) {
-            E_extend[i * 12 + j] = (unsigned long)E[i * 12 + j];
-        }
-    }
-}
-// 生成 DES_SPtrans
-void generate_DES_SPtrans(unsigned long SPtrans[8][64]) {
-    int flag = 0;
-    for (int i = 0; i < 8; i++) {                   // 遍历所有 S-Box
-        for (int j = 0; j < 64; j++) {             // 遍历每个 S-Box 的 6 位输入 (0-63)
-            unsigned long value = S[i][j];         // 提取 S-Box 的 4 位输出
-            if (i == 0 && j == 0) {
-                printf("value is 0x%08lx\n, ", value);
-            }
-            unsigned long permuted = 0;            // 初始化置换后的结果
-
-            for (int k = 0; k < 4; k++) {          // 遍历 S-Box 的 4 位输出
-                int bit = (value >> (3 - k)) & 1;  // 提取 S-Box 的每一位
-                int p_pos = P[4 * i + k] - 1;      // 从 P-Box 中找到对应的目标位置 (1-based 转换为 0-based)
-                if (i == 0 && j == 0) {
-                    printf("pos is 0x%08lx\n, ",p_pos);
-                }
-                permuted |= bit << (31 - p_pos -1);   // 将这一位放到 permuted 中的正确位置
-                if (i == 0 && j == 0) {
-                    printf("permute is 0x%08lx\n, ", permuted);
-                }
-
-            }
-            SPtrans[i][j] = permuted;              // 保存到 SPtrans 表中
-        }
-    }
-}
-
-
-int main() {
-    unsigned long SPtrans[8][64] = {0};
-    generate_DES_SPtrans(SPtrans);
-
-    // 打开文件以写入
-    FILE *file = fopen("sp_tables.c", "w");
-    if (file == NULL) {
-        perror("无法打开文件");
-        return 1;
-    }
-
-    // 写入文件头
-    fprintf(file, "#include <stdint.h>\n\n");
-    fprintf(file, "static const uint32_t SPtrans[8][64] = {\n");
-
-    // 写入 SPtrans 表
-    for (int i = 0; i < 8; i++) {
-        fprintf(file, "    {\n");
-        for (int j = 0; j < 64; j++) {
-            fprintf(file, "        0x%08lx", SPtrans[i][j]);
-            if (j < 63) {
-                fprintf(file, ",");
-            }
-            if ((j + 1) % 8 == 0) {
-                fprintf(file, "\n");
-            }
-        }
-        fprintf(file, "    }");
-        if (i < 7) {
-            fprintf(file, ",");
-        }
-        fprintf(file, "\n");
-    }
-
-    // 写入文件尾
-    fprintf(file, "};\n");
-
-    // 关闭文件
-    fclose(file);
-
-    printf("SPtrans 表已保存到 sp_tables.c 文件中。\n");
-
-    return 0;
-}
\ No newline at end of file